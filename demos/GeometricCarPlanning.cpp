@@ -186,6 +186,8 @@ int main(int argc, char* argv[])
             ("trajectory", po::value<std::vector<double > >()->multitoken(),
                 "print trajectory from (0,0,0) to a user-specified x, y, and theta")
             ("distance", "print distance grid")
+            ("table", po::value<std::string>(),
+                "write a Reeds-Shepp distance table to the specified file (see ReedsSheppStateSpace::loadDistanceTable)")
         ;
 
         po::variables_map vm;
@@ -213,6 +215,9 @@ int main(int argc, char* argv[])
             printTrajectory(space, vm["trajectory"].as<std::vector<double> >());
         if (vm.count("distance") != 0u)
             printDistanceGrid(space);
+        if (vm.count("table") != 0u &&
+            !ob::ReedsSheppStateSpace::generateDistanceTable(vm["table"].as<std::string>()))
+            return 1;
     }
     catch(std::exception& e) {
         std::cerr << "error: " << e.what() << "\n";
@@ -0,0 +1,294 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2026, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+
+#ifndef OMPL_BASE_COMPACT_PLANNER_DATA_
+#define OMPL_BASE_COMPACT_PLANNER_DATA_
+
+#include "ompl/base/State.h"
+#include "ompl/base/Cost.h"
+#include "ompl/base/SpaceInformation.h"
+#include "ompl/util/ClassForward.h"
+#include <iostream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ompl
+{
+    namespace base
+    {
+        /// @cond IGNORE
+        OMPL_CLASS_FORWARD(PlannerData);
+        OMPL_CLASS_FORWARD(CompactPlannerData);
+        class OptimizationObjective;
+        /// @endcond
+
+        /** \class ompl::base::CompactPlannerDataPtr
+            \brief A shared pointer wrapper for ompl::base::CompactPlannerData */
+
+        /// \brief A compact alternative to PlannerData for very large graphs.
+        /// Vertices are indexes into parallel arrays (state pointers, tags
+        /// and start/goal flags) and the directed edges are kept in
+        /// compressed sparse row form with single precision weights, so a
+        /// vertex costs a few bytes plus its state and an edge costs eight
+        /// bytes. There are no per-vertex or per-edge objects, so custom
+        /// PlannerDataVertex and PlannerDataEdge types cannot be represented;
+        /// toPlannerData() and fromPlannerData() convert to and from the full
+        /// representation, e.g. for PlannerDataStorage.
+        ///
+        /// Vertices are never removed and their indexes are stable. Edges are
+        /// appended in any order and arranged into rows the first time a row
+        /// is needed; the edges leaving a vertex keep the order in which they
+        /// were added. As in PlannerData, states are assumed to be unique and
+        /// only a single directed edge is assumed to connect two vertices, but
+        /// neither is checked when adding.
+        ///
+        /// Arranging the rows and sorting the index used by vertexIndex()
+        /// happen lazily, inside const member functions, so concurrent calls
+        /// even to const member functions are not safe without external
+        /// synchronization.
+        /// \note The storage for states this class maintains belongs to the planner
+        /// instance that filled the data (by default; see CompactPlannerData::decoupleFromPlanner())
+        class CompactPlannerData
+        {
+        public:
+            /// \brief Representation of an invalid vertex index
+            static const unsigned int INVALID_INDEX;
+
+            // non-copyable
+            CompactPlannerData(const CompactPlannerData &) = delete;
+            CompactPlannerData &operator=(const CompactPlannerData &) = delete;
+
+            /// \brief Constructor.  Accepts a SpaceInformationPtr for the space planned in.
+            CompactPlannerData(SpaceInformationPtr si);
+            /// \brief Destructor.
+            ~CompactPlannerData();
+
+            /// \name Construction
+            /// \{
+
+            /// \brief Reserve memory for \e vertices vertices and \e edges edges
+            void reserve(unsigned int vertices, unsigned int edges);
+            /// \brief Add a vertex for \e state with an optional integer tag. The index of the new vertex is returned.
+            unsigned int addVertex(const State *state, int tag = 0);
+            /// \brief Add a vertex for \e state and mark it as a start vertex. The index of the new vertex is
+            /// returned.
+            unsigned int addStartVertex(const State *state, int tag = 0);
+            /// \brief Add a vertex for \e state and mark it as a goal vertex. The index of the new vertex is returned.
+            unsigned int addGoalVertex(const State *state, int tag = 0);
+            /// \brief Add a directed edge between the vertices with indexes \e v1 and \e v2. False is returned if
+            /// either index is out of range.
+            bool addEdge(unsigned int v1, unsigned int v2, Cost weight = Cost(1.0));
+            /// \brief Mark the vertex with the given index as a start vertex
+            void markStartVertex(unsigned int index);
+            /// \brief Mark the vertex with the given index as a goal vertex
+            void markGoalVertex(unsigned int index);
+            /// \brief Set the integer tag of the vertex with the given index
+            void setTag(unsigned int index, int tag);
+            /// \brief Clears the entire data structure
+            void clear();
+            /// \brief Replace the states of the vertices by copies owned by this
+            /// instance, so the data remains valid when the planner that created
+            /// it goes out of scope. Vertices added afterwards need another call.
+            void decoupleFromPlanner();
+
+            /// \}
+            /// \name Properties and lookup
+            /// \{
+
+            /// \brief Retrieve the number of vertices in this structure
+            unsigned int numVertices() const
+            {
+                return states_.size();
+            }
+            /// \brief Retrieve the number of edges in this structure
+            unsigned int numEdges() const
+            {
+                return targets_.size() + pendingTargets_.size();
+            }
+            /// \brief Returns the number of start vertices
+            unsigned int numStartVertices() const;
+            /// \brief Returns the number of goal vertices
+            unsigned int numGoalVertices() const;
+            /// \brief Retrieve the state of the vertex with the given index
+            const State *getState(unsigned int index) const
+            {
+                return states_[index];
+            }
+            /// \brief Retrieve the integer tag of the vertex with the given index
+            int getTag(unsigned int index) const
+            {
+                return tags_[index];
+            }
+            /// \brief Returns true if the given vertex index is marked as a start vertex
+            bool isStartVertex(unsigned int index) const
+            {
+                return (flags_[index] & START) != 0;
+            }
+            /// \brief Returns true if the given vertex index is marked as a goal vertex
+            bool isGoalVertex(unsigned int index) const
+            {
+                return (flags_[index] & GOAL) != 0;
+            }
+            /// \brief Returns the index of the ith start vertex. INVALID_INDEX is returned if \e i is out of range.
+            unsigned int getStartIndex(unsigned int i) const;
+            /// \brief Returns the index of the ith goal vertex. INVALID_INDEX is returned if \e i is out of range.
+            unsigned int getGoalIndex(unsigned int i) const;
+            /// \brief Return the index of the vertex for \e state. INVALID_INDEX is
+            /// returned if there is no such vertex. The first lookup after adding
+            /// vertices sorts an index of the states, O(n log n).
+            unsigned int vertexIndex(const State *state) const;
+
+            /// \brief Returns the number of outgoing edges of vertex \e v and
+            /// sets \e targets and \e weights to the beginning of the contiguous
+            /// arrays holding their target vertices and weights.
+            unsigned int getEdges(unsigned int v, const unsigned int *&targets, const float *&weights) const;
+            /// \brief Returns a list of the vertex indexes directly connected to
+            /// vertex with index \e v (outgoing edges).  The number of outgoing
+            /// edges from \e v is returned.
+            unsigned int getEdges(unsigned int v, std::vector<unsigned int> &edgeList) const;
+            /// \brief Check whether an edge between vertex index \e v1 and index \e v2 exists
+            bool edgeExists(unsigned int v1, unsigned int v2) const;
+            /// \brief Returns the weight of the edge between the given vertex
+            /// indices in \e weight. If there is no such edge, false is returned.
+            bool getEdgeWeight(unsigned int v1, unsigned int v2, Cost *weight) const;
+            /// \brief Sets the weight of the edge between the given vertex
+            /// indices. If there is no such edge, false is returned.
+            bool setEdgeWeight(unsigned int v1, unsigned int v2, Cost weight);
+            /// \brief Computes the weight for all edges given the
+            /// OptimizationObjective \e opt.
+            void computeEdgeWeights(const OptimizationObjective &opt);
+            /// \brief Computes all edge weights using state space
+            /// distance (i.e. getSpaceInformation()->distance())
+            void computeEdgeWeights();
+
+            /// \}
+            /// \name Conversion, output and extraction
+            /// \{
+
+            /// \brief Replace the content of this structure by the vertices,
+            /// edges and properties of \e pd. The states are shared with \e pd,
+            /// and the vertex indexes are those of \e pd.
+            void fromPlannerData(const PlannerData &pd);
+            /// \brief Add the vertices and edges of this structure to \e pd, and
+            /// copy the properties. The vertex indexes only match if \e pd is
+            /// empty; a state that \e pd already contains is not added again,
+            /// and its edges connect to the existing vertex. The states are
+            /// shared with \e pd.
+            void toPlannerData(PlannerData &pd) const;
+
+            /// \brief Writes a GraphML file of this structure to the given
+            /// stream, in the same format as PlannerData::printGraphML(). The
+            /// edges are listed by source vertex.
+            void printGraphML(std::ostream &out = std::cout) const;
+
+            /// \brief Extracts the minimum spanning tree of the data rooted at
+            /// the vertex with index \e v into \e mst, which is cleared first.
+            /// All vertices are kept, with the same indexes. O(|E| log |V|).
+            void extractMinimumSpanningTree(unsigned int v, const OptimizationObjective &opt,
+                                            CompactPlannerData &mst) const;
+
+            /// \}
+
+            /// \brief Return the instance of SpaceInformation used in this structure
+            const SpaceInformationPtr &getSpaceInformation() const
+            {
+                return si_;
+            }
+
+            /// \brief Return the number of bytes used by the vertex and edge arrays (excluding the states)
+            std::size_t getMemoryUsage() const;
+
+            /// \brief Any extra properties (key-value pairs) the planner can set.
+            std::map<std::string, std::string> properties;
+
+        private:
+            friend class CompactPlannerDataStorage;
+
+            enum Flags : unsigned char
+            {
+                START = 1,
+                GOAL = 2
+            };
+
+            /// \brief Arrange the pending edges into rows. This only modifies
+            /// the layout of the edges, so it is allowed on const instances.
+            void arrangeRows() const;
+
+            /// \brief Return the position of the edge from \e v1 to \e v2 in targets_, or INVALID_INDEX
+            unsigned int findEdge(unsigned int v1, unsigned int v2) const;
+
+            /// \brief The space information instance for this data.
+            SpaceInformationPtr si_;
+
+            /// \brief The state of each vertex
+            std::vector<const State *> states_;
+
+            /// \brief The integer tag of each vertex
+            std::vector<int> tags_;
+
+            /// \brief The start/goal flags of each vertex
+            std::vector<unsigned char> flags_;
+
+            /// \brief Row \e v of the arranged edges is targets_[offsets_[v] .. offsets_[v + 1])
+            mutable std::vector<unsigned int> offsets_;
+
+            /// \brief The target vertex of each arranged edge
+            mutable std::vector<unsigned int> targets_;
+
+            /// \brief The weight of each arranged edge
+            mutable std::vector<float> weights_;
+
+            /// \brief The source vertices of the edges added since the rows were last arranged
+            mutable std::vector<unsigned int> pendingSources_;
+
+            /// \brief The target vertices of the pending edges
+            mutable std::vector<unsigned int> pendingTargets_;
+
+            /// \brief The weights of the pending edges
+            mutable std::vector<float> pendingWeights_;
+
+            /// \brief The (state, vertex index) pairs sorted by state, for vertexIndex()
+            mutable std::vector<std::pair<const State *, unsigned int>> stateIndex_;
+
+            /// \brief The states of the first decoupledCount_ vertices were allocated by
+            /// decoupleFromPlanner() and are freed by this instance
+            unsigned int decoupledCount_{0u};
+        };
+    }
+}
+
+#endif
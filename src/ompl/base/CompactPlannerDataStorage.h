@@ -0,0 +1,118 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2026, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+
+#ifndef OMPL_BASE_COMPACT_PLANNER_DATA_STORAGE_
+#define OMPL_BASE_COMPACT_PLANNER_DATA_STORAGE_
+
+#include "ompl/base/CompactPlannerData.h"
+#include <iostream>
+
+namespace ompl
+{
+    namespace base
+    {
+        /// \brief Stores CompactPlannerData in a flat binary file that can be
+        /// extended in place.
+        ///
+        /// The file starts with a header holding the signature of the state
+        /// space (see StateSpace::computeSignature()), followed by segments.
+        /// Each segment holds a block of consecutive vertices (their serialized
+        /// states, tags and start/goal flags) and the edges that were added
+        /// with them. store() writes the whole structure as one segment, and
+        /// append() adds a segment with the vertices added since the file was
+        /// written, so a growing roadmap is saved without rewriting it.
+        ///
+        /// load() reads the file with a single read and checks the signature
+        /// before allocating any state. An incomplete last segment, e.g., one
+        /// that was being appended when the process stopped, is ignored; the
+        /// file needs to be truncated to its complete segments before more
+        /// segments are appended to it.
+        /// Numbers are stored in the byte order of the machine, so files are
+        /// meant to be read back on the machine that wrote them; use
+        /// PlannerDataStorage for portable archives.
+        class CompactPlannerDataStorage
+        {
+        public:
+            /// \brief Store \e data to the given filename, replacing its content.
+            /// Returns false if the file could not be written.
+            bool store(const CompactPlannerData &data, const char *filename);
+
+            /// \brief Store \e data to the given stream
+            bool store(const CompactPlannerData &data, std::ostream &out);
+
+            /// \brief Append to the given filename the vertices of \e data
+            /// starting at index \e fromVertex, and the edges of \e data with
+            /// at least one of these vertices as an endpoint. The file must hold
+            /// the first \e fromVertex vertices of \e data. Returns false if the
+            /// file could not be written.
+            bool append(const CompactPlannerData &data, unsigned int fromVertex, const char *filename);
+
+            /// \brief Write to the given stream the segment that append() would
+            /// add to a file
+            bool append(const CompactPlannerData &data, unsigned int fromVertex, std::ostream &out);
+
+            /// \brief Load the structure stored in the given filename into \e
+            /// data, which is cleared first and owns the loaded states
+            /// afterwards. Returns false if the file could not be read or was
+            /// stored for a different state space.
+            bool load(const char *filename, CompactPlannerData &data);
+
+            /// \brief Load the structure stored in the given stream into \e data
+            bool load(std::istream &in, CompactPlannerData &data);
+
+            /// \brief Load the structure stored in the given filename into \e
+            /// data, and set \e completeBytes to the number of bytes up to the
+            /// end of the last complete segment that was loaded. If this is less
+            /// than the size of the file, the file must be truncated to it
+            /// before appending.
+            bool load(const char *filename, CompactPlannerData &data, std::size_t &completeBytes);
+
+            /// \brief Load the structure stored in the given stream into \e data,
+            /// and set \e completeBytes as load(filename, data, completeBytes)
+            /// does
+            bool load(std::istream &in, CompactPlannerData &data, std::size_t &completeBytes);
+
+        protected:
+            /// \brief Write the header for the state space of \e data to \e out
+            void storeHeader(const CompactPlannerData &data, std::ostream &out) const;
+
+            /// \brief Write the segment holding the vertices of \e data starting
+            /// at index \e fromVertex and the edges touching them to \e out
+            void storeSegment(const CompactPlannerData &data, unsigned int fromVertex, std::ostream &out) const;
+        };
+    }
+}
+
+#endif
@@ -133,7 +133,22 @@ namespace ompl
             unsigned int getMotionStates(const State *s1, const State *s2, std::vector<State *> &states,
                                          unsigned int /*count*/, bool endpoints, bool /*alloc*/) const override
             {
-                bool success = stateSpace_->as<ConstrainedStateSpace>()->discreteGeodesic(s1, s2, true, &states);
+                auto &&css = stateSpace_->as<ConstrainedStateSpace>();
+
+                bool success;
+                if (css->getGeodesicCacheSize() > 0)
+                {
+                    // Copy the states of a geodesic that may have been computed when checking the motion.
+                    ConstrainedStateSpace::GeodesicPtr geodesic = css->getGeodesic(s1, s2);
+                    success = geodesic->reached;
+
+                    states.clear();
+                    states.reserve(geodesic->states.size() + 1);
+                    for (auto s : geodesic->states)
+                        states.push_back(cloneState(s));
+                }
+                else
+                    success = css->discreteGeodesic(s1, s2, true, &states);
 
                 if (endpoints)
                 {
@@ -45,6 +45,7 @@
 #include <Eigen/Core>
 #include <Eigen/Dense>
 #include <utility>
+#include <vector>
 
 namespace ompl
 {
@@ -135,9 +136,25 @@ namespace ompl
             virtual bool project(State *state) const;
 
             /** \brief Project a state \a x given the constraints. If a valid
-                projection cannot be found, this method will return false. */
+                projection cannot be found, this method will return false. The
+                default implementation uses Newton's method; its temporaries are
+                kept per thread and reused across calls, and are fixed-size for
+                small ambient and co-dimensions, so projection does not allocate
+                memory. */
             virtual bool project(Eigen::Ref<Eigen::VectorXd> x) const;
 
+            /** \brief Project each column of \a xs given the constraints.
+                Returns the number of columns for which a valid projection was
+                found. If \a projected is not null, it is filled with the result
+                for each column. */
+            std::size_t projectBatch(Eigen::Ref<Eigen::MatrixXd> xs, std::vector<bool> *projected = nullptr) const;
+
+            /** \brief Project each state in \a states given the constraints.
+                Returns the number of states for which a valid projection was
+                found. If \a projected is not null, it is filled with the result
+                for each state. */
+            std::size_t projectBatch(const std::vector<State *> &states, std::vector<bool> *projected = nullptr) const;
+
             /** \brief Returns the distance of \a state to the constraint
              * manifold. */
             virtual double distance(const State *state) const;
@@ -219,6 +236,10 @@ namespace ompl
             /** @} */
 
         protected:
+            /** \brief Newton's method for projection, using temporaries of
+             * dynamic size that are kept per thread. */
+            bool projectDynamic(Eigen::Ref<Eigen::VectorXd> x) const;
+
             /** \brief Ambient space dimension. */
             const unsigned int n_;
 
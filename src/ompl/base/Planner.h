@@ -40,6 +40,7 @@
 #include "ompl/base/SpaceInformation.h"
 #include "ompl/base/ProblemDefinition.h"
 #include "ompl/base/PlannerData.h"
+#include "ompl/base/CompactPlannerData.h"
 #include "ompl/base/PlannerStatus.h"
 #include "ompl/base/PlannerTerminationCondition.h"
 #include "ompl/base/GenericParam.h"
@@ -216,6 +217,10 @@ namespace ompl
 
             /** \brief Flag indicating whether the planner is able to report the computation of intermediate paths. */
             bool canReportIntermediateSolutions{false};
+
+            /** \brief Flag indicating whether the planner can continue from a roadmap passed to
+                Planner::setCompactPlannerData() */
+            bool canLoadCompactPlannerData{false};
         };
 
         /** \brief Base class for a planner */
@@ -315,6 +320,22 @@ namespace ompl
                 (without calling clear() in between).  */
             virtual void getPlannerData(PlannerData &data) const;
 
+            /** \brief Get information about the current run of the motion
+                planner in the compact representation meant for very large
+                graphs. \e data is cleared first. The default implementation
+                converts the output of getPlannerData(), so planners with
+                large roadmaps override it to fill \e data directly. */
+            virtual void getCompactPlannerData(CompactPlannerData &data) const;
+
+            /** \brief Replace the roadmap of a multi-query planner by the
+                graph in \e data, e.g., one that getCompactPlannerData()
+                returned in an earlier run and that was saved with
+                CompactPlannerDataStorage. The states are copied. Returns
+                false if the planner cannot continue from such data, which
+                is the default. Planners that override this should set
+                PlannerSpecs::canLoadCompactPlannerData. */
+            virtual bool setCompactPlannerData(const CompactPlannerData &data);
+
             /** \brief Get the name of the planner */
             const std::string &getName() const;
 
@@ -38,6 +38,7 @@
 #define OMPL_BASE_PLANNER_DATA_STORAGE_
 
 #include "ompl/base/PlannerData.h"
+#include "ompl/base/CompactPlannerData.h"
 #include "ompl/util/Console.h"
 #include <boost/archive/binary_oarchive.hpp>
 #include <boost/archive/binary_iarchive.hpp>
@@ -100,6 +101,22 @@ namespace ompl
             /// StateSpace inside of the argument PlannerData.
             virtual void load(std::istream &in, PlannerData &pd);
 
+            /// \brief Store the CompactPlannerData structure to the given filename, in the same
+            /// format as PlannerData.
+            void store(const CompactPlannerData &pd, const char *filename);
+
+            /// \brief Store the CompactPlannerData structure to the given stream, in the same
+            /// format as PlannerData.
+            void store(const CompactPlannerData &pd, std::ostream &out);
+
+            /// \brief Load a stored PlannerData structure into \e pd, which
+            /// owns copies of the loaded states afterwards.
+            void load(const char *filename, CompactPlannerData &pd);
+
+            /// \brief Load a stored PlannerData structure into \e pd, which
+            /// owns copies of the loaded states afterwards.
+            void load(std::istream &in, CompactPlannerData &pd);
+
         protected:
             /// \brief Information stored at the beginning of the PlannerData archive
             struct Header
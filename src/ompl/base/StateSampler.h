@@ -78,6 +78,25 @@ namespace ompl
             /** \brief Sample a state */
             virtual void sampleUniform(State *state) = 0;
 
+            /** \brief Sample \e n states uniformly into the already allocated \e states. By default this calls
+                sampleUniform() for each state. The samplers in OMPL override it to draw the random values for the
+                whole batch at once, but only when batch sampling is enabled (see setBatchSampling()). */
+            virtual void sampleUniformBatch(State **states, std::size_t n);
+
+            /** \brief Let sampleUniformBatch() draw the whole batch directly instead of calling sampleUniform() for
+                each state. This is off by default, since a class that derives from a sampler and overrides
+                sampleUniform() would be bypassed. The default samplers of the state spaces in OMPL turn it on. */
+            void setBatchSampling(bool batchSampling)
+            {
+                batchSampling_ = batchSampling;
+            }
+
+            /** \brief Check whether sampleUniformBatch() draws the whole batch directly */
+            bool getBatchSampling() const
+            {
+                return batchSampling_;
+            }
+
             /** \brief Sample a state near another, within a neighborhood controlled by a distance parameter.
 
             Typically, StateSampler-derived classes will return in `state` a
@@ -105,6 +124,9 @@ namespace ompl
 
             /** \brief An instance of a random number generator */
             RNG rng_;
+
+            /** \brief Flag indicating whether sampleUniformBatch() may draw the whole batch directly */
+            bool batchSampling_{false};
         };
 
         /** \brief Definition of a compound state sampler. This is useful to construct samplers for compound states. */
@@ -129,6 +151,12 @@ namespace ompl
 
             void sampleUniform(State *state) override;
 
+            /** \brief Call sampleUniformBatch once per subspace, on the
+                corresponding components of all the states, if batch
+                sampling is enabled. Otherwise call sampleUniform() for
+                each state. */
+            void sampleUniformBatch(State **states, std::size_t n) override;
+
             /** \brief Call sampleUniformNear for each of the subspace states
                 with distance scaled by the corresponding subspace weight. */
             void sampleUniformNear(State *state, const State *near, double distance) override;
@@ -40,6 +40,7 @@
 #include "ompl/base/State.h"
 #include "ompl/util/ClassForward.h"
 #include "ompl/base/GenericParam.h"
+#include <cstddef>
 #include <string>
 
 namespace ompl
@@ -90,6 +91,11 @@ namespace ompl
                 \note The memory for \e near must be disjoint from the memory for \e state */
             virtual bool sampleNear(State *state, const State *near, double distance) = 0;
 
+            /** \brief Sample up to \e n valid states into the already allocated \e states. Return the number of
+                valid states found; these are stored first, and the order of the pointers in \e states may be
+                changed. By default this calls sample() for each state. */
+            virtual std::size_t sampleBatch(State **states, std::size_t n);
+
             /** \brief Finding a valid sample usually requires
                 performing multiple attempts. This call allows setting
                 the number of such attempts. */
@@ -37,10 +37,14 @@
 #ifndef OMPL_BASE_GOALS_GOAL_LAZY_SAMPLES_
 #define OMPL_BASE_GOALS_GOAL_LAZY_SAMPLES_
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <functional>
 #include <limits>
 #include <mutex>
 #include <thread>
+#include <vector>
 #include "ompl/base/goals/GoalStates.h"
 
 namespace ompl
@@ -51,7 +55,8 @@ namespace ompl
 
         /** \brief Goal sampling function. Returns false when no further calls should be made to it.
             Fills its second argument (the state) with the sampled goal state. This function need not
-            be thread safe. */
+            be thread safe, unless GoalLazySamples::setThreadCount() is used to sample with more than
+            one thread. */
         using GoalSamplingFn = std::function<bool(const GoalLazySamples *, State *)>;
 
         /** \brief Definition of a goal region that can be sampled,
@@ -80,12 +85,12 @@ namespace ompl
                 lazy fashion. A function (\e samplerFunc) that
                 produces samples from that region needs to be passed
                 to this constructor. The sampling thread is
-                automatically started if \e autoStart is true. The
-                sampling function is not called in parallel by
-                OMPL. Hence, the function is not required to be thread
-                safe, unless the user issues additional calls in
-                parallel. The instance of GoalLazySamples remains
-                thread safe however.
+                automatically started if \e autoStart is true. Unless
+                setThreadCount() is called, the sampling function is
+                not called in parallel by OMPL. Hence, the function is
+                not required to be thread safe, unless the user issues
+                additional calls in parallel. The instance of
+                GoalLazySamples remains thread safe however.
 
                 The function \e samplerFunc returns a truth value. If
                 the return value is true, further calls to the
@@ -110,15 +115,35 @@ namespace ompl
 
             void addState(const State *st) override;
 
-            /** \brief Start the goal sampling thread */
+            /** \brief Start the goal sampling threads */
             void startSampling();
 
-            /** \brief Stop the goal sampling thread */
+            /** \brief Stop the goal sampling threads */
             void stopSampling();
 
-            /** \brief Return true if the sampling thread is active */
+            /** \brief Return true if the sampling threads are active */
             bool isSampling() const;
 
+            /** \brief Set the number of threads that call the sampling
+                function, e.g., to run several IK solvers at once. With
+                more than one thread, the sampling function is called
+                concurrently and needs to be thread safe. The states the
+                threads find are added in batches, so the threads rarely
+                wait for each other or for the planner. Takes effect the
+                next time sampling starts, so construct the goal with \e
+                autoStart set to false to sample with several threads
+                from the start. The default value is 1. */
+            void setThreadCount(unsigned int nthreads)
+            {
+                threadCount_ = std::max(1u, nthreads);
+            }
+
+            /** \brief Get the number of threads that call the sampling function */
+            unsigned int getThreadCount() const
+            {
+                return threadCount_;
+            }
+
             /** \brief Set the minimum distance that a new state returned by the sampling thread needs to be away from
                 previously added states, so that it is added to the list of goal states. */
             void setMinNewSampleDistance(double dist)
@@ -164,6 +189,14 @@ namespace ompl
             /** \brief The function that samples goals by calling \e samplerFunc_ in a separate thread */
             void goalSamplingThread();
 
+            /** \brief Add the states in pendingStates_ that are at least minDist_ away from the goal states and
+                from each other */
+            void addPendingStates();
+
+            /** \brief Call \e callback_ for \e states, once the callbacks for all the batches numbered before
+                \e batch are done. The batches are numbered under \e lock_, in the order the states are added. */
+            void issueCallbacks(unsigned long batch, const std::vector<const State *> &states);
+
             /** \brief Lock for updating the set of states */
             mutable std::mutex lock_;
 
@@ -173,11 +206,33 @@ namespace ompl
             /** \brief Flag used to notify the sampling thread to terminate sampling */
             bool terminateSamplingThread_;
 
-            /** \brief Additional thread for sampling goal states */
-            std::thread *samplingThread_;
+            /** \brief Additional threads for sampling goal states */
+            std::vector<std::thread> samplingThreads_;
+
+            /** \brief The number of threads to start for sampling goal states */
+            unsigned int threadCount_{1u};
+
+            /** \brief Valid states found by the sampling threads and not yet added to the goal states */
+            std::vector<State *> pendingStates_;
+
+            /** \brief Lock for pendingStates_ */
+            std::mutex pendingLock_;
+
+            /** \brief Lock that makes the calls to \e callback_ one at a time */
+            std::mutex callbackLock_;
+
+            /** \brief Notified when a batch of calls to \e callback_ is done */
+            std::condition_variable callbackDone_;
+
+            /** \brief The number of batches of added states that need calls to \e callback_ (protected by \e
+                lock_) */
+            unsigned long callbackBatches_{0};
+
+            /** \brief The number of batches whose calls to \e callback_ are done (protected by \e callbackLock_) */
+            unsigned long callbackBatchesDone_{0};
 
             /** \brief The number of times the sampling function was called and it returned true */
-            unsigned int samplingAttempts_;
+            std::atomic<unsigned int> samplingAttempts_;
 
             /** \brief Samples returned by the sampling thread are added to the list of states only if
                 they are at least minDist_ away from already added samples. */
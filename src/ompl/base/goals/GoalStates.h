@@ -39,6 +39,9 @@
 
 #include "ompl/base/goals/GoalSampleableRegion.h"
 #include "ompl/base/ScopedState.h"
+#include "ompl/datastructures/NearestNeighbors.h"
+#include <memory>
+#include <mutex>
 #include <vector>
 
 namespace ompl
@@ -50,10 +53,7 @@ namespace ompl
         {
         public:
             /** \brief Create a goal representation that is in fact a set of states  */
-            GoalStates(const SpaceInformationPtr &si) : GoalSampleableRegion(si), samplePosition_(0)
-            {
-                type_ = GOAL_STATES;
-            }
+            GoalStates(const SpaceInformationPtr &si);
 
             ~GoalStates() override;
 
@@ -87,6 +87,14 @@ namespace ompl
             /** \brief The goal states. Only ones that are valid are considered by the motion planner. */
             std::vector<State *> states_;
 
+            /** \brief The goal states, for finding the one nearest to a state. States are added to it along with
+                states_, so distanceGoal() does not need to look at every goal state. */
+            std::shared_ptr<NearestNeighbors<State *>> nn_;
+
+            /** \brief Lock for nn_. Queries of the nearest neighbors structures may modify internal state, and
+                distanceGoal() is called concurrently by parallel planners. */
+            mutable std::mutex nnLock_;
+
         private:
             /** \brief The index of the next sample to be returned  */
             mutable unsigned int samplePosition_;
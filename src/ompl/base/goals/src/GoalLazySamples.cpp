@@ -45,7 +45,6 @@ ompl::base::GoalLazySamples::GoalLazySamples(const SpaceInformationPtr &si, Goal
   : GoalStates(si)
   , samplerFunc_(std::move(samplerFunc))
   , terminateSamplingThread_(false)
-  , samplingThread_(nullptr)
   , samplingAttempts_(0)
   , minDist_(minDist)
 {
@@ -62,11 +61,12 @@ ompl::base::GoalLazySamples::~GoalLazySamples()
 void ompl::base::GoalLazySamples::startSampling()
 {
     std::lock_guard<std::mutex> slock(lock_);
-    if (samplingThread_ == nullptr)
+    if (samplingThreads_.empty())
     {
-        OMPL_DEBUG("Starting goal sampling thread");
+        OMPL_DEBUG("Starting %u goal sampling thread(s)", threadCount_);
         terminateSamplingThread_ = false;
-        samplingThread_ = new std::thread(&GoalLazySamples::goalSamplingThread, this);
+        for (unsigned int i = 0; i < threadCount_; ++i)
+            samplingThreads_.emplace_back(&GoalLazySamples::goalSamplingThread, this);
     }
 }
 
@@ -82,13 +82,10 @@ void ompl::base::GoalLazySamples::stopSampling()
         }
     }
 
-    /* Join thread */
-    if (samplingThread_ != nullptr)
-    {
-        samplingThread_->join();
-        delete samplingThread_;
-        samplingThread_ = nullptr;
-    }
+    /* Join threads */
+    for (auto &thread : samplingThreads_)
+        thread.join();
+    samplingThreads_.clear();
 }
 
 void ompl::base::GoalLazySamples::goalSamplingThread()
@@ -106,7 +103,7 @@ void ompl::base::GoalLazySamples::goalSamplingThread()
         while (!terminateSamplingThread_ && !si_->isSetup())
             std::this_thread::sleep_for(time::seconds(0.01));
     }
-    unsigned int prevsa = samplingAttempts_;
+    unsigned int attempts = 0;
     if (isSampling() && samplerFunc_)
     {
         OMPL_DEBUG("Beginning sampling thread computation");
@@ -114,10 +111,15 @@ void ompl::base::GoalLazySamples::goalSamplingThread()
         while (isSampling() && samplerFunc_(this, s.get()))
         {
             ++samplingAttempts_;
+            ++attempts;
             if (si_->satisfiesBounds(s.get()) && si_->isValid(s.get()))
             {
                 OMPL_DEBUG("Adding goal state");
-                addStateIfDifferent(s.get(), minDist_);
+                {
+                    std::lock_guard<std::mutex> plock(pendingLock_);
+                    pendingStates_.push_back(si_->cloneState(s.get()));
+                }
+                addPendingStates();
             }
             else
             {
@@ -134,13 +136,57 @@ void ompl::base::GoalLazySamples::goalSamplingThread()
         terminateSamplingThread_ = true;
     }
 
-    OMPL_DEBUG("Stopped goal sampling thread after %u sampling attempts", samplingAttempts_ - prevsa);
+    OMPL_DEBUG("Stopped goal sampling thread after %u sampling attempts", attempts);
+}
+
+void ompl::base::GoalLazySamples::addPendingStates()
+{
+    std::vector<State *> pending;
+    std::vector<const State *> added;
+    unsigned long batch = 0;
+    {
+        // While this thread waits for the lock, other sampling threads may add more pending states; they are all
+        // taken at once
+        std::lock_guard<std::mutex> slock(lock_);
+        {
+            std::lock_guard<std::mutex> plock(pendingLock_);
+            pending.swap(pendingStates_);
+        }
+        for (State *st : pending)
+        {
+            // the states added earlier in the batch are in the index too
+            if (GoalStates::distanceGoal(st) > minDist_)
+            {
+                GoalStates::addState(st);
+                if (callback_)
+                    added.push_back(states_.back());
+            }
+            si_->freeState(st);
+        }
+        if (!added.empty())
+            batch = callbackBatches_++;
+    }
+
+    // the lock is released at this; if needed, issue calls to the callback
+    if (!added.empty())
+        issueCallbacks(batch, added);
+}
+
+void ompl::base::GoalLazySamples::issueCallbacks(unsigned long batch, const std::vector<const State *> &states)
+{
+    // the states reach the callback in the order they were added, even if another thread gets here first
+    std::unique_lock<std::mutex> clock(callbackLock_);
+    callbackDone_.wait(clock, [this, batch] { return callbackBatchesDone_ == batch; });
+    for (const State *st : states)
+        callback_(st);
+    ++callbackBatchesDone_;
+    callbackDone_.notify_all();
 }
 
 bool ompl::base::GoalLazySamples::isSampling() const
 {
     std::lock_guard<std::mutex> slock(lock_);
-    return !terminateSamplingThread_ && samplingThread_ != nullptr;
+    return !terminateSamplingThread_ && !samplingThreads_.empty();
 }
 
 bool ompl::base::GoalLazySamples::couldSample() const
@@ -205,6 +251,7 @@ bool ompl::base::GoalLazySamples::addStateIfDifferent(const State *st, double mi
 {
     const base::State *newState = nullptr;
     bool added = false;
+    unsigned long batch = 0;
     {
         std::lock_guard<std::mutex> slock(lock_);
         if (GoalStates::distanceGoal(st) > minDistance)
@@ -212,12 +259,15 @@ bool ompl::base::GoalLazySamples::addStateIfDifferent(const State *st, double mi
             GoalStates::addState(st);
             added = true;
             if (callback_)
+            {
                 newState = states_.back();
+                batch = callbackBatches_++;
+            }
         }
     }
 
     // the lock is released at this; if needed, issue a call to the callback
     if (newState != nullptr)
-        callback_(newState);
+        issueCallbacks(batch, {newState});
     return added;
 }
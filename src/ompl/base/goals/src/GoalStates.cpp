@@ -37,8 +37,26 @@
 #include "ompl/base/goals/GoalStates.h"
 #include "ompl/base/SpaceInformation.h"
 #include "ompl/util/Exception.h"
+#include "ompl/datastructures/NearestNeighborsGNAT.h"
+#include "ompl/datastructures/NearestNeighborsLinear.h"
+#include "ompl/tools/config/MagicConstants.h"
 #include <limits>
 
+ompl::base::GoalStates::GoalStates(const SpaceInformationPtr &si) : GoalSampleableRegion(si), samplePosition_(0)
+{
+    type_ = GOAL_STATES;
+
+    // GNAT relies on the triangle inequality
+    if (si_->getStateSpace()->isMetricSpace())
+        nn_ = std::make_shared<NearestNeighborsGNAT<State *>>();
+    else
+        nn_ = std::make_shared<NearestNeighborsLinear<State *>>();
+    nn_->setDistanceFunction([this](const State *a, const State *b)
+                             {
+                                 return si_->distance(a, b);
+                             });
+}
+
 ompl::base::GoalStates::~GoalStates()
 {
     freeMemory();
@@ -48,6 +66,8 @@ void ompl::base::GoalStates::clear()
 {
     freeMemory();
     states_.clear();
+    std::lock_guard<std::mutex> slock(nnLock_);
+    nn_->clear();
 }
 
 void ompl::base::GoalStates::freeMemory()
@@ -58,14 +78,25 @@ void ompl::base::GoalStates::freeMemory()
 
 double ompl::base::GoalStates::distanceGoal(const State *st) const
 {
-    double dist = std::numeric_limits<double>::infinity();
-    for (auto state : states_)
+    // For a few goal states, scanning all of them is faster than querying the index
+    if (states_.size() < magic::GOAL_STATES_LINEAR_SCAN_LIMIT)
+    {
+        double dist = std::numeric_limits<double>::infinity();
+        for (auto state : states_)
+        {
+            double d = si_->distance(st, state);
+            if (d < dist)
+                dist = d;
+        }
+        return dist;
+    }
+    State *nearest;
     {
-        double d = si_->distance(st, state);
-        if (d < dist)
-            dist = d;
+        // GNAT queries update its internal bookkeeping, so they must not run concurrently
+        std::lock_guard<std::mutex> slock(nnLock_);
+        nearest = nn_->nearest(const_cast<State *>(st));
     }
-    return dist;
+    return si_->distance(st, nearest);
 }
 
 void ompl::base::GoalStates::print(std::ostream &out) const
@@ -99,6 +130,8 @@ unsigned int ompl::base::GoalStates::maxSampleCount() const
 void ompl::base::GoalStates::addState(const State *st)
 {
     states_.push_back(si_->cloneState(st));
+    std::lock_guard<std::mutex> slock(nnLock_);
+    nn_->add(states_.back());
 }
 
 void ompl::base::GoalStates::addState(const ScopedState<> &st)
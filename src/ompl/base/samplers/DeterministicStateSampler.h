@@ -51,7 +51,8 @@ namespace ompl
        @anchor DeterministicStateSampler
        @par Short description
        \ref DeterministicStateSampler Implementation of a deterministic state sampler. The
-       implementation allows to load and draw samples from a precomputed sequence or from the Halton Sequence,
+       implementation allows to load and draw samples from a precomputed sequence, from the (optionally scrambled)
+       Halton sequence or from the Sobol sequence,
        @par External documentation
        Dispertio: Optimal Sampling For Safe Deterministic Motion Planning
        L Palmieri, L Bruns, M Meurer, KO Arras - IEEE Robotics and Automation Letters, 2019
@@ -66,7 +67,9 @@ namespace ompl
         public:
             enum DeterministicSamplerType
             {
-                HALTON
+                HALTON,
+                SCRAMBLED_HALTON,
+                SOBOL
             };
 
             /** \brief Constructor, which creates the sequence internally based on the specified sequence type.
@@ -86,6 +89,9 @@ namespace ompl
                 return;
             }
 
+            /** \brief Draw the next \e n samples of the sequence at once */
+            void sampleUniformBatch(State **states, std::size_t n) override;
+
             virtual void sampleUniformNear(State *, const State *, double)
             {
                 OMPL_ERROR("sampleUniformNear is not supported for DeterministicStateSampler");
@@ -118,8 +124,13 @@ namespace ompl
             }
 
             void sampleUniform(State *state) override;
+            void sampleUniformBatch(State **states, std::size_t n) override;
             void sampleUniformNear(State *state, const State *near, double distance) override;
             void sampleGaussian(State *state, const State *mean, double stdDev) override;
+
+        private:
+            /** \brief Set \e state from one sample of the sequence */
+            void setState(State *state, const double *sample) const;
         };
 
         /** \brief Deterministic state sampler for the R<sup>n</sup> state space */
@@ -143,10 +154,14 @@ namespace ompl
             }
 
             void sampleUniform(State *state) override;
+            void sampleUniformBatch(State **states, std::size_t n) override;
             void sampleUniformNear(State *state, const State *near, double distance) override;
             void sampleGaussian(State *state, const State *mean, double stdDev) override;
 
         private:
+            /** \brief Set \e state from one sample of the sequence */
+            void setState(State *state, const double *sample) const;
+
             bool stretch_{false};  // indicates whether the state is samples in [0,1] and should be stretched to the
                                    // state space boundaries
         };
@@ -171,15 +186,50 @@ namespace ompl
             }
 
             void sampleUniform(State *state) override;
+            void sampleUniformBatch(State **states, std::size_t n) override;
             void sampleUniformNear(State *state, const State *near, double distance) override;
             void sampleGaussian(State *state, const State *mean, double stdDev) override;
 
         private:
+            /** \brief Set \e state from one sample of the sequence */
+            void setState(State *state, const double *sample) const;
+
             bool stretch_rv_;   // indicates whether the xy state is sampled in [0,1] and should be stretched to the
                                 // state space boundaries
             bool stretch_so2_;  // indicates whether the so2 state is sampled in [0,1] and should be stretched to
                                 // [-pi;pi]
         };
+
+        /** \brief Deterministic state sampler for the SE(3) state space. The
+            position is stretched to the bounds of the space and the rotation
+            is computed from the last three values of each sample as in
+            SO3StateSampler::sampleUniform(). */
+        class SE3DeterministicStateSampler : public DeterministicStateSampler
+        {
+        public:
+            /** \brief Constructor, which creates the sequence internally based on the specified sequence type.
+            Uses the default constructor for the sequence.*/
+            SE3DeterministicStateSampler(const StateSpace *space,
+                                         DeterministicSamplerType type = DeterministicSamplerType::HALTON)
+              : DeterministicStateSampler(space, type)
+            {
+            }
+            /** \brief Constructor that takes a pointer to a DeterministicSequence and uses that object instead
+            of its own. This can be used to apply non default options to the deterministic sequence.*/
+            SE3DeterministicStateSampler(const StateSpace *space, std::shared_ptr<DeterministicSequence> sequence_ptr)
+              : DeterministicStateSampler(space, sequence_ptr)
+            {
+            }
+
+            void sampleUniform(State *state) override;
+            void sampleUniformBatch(State **states, std::size_t n) override;
+            void sampleUniformNear(State *state, const State *near, double distance) override;
+            void sampleGaussian(State *state, const State *mean, double stdDev) override;
+
+        private:
+            /** \brief Set \e state from one sample of the sequence */
+            void setState(State *state, const double *sample) const;
+        };
     }  // namespace base
 }  // namespace ompl
 
@@ -82,6 +82,14 @@ namespace ompl
              * number of iterations. */
             virtual bool sampleUniform(State *statePtr, const Cost &minCost, const Cost &maxCost) = 0;
 
+            /** \brief Sample up to \e n states uniformly in the subset of the state space whose heuristic solution
+             * estimates are less than the provided cost, i.e. in the interval [0, maxCost). The samples are stored in
+             * the first elements of \e states, which must hold at least \e n allocated states. Returns the number of
+             * samples found, which is less than \e n if the iteration limit was reached. By default calls
+             * sampleUniform(State *, const Cost &) \e n times; samplers may override this with a faster method. */
+            virtual unsigned int sampleUniformBatch(const std::vector<State *> &states, unsigned int n,
+                                                    const Cost &maxCost);
+
             /** \brief Whether the sampler can provide a measure of the informed subset */
             virtual bool hasInformedMeasure() const = 0;
 
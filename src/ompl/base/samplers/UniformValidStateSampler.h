@@ -56,6 +56,10 @@ namespace ompl
             bool sample(State *state) override;
             bool sampleNear(State *state, const State *near, double distance) override;
 
+            /** \brief Sample the states that are still missing as one batch of the underlying state sampler, for
+                at most getNrAttempts() rounds */
+            std::size_t sampleBatch(State **states, std::size_t n) override;
+
         protected:
             /** \brief The sampler to build upon */
             StateSamplerPtr sampler_;
@@ -37,6 +37,8 @@
 #ifndef OMPL_BASE_DETERMINISTIC_SEQUENCE
 #define OMPL_BASE_DETERMINISTIC_SEQUENCE
 
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 namespace ompl
@@ -56,6 +58,30 @@ namespace ompl
             /** \brief Returns the next sample in the interval [0,1] */
             virtual std::vector<double> sample() = 0;
 
+            /** \brief Write the next \e count samples to \e values, one
+                sample of dimensions_ values after the other. The default
+                implementation calls sample() \e count times. */
+            virtual void sampleBatch(double values[], std::size_t count)
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    std::vector<double> s = sample();
+                    for (unsigned int j = 0; j < dimensions_; ++j)
+                        values[i * dimensions_ + j] = s[j];
+                }
+            }
+
+            /** \brief Skip the next \e count samples. Several threads can
+                share a sequence without overlap by giving each thread its
+                own copy of the sequence, skipped to the start of a
+                different block of samples. The default implementation
+                calls sample() \e count times. */
+            virtual void skip(std::uint64_t count)
+            {
+                for (std::uint64_t i = 0; i < count; ++i)
+                    sample();
+            }
+
             const unsigned int dimensions_;
         };
     }  // namespace base
@@ -38,6 +38,8 @@
 #define OMPL_BASE_HALTON_SEQUENCE
 
 #include "ompl/base/samplers/deterministic/DeterministicSequence.h"
+#include "ompl/util/RandomNumbers.h"
+#include <cstdint>
 
 namespace ompl
 {
@@ -72,8 +74,23 @@ namespace ompl
             /** \brief Returns the next sample in the interval [0,1] */
             double sample();
 
+            /** \brief Skip the next \e count samples */
+            void skip(std::uint64_t count);
+
+            /** \brief Scramble the sequence by applying a random permutation,
+                drawn from \e rng, to each of the digits of the samples
+                (random digit permutation, a simplified form of Owen
+                scrambling). Call after setBase(). */
+            void scramble(RNG &rng);
+
         private:
-            unsigned int i_, base_;
+            /** \brief The index of the next sample. 64 bits wide, so skip() does not wrap around. */
+            std::uint64_t i_;
+
+            unsigned int base_;
+
+            /** \brief The permutation of each digit, if the sequence is scrambled */
+            std::vector<std::vector<unsigned int>> permutations_;
         };
 
         /** \brief Realization of the Halton sequence for the generation of
@@ -91,6 +108,17 @@ namespace ompl
             /** \brief Returns the next sample in the interval [0,1] */
             std::vector<double> sample() override;
 
+            void sampleBatch(double values[], std::size_t count) override;
+
+            void skip(std::uint64_t count) override;
+
+            /** \brief Scramble the digits of the samples of each dimension with
+                random permutations drawn from a generator seeded with \e seed.
+                Scrambling breaks the correlation between dimensions with large
+                prime bases, which makes the plain Halton sequence poorly
+                spread in more than a few dimensions. */
+            void scramble(std::uint_fast32_t seed);
+
         private:
             std::vector<HaltonSequence1D> halton_sequences_1d_;
 
@@ -0,0 +1,96 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Rice University
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the Rice University nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#ifndef OMPL_BASE_SOBOL_SEQUENCE
+#define OMPL_BASE_SOBOL_SEQUENCE
+
+#include "ompl/base/samplers/deterministic/DeterministicSequence.h"
+
+namespace ompl
+{
+    namespace base
+    {
+        /**
+        @anchor SobolSequence
+        @par Short description
+        \ref SobolSequence Realization of the Sobol sequence, a low-discrepancy
+        sequence in base 2 whose first 2<sup>m</sup> samples are evenly
+        stratified in every dimension. Consecutive samples are generated with
+        the Gray code ordering, which costs one exclusive or per dimension and
+        sample, and any sample can be reached directly with skip().
+        @par External documentation
+        S. Joe and F. Y. Kuo, Constructing Sobol sequences with better
+        two-dimensional projections, SIAM Journal on Scientific Computing
+        30.5 (2008): 2635-2654. The direction numbers are the ones from this
+        paper (new-joe-kuo-6.21201).
+        \brief Realization of the Sobol sequence for the generation of
+        arbitrary dimensional, low-discrepancy sequences.
+        */
+        class SobolSequence : public DeterministicSequence
+        {
+        public:
+            /** \brief Constructor. Throws an Exception if \e dimensions is
+                larger than maxDimensions(). */
+            SobolSequence(unsigned int dimensions);
+
+            /** \brief Returns the next sample in the interval [0,1) */
+            std::vector<double> sample() override;
+
+            void sampleBatch(double values[], std::size_t count) override;
+
+            void skip(std::uint64_t count) override;
+
+            /** \brief The largest number of dimensions for which direction numbers are available */
+            static unsigned int maxDimensions();
+
+        private:
+            /** \brief The number of bits of each coordinate; the sequence repeats after 2^BITS samples */
+            static const unsigned int BITS = 32;
+
+            /** \brief Move to the next sample */
+            void advance();
+
+            /** \brief The direction numbers, BITS per dimension */
+            std::vector<std::uint32_t> directions_;
+
+            /** \brief The coordinates of the next sample, as fractions of 2^BITS */
+            std::vector<std::uint32_t> x_;
+
+            /** \brief The index of the next sample */
+            std::uint64_t index_{0};
+        };
+    }  // namespace base
+}  // namespace ompl
+
+#endif
@@ -38,6 +38,7 @@
 #include "ompl/util/Console.h"
 #include <iostream>
 #include <cmath>
+#include <limits>
 #include <map>
 #include <boost/math/special_functions/prime.hpp>
 
@@ -61,19 +62,51 @@ namespace ompl
         double HaltonSequence1D::sample()
         {
             double f = 1, r = 0;
-            unsigned int i = i_;
+            std::uint64_t i = i_;
 
-            while (i > 0)
+            if (permutations_.empty())
             {
-                f /= base_;
-                r += f * (i % base_);
-                i = std::floor(i / base_);
+                while (i > 0)
+                {
+                    f /= base_;
+                    r += f * (i % base_);
+                    i /= base_;
+                }
+            }
+            else
+            {
+                // The zero digits past the last digit of i are permuted too
+                for (const auto &permutation : permutations_)
+                {
+                    f /= base_;
+                    r += f * permutation[i % base_];
+                    i /= base_;
+                }
             }
 
             ++i_;
             return r;
         }
 
+        void HaltonSequence1D::skip(std::uint64_t count)
+        {
+            i_ += count;
+        }
+
+        void HaltonSequence1D::scramble(RNG &rng)
+        {
+            // Permute as many digits as a double can resolve
+            const auto digits = (unsigned int)std::ceil(std::numeric_limits<double>::digits * std::log(2.0) /
+                                                        std::log((double)base_));
+            permutations_.assign(digits, std::vector<unsigned int>(base_));
+            for (auto &permutation : permutations_)
+            {
+                for (unsigned int d = 0; d < base_; ++d)
+                    permutation[d] = d;
+                rng.shuffle(permutation.begin(), permutation.end());
+            }
+        }
+
         HaltonSequence::HaltonSequence(unsigned int dimensions)
           : DeterministicSequence(dimensions), halton_sequences_1d_(dimensions)
         {
@@ -108,6 +141,26 @@ namespace ompl
             return samples;
         }
 
+        void HaltonSequence::sampleBatch(double values[], std::size_t count)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                for (unsigned int j = 0; j < dimensions_; ++j)
+                    values[i * dimensions_ + j] = halton_sequences_1d_[j].sample();
+        }
+
+        void HaltonSequence::skip(std::uint64_t count)
+        {
+            for (auto &seq : halton_sequences_1d_)
+                seq.skip(count);
+        }
+
+        void HaltonSequence::scramble(std::uint_fast32_t seed)
+        {
+            RNG rng(seed);
+            for (auto &seq : halton_sequences_1d_)
+                seq.scramble(rng);
+        }
+
         void HaltonSequence::setBasesToPrimes()
         {
             // set the base of the halton sequences to the first n prime numbers, where n is dimensions
@@ -0,0 +1,162 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Rice University
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the Rice University nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include "ompl/base/samplers/deterministic/SobolSequence.h"
+#include "ompl/util/Exception.h"
+#include <algorithm>
+#include <string>
+
+namespace ompl
+{
+    namespace
+    {
+        /* Primitive polynomial of degree s with coefficients a and initial
+           direction numbers m for the dimensions after the first one */
+        struct DirectionNumbers
+        {
+            unsigned int s;
+            unsigned int a;
+            unsigned int m[7];
+        };
+
+        const DirectionNumbers JOE_KUO[] = {
+            {1, 0, {1}},
+            {2, 1, {1, 3}},
+            {3, 1, {1, 3, 1}},
+            {3, 2, {1, 1, 1}},
+            {4, 1, {1, 1, 3, 3}},
+            {4, 4, {1, 3, 5, 13}},
+            {5, 2, {1, 1, 5, 5, 17}},
+            {5, 4, {1, 1, 5, 5, 5}},
+            {5, 7, {1, 1, 7, 11, 19}},
+            {5, 11, {1, 1, 5, 1, 1}},
+            {5, 13, {1, 1, 1, 3, 11}},
+            {5, 14, {1, 3, 5, 5, 31}},
+            {6, 1, {1, 3, 3, 9, 7, 49}},
+            {6, 13, {1, 1, 1, 15, 21, 21}},
+            {6, 16, {1, 3, 1, 13, 27, 49}},
+            {6, 19, {1, 1, 1, 15, 7, 5}},
+            {6, 22, {1, 3, 1, 15, 13, 25}},
+            {6, 25, {1, 1, 5, 5, 19, 61}},
+            {7, 1, {1, 3, 7, 11, 23, 15, 103}},
+            {7, 4, {1, 3, 7, 13, 13, 15, 69}}};
+    }
+
+    namespace base
+    {
+        SobolSequence::SobolSequence(unsigned int dimensions)
+          : DeterministicSequence(dimensions), directions_(dimensions * BITS), x_(dimensions, 0u)
+        {
+            if (dimensions > maxDimensions())
+                throw Exception("SobolSequence", "Direction numbers are only available for up to " +
+                                                     std::to_string(maxDimensions()) + " dimensions");
+
+            // The first dimension is the van der Corput sequence in base 2
+            for (unsigned int j = 0; j < BITS && dimensions > 0; ++j)
+                directions_[j] = 1u << (BITS - 1 - j);
+
+            for (unsigned int d = 1; d < dimensions; ++d)
+            {
+                const DirectionNumbers &dn = JOE_KUO[d - 1];
+                std::uint32_t *v = &directions_[d * BITS];
+                for (unsigned int j = 0; j < dn.s; ++j)
+                    v[j] = dn.m[j] << (BITS - 1 - j);
+                for (unsigned int j = dn.s; j < BITS; ++j)
+                {
+                    v[j] = v[j - dn.s] ^ (v[j - dn.s] >> dn.s);
+                    for (unsigned int k = 1; k < dn.s; ++k)
+                        if ((dn.a >> (dn.s - 1 - k)) & 1u)
+                            v[j] ^= v[j - k];
+                }
+            }
+        }
+
+        unsigned int SobolSequence::maxDimensions()
+        {
+            return 1 + sizeof(JOE_KUO) / sizeof(JOE_KUO[0]);
+        }
+
+        void SobolSequence::advance()
+        {
+            // In Gray code order, sample i + 1 differs from sample i by the direction
+            // number of the lowest zero bit of i
+            unsigned int c = 0;
+            for (std::uint64_t i = index_; (i & 1u) != 0u; i >>= 1)
+                ++c;
+            ++index_;
+            if (c >= BITS)
+            {
+                // The sequence repeats
+                index_ = 0;
+                std::fill(x_.begin(), x_.end(), 0u);
+                return;
+            }
+            const std::uint32_t *v = &directions_[c];
+            for (unsigned int d = 0; d < dimensions_; ++d)
+                x_[d] ^= v[d * BITS];
+        }
+
+        std::vector<double> SobolSequence::sample()
+        {
+            std::vector<double> s(dimensions_);
+            sampleBatch(s.data(), 1);
+            return s;
+        }
+
+        void SobolSequence::sampleBatch(double values[], std::size_t count)
+        {
+            const double scale = 1.0 / 4294967296.0;  // 2^-32
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                double *out = values + i * dimensions_;
+                for (unsigned int d = 0; d < dimensions_; ++d)
+                    out[d] = scale * x_[d];
+                advance();
+            }
+        }
+
+        void SobolSequence::skip(std::uint64_t count)
+        {
+            index_ = (index_ + count) & ((std::uint64_t(1) << BITS) - 1);
+
+            // Sample i is the exclusive or of the direction numbers of the set bits of the Gray code of i
+            const std::uint64_t gray = index_ ^ (index_ >> 1);
+            std::fill(x_.begin(), x_.end(), 0u);
+            for (unsigned int j = 0; j < BITS; ++j)
+                if ((gray >> j) & 1u)
+                    for (unsigned int d = 0; d < dimensions_; ++d)
+                        x_[d] ^= directions_[d * BITS + j];
+        }
+    }  // namespace base
+}  // namespace ompl
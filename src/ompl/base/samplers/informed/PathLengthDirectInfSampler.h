@@ -95,6 +95,14 @@ namespace ompl
              * number of iterations. */
             bool sampleUniform(State *statePtr, const Cost &minCost, const Cost &maxCost) override;
 
+            /** \brief Sample up to \e n states uniformly in the subset of the state space whose heuristic solution
+             * estimates are less than the provided cost. When the PHSs are sampled directly, the unit-ball samples of
+             * each PHS are drawn and transformed as one matrix and candidates outside the bounds of a real vector
+             * informed subspace are rejected before any state is created. The found samples are in random order with
+             * respect to the PHSs. Returns the number of samples found. */
+            unsigned int sampleUniformBatch(const std::vector<State *> &states, unsigned int n,
+                                            const Cost &maxCost) override;
+
             /** \brief Whether the sampler can provide a measure of the informed subset */
             bool hasInformedMeasure() const override;
 
@@ -126,6 +134,11 @@ namespace ompl
              * (i.e., it \e may be kept). */
             bool samplePhsRejectBounds(State *statePtr, unsigned int *iters);
 
+            /** \brief The batch version of samplePhsRejectBounds. Samples \e n states into \e states, spending at
+             * most \e maxIters candidates, and returns the number found. */
+            unsigned int samplePhsRejectBoundsBatch(const std::vector<State *> &states, unsigned int n,
+                                                    unsigned long maxIters);
+
             // Low level
             /** \brief Extract the informed subspace from a state pointer */
             std::vector<double> getInformedSubstate(const State *statePtr) const;
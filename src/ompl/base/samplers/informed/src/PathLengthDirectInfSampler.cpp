@@ -42,8 +42,16 @@
 #include "ompl/base/StateSpace.h"
 #include "ompl/base/spaces/RealVectorStateSpace.h"
 
+// For the batch transformations
+#include <Eigen/Core>
+// For std::find, std::min
+#include <algorithm>
+// For std::pow
+#include <cmath>
 // For std::make_shared
 #include <memory>
+// For std::iota
+#include <numeric>
 // For std::vector
 #include <vector>
 
@@ -292,6 +300,36 @@ namespace ompl
             return foundSample;
         }
 
+        unsigned int PathLengthDirectInfSampler::sampleUniformBatch(const std::vector<State *> &states,
+                                                                    unsigned int n, const Cost &maxCost)
+        {
+            // Check if a solution path has been found
+            if (!InformedSampler::opt_->isFinite(maxCost))
+            {
+                // We don't have a solution yet, we sample from our basic sampler instead...
+                for (unsigned int i = 0u; i < n; ++i)
+                {
+                    baseSampler_->sampleUniform(states.at(i));
+                }
+
+                return n;
+            }
+
+            // Update the definitions of the PHSs
+            updatePhsDefinitions(maxCost);
+
+            // When the PHSs are large relative to the domain we rejection sample the whole space, which gains nothing
+            // from batching. Use the single-sample method.
+            if (informedSubSpace_->getMeasure() < summedMeasure_ / static_cast<double>(listPhsPtrs_.size()))
+            {
+                return InformedSampler::sampleUniformBatch(states, n, maxCost);
+            }
+
+            // Otherwise directly sample the PHSs, giving each requested sample the same budget as sampleUniform
+            return samplePhsRejectBoundsBatch(states, n,
+                                              static_cast<unsigned long>(InformedSampler::numIters_) * n);
+        }
+
         bool PathLengthDirectInfSampler::hasInformedMeasure() const
         {
             return true;
@@ -460,6 +498,131 @@ namespace ompl
             return foundSample;
         }
 
+        unsigned int PathLengthDirectInfSampler::samplePhsRejectBoundsBatch(const std::vector<State *> &states,
+                                                                            unsigned int n, unsigned long maxIters)
+        {
+            // Variables
+            // The dimension of the informed subspace
+            const unsigned int dim = informedSubSpace_->getDimension();
+            // The bounds of the informed subspace, if it is a real vector space and they can be checked as a block
+            const RealVectorBounds *bounds = nullptr;
+            // The number of samples found and the number of candidates drawn
+            unsigned int numFound = 0u;
+            unsigned long iters = 0u;
+            // The candidates as the columns of a matrix, in the unit ball and in the PHSs
+            Eigen::MatrixXd unitBall;
+            Eigen::MatrixXd candidates;
+            // The informed subset of a candidate as a vector
+            std::vector<double> informedVector(dim);
+
+            if (informedSubSpace_->getType() == STATE_SPACE_REAL_VECTOR)
+            {
+                bounds = &informedSubSpace_->as<RealVectorStateSpace>()->getBounds();
+            }
+
+            while (numFound < n && iters < maxIters)
+            {
+                // Variables
+                // The number of candidates to draw this round
+                const auto numCandidates =
+                    static_cast<unsigned int>(std::min(static_cast<unsigned long>(n - numFound), maxIters - iters));
+                // The column of the next candidate
+                unsigned int col = 0u;
+
+                // Draw the candidates uniformly in the unit ball: a normalized Gaussian direction scaled by a radius
+                // distributed as U^(1/dim)
+                unitBall.resize(dim, numCandidates);
+                candidates.resize(dim, numCandidates);
+                for (unsigned int j = 0u; j < numCandidates; ++j)
+                {
+                    for (unsigned int i = 0u; i < dim; ++i)
+                    {
+                        unitBall(i, j) = rng_.gaussian01();
+                    }
+                    unitBall.col(j) *= std::pow(rng_.uniform01(), 1.0 / static_cast<double>(dim)) /
+                                       unitBall.col(j).norm();
+                }
+
+                // Assign the candidates to the PHSs by their relative measure
+                std::vector<unsigned int> numInPhs(listPhsPtrs_.size(), 0u);
+                if (listPhsPtrs_.size() == 1u)
+                {
+                    numInPhs.front() = numCandidates;
+                }
+                else
+                {
+                    for (unsigned int j = 0u; j < numCandidates; ++j)
+                    {
+                        ++numInPhs.at(std::distance(listPhsPtrs_.begin(),
+                                                    std::find(listPhsPtrs_.begin(), listPhsPtrs_.end(), randomPhsPtr())));
+                    }
+                }
+
+                // Transform each PHS's share of the candidates as one block
+                auto numIter = numInPhs.cbegin();
+                for (const auto &phsPtr : listPhsPtrs_)
+                {
+                    if (*numIter > 0u)
+                    {
+                        phsPtr->transformBatch(unitBall.col(col).data(), candidates.col(col).data(), *numIter);
+                        col += *numIter;
+                    }
+                    // No else
+                    ++numIter;
+                }
+
+                // Count the candidates against our budget
+                iters += numCandidates;
+
+                // The candidates are grouped by PHS, so visit them in random order to mix the PHSs in the output
+                std::vector<unsigned int> order(numCandidates);
+                std::iota(order.begin(), order.end(), 0u);
+                if (listPhsPtrs_.size() > 1u)
+                {
+                    rng_.shuffle(order.begin(), order.end());
+                }
+                // No else
+
+                // Keep the candidates that are in the problem domain, and with probability 1/K if they are in K PHSs
+                for (unsigned int j : order)
+                {
+                    // Reject out-of-bounds real vector candidates before creating a state
+                    if (bounds != nullptr)
+                    {
+                        if ((candidates.col(j).array() < Eigen::Map<const Eigen::ArrayXd>(bounds->low.data(), dim))
+                                .any() ||
+                            (candidates.col(j).array() > Eigen::Map<const Eigen::ArrayXd>(bounds->high.data(), dim))
+                                .any())
+                        {
+                            continue;
+                        }
+                        // No else
+                    }
+                    // No else
+
+                    Eigen::Map<Eigen::VectorXd>(informedVector.data(), dim) = candidates.col(j);
+
+                    // Keep with probability 1/K
+                    if (listPhsPtrs_.size() > 1u && !keepSample(informedVector))
+                    {
+                        continue;
+                    }
+                    // No else
+
+                    // Turn into a state of our full space and keep it if it's in the problem
+                    createFullState(states.at(numFound), informedVector);
+                    if (bounds != nullptr || InformedSampler::space_->satisfiesBounds(states.at(numFound)))
+                    {
+                        ++numFound;
+                    }
+                    // No else
+                }
+            }
+
+            // Successful?
+            return numFound;
+        }
+
         std::vector<double> PathLengthDirectInfSampler::getInformedSubstate(const State *statePtr) const
         {
             // Variable
@@ -36,10 +36,14 @@
 
 #include "ompl/base/samplers/DeterministicStateSampler.h"
 #include "ompl/base/samplers/deterministic/HaltonSequence.h"
+#include "ompl/base/samplers/deterministic/SobolSequence.h"
 #include "ompl/base/spaces/SE2StateSpace.h"
+#include "ompl/base/spaces/SE3StateSpace.h"
 #include "ompl/base/spaces/SO2StateSpace.h"
 #include "ompl/base/spaces/RealVectorStateSpace.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <boost/math/constants/constants.hpp>
 
@@ -55,9 +59,20 @@ namespace ompl
                 case HALTON:
                     sequence_ptr_ = std::make_shared<HaltonSequence>(space->getDimension());
                     break;
+                case SCRAMBLED_HALTON:
+                {
+                    auto halton = std::make_shared<HaltonSequence>(space->getDimension());
+                    // The scrambling is reproducible when the global seed is set
+                    halton->scramble(RNG().getLocalSeed());
+                    sequence_ptr_ = halton;
+                    break;
+                }
+                case SOBOL:
+                    sequence_ptr_ = std::make_shared<SobolSequence>(space->getDimension());
+                    break;
                 default:
                     OMPL_WARN("Unknown deterministic sampler type specified, using Halton instead.");
-
+                    sequence_ptr_ = std::make_shared<HaltonSequence>(space->getDimension());
                     break;
             }
         }
@@ -68,13 +83,40 @@ namespace ompl
         {
         }
 
-        void SO2DeterministicStateSampler::sampleUniform(State *state)
+        void DeterministicStateSampler::sampleUniformBatch(State **states, std::size_t n)
+        {
+            const unsigned int dim = sequence_ptr_->dimensions_;
+            std::vector<double> values(n * dim);
+            sequence_ptr_->sampleBatch(values.data(), n);
+            std::vector<double> sample(dim);
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                std::copy(values.begin() + j * dim, values.begin() + (j + 1) * dim, sample.begin());
+                space_->copyFromReals(states[j], sample);
+            }
+        }
+
+        void SO2DeterministicStateSampler::setState(State *state, const double *sample) const
         {
-            auto sample = sequence_ptr_->sample();
             state->as<SO2StateSpace::StateType>()->value =
                 -boost::math::constants::pi<double>() + sample[0] * 2 * boost::math::constants::pi<double>();
         }
 
+        void SO2DeterministicStateSampler::sampleUniform(State *state)
+        {
+            auto sample = sequence_ptr_->sample();
+            setState(state, sample.data());
+        }
+
+        void SO2DeterministicStateSampler::sampleUniformBatch(State **states, std::size_t n)
+        {
+            const unsigned int dim = sequence_ptr_->dimensions_;
+            std::vector<double> values(n * dim);
+            sequence_ptr_->sampleBatch(values.data(), n);
+            for (std::size_t j = 0; j < n; ++j)
+                setState(states[j], &values[j * dim]);
+        }
+
         void SO2DeterministicStateSampler::sampleUniformNear(State *, const State *, double)
         {
             OMPL_WARN("Deterministic sampler does not support near sampling.");
@@ -85,10 +127,8 @@ namespace ompl
             OMPL_WARN("Deterministic sampler does not support Gaussian sampling.");
         }
 
-        void RealVectorDeterministicStateSampler::sampleUniform(State *state)
+        void RealVectorDeterministicStateSampler::setState(State *state, const double *sample) const
         {
-            auto sample = sequence_ptr_->sample();
-
             const unsigned int dim = space_->getDimension();
 
             const RealVectorBounds &bounds = static_cast<const RealVectorStateSpace *>(space_)->getBounds();
@@ -107,6 +147,21 @@ namespace ompl
             }
         }
 
+        void RealVectorDeterministicStateSampler::sampleUniform(State *state)
+        {
+            auto sample = sequence_ptr_->sample();
+            setState(state, sample.data());
+        }
+
+        void RealVectorDeterministicStateSampler::sampleUniformBatch(State **states, std::size_t n)
+        {
+            const unsigned int dim = sequence_ptr_->dimensions_;
+            std::vector<double> values(n * dim);
+            sequence_ptr_->sampleBatch(values.data(), n);
+            for (std::size_t j = 0; j < n; ++j)
+                setState(states[j], &values[j * dim]);
+        }
+
         void RealVectorDeterministicStateSampler::sampleUniformNear(State *, const State *, double)
         {
             OMPL_WARN("Deterministic sampler does not support near sampling.");
@@ -117,10 +172,8 @@ namespace ompl
             OMPL_WARN("Deterministic sampler does not support Gaussian sampling.");
         }
 
-        void SE2DeterministicStateSampler::sampleUniform(State *state)
+        void SE2DeterministicStateSampler::setState(State *state, const double *sample) const
         {
-            auto sample = sequence_ptr_->sample();
-
             const RealVectorBounds &bounds = static_cast<const SE2StateSpace *>(space_)->getBounds();
 
             auto se2_state_ptr = static_cast<SE2StateSpace::StateType *>(state);
@@ -139,6 +192,21 @@ namespace ompl
                 se2_state_ptr->setYaw(sample[2]);
         }
 
+        void SE2DeterministicStateSampler::sampleUniform(State *state)
+        {
+            auto sample = sequence_ptr_->sample();
+            setState(state, sample.data());
+        }
+
+        void SE2DeterministicStateSampler::sampleUniformBatch(State **states, std::size_t n)
+        {
+            const unsigned int dim = sequence_ptr_->dimensions_;
+            std::vector<double> values(n * dim);
+            sequence_ptr_->sampleBatch(values.data(), n);
+            for (std::size_t j = 0; j < n; ++j)
+                setState(states[j], &values[j * dim]);
+        }
+
         void SE2DeterministicStateSampler::sampleUniformNear(State *, const State *, double)
         {
             OMPL_WARN("Deterministic sampler does not support near sampling.");
@@ -148,5 +216,49 @@ namespace ompl
         {
             OMPL_WARN("Deterministic sampler does not support Gaussian sampling.");
         }
+
+        void SE3DeterministicStateSampler::setState(State *state, const double *sample) const
+        {
+            const RealVectorBounds &bounds = static_cast<const SE3StateSpace *>(space_)->getBounds();
+
+            auto *se3_state_ptr = static_cast<SE3StateSpace::StateType *>(state);
+            se3_state_ptr->setXYZ(bounds.low[0] + sample[0] * (bounds.high[0] - bounds.low[0]),
+                                  bounds.low[1] + sample[1] * (bounds.high[1] - bounds.low[1]),
+                                  bounds.low[2] + sample[2] * (bounds.high[2] - bounds.low[2]));
+
+            const double pi = boost::math::constants::pi<double>();
+            double r1 = sqrt(1.0 - sample[3]), r2 = sqrt(sample[3]);
+            double t1 = 2.0 * pi * sample[4], t2 = 2.0 * pi * sample[5];
+            SO3StateSpace::StateType &q = se3_state_ptr->rotation();
+            q.x = sin(t1) * r1;
+            q.y = cos(t1) * r1;
+            q.z = sin(t2) * r2;
+            q.w = cos(t2) * r2;
+        }
+
+        void SE3DeterministicStateSampler::sampleUniform(State *state)
+        {
+            auto sample = sequence_ptr_->sample();
+            setState(state, sample.data());
+        }
+
+        void SE3DeterministicStateSampler::sampleUniformBatch(State **states, std::size_t n)
+        {
+            const unsigned int dim = sequence_ptr_->dimensions_;
+            std::vector<double> values(n * dim);
+            sequence_ptr_->sampleBatch(values.data(), n);
+            for (std::size_t j = 0; j < n; ++j)
+                setState(states[j], &values[j * dim]);
+        }
+
+        void SE3DeterministicStateSampler::sampleUniformNear(State *, const State *, double)
+        {
+            OMPL_WARN("Deterministic sampler does not support near sampling.");
+        }
+
+        void SE3DeterministicStateSampler::sampleGaussian(State *, const State *, double)
+        {
+            OMPL_WARN("Deterministic sampler does not support Gaussian sampling.");
+        }
     }  // namespace base
 }  // namespace ompl
@@ -68,6 +68,26 @@ namespace ompl
             opt_ = probDefn_->getOptimizationObjective();
         }
 
+        unsigned int InformedSampler::sampleUniformBatch(const std::vector<State *> &states, unsigned int n,
+                                                         const Cost &maxCost)
+        {
+            // Variable
+            // The number of samples found
+            unsigned int numFound = 0u;
+
+            // Sample one state at a time, compacting the successful ones to the front
+            for (unsigned int i = 0u; i < n; ++i)
+            {
+                if (sampleUniform(states.at(numFound), maxCost))
+                {
+                    ++numFound;
+                }
+                // No else
+            }
+
+            return numFound;
+        }
+
         double InformedSampler::getInformedMeasure(const Cost &minCost, const Cost &maxCost) const
         {
             // Subtract the measures defined by the max and min costs. These will be defined in the deriving class.
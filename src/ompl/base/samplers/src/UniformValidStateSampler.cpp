@@ -36,6 +36,7 @@
 
 #include "ompl/base/samplers/UniformValidStateSampler.h"
 #include "ompl/base/SpaceInformation.h"
+#include <utility>
 
 ompl::base::UniformValidStateSampler::UniformValidStateSampler(const SpaceInformation *si)
   : ValidStateSampler(si), sampler_(si->allocStateSampler())
@@ -56,6 +57,20 @@ bool ompl::base::UniformValidStateSampler::sample(State *state)
     return valid;
 }
 
+std::size_t ompl::base::UniformValidStateSampler::sampleBatch(State **states, std::size_t n)
+{
+    std::size_t found = 0;
+    for (unsigned int attempts = 0; attempts < attempts_ && found < n; ++attempts)
+    {
+        sampler_->sampleUniformBatch(states + found, n - found);
+        // move the valid states to the front
+        for (std::size_t i = found; i < n; ++i)
+            if (si_->isValid(states[i]))
+                std::swap(states[found++], states[i]);
+    }
+    return found;
+}
+
 bool ompl::base::UniformValidStateSampler::sampleNear(State *state, const State *near, const double distance)
 {
     unsigned int attempts = 0;
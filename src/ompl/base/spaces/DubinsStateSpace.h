@@ -137,9 +137,24 @@ namespace ompl
                 StateSpace::sanityChecks(zero, eps, flags);
             }
 
-            /** \brief Return the shortest Dubins path from SE(2) state state1 to SE(2) state state2 */
+            /** \brief Return the shortest Dubins path from SE(2) state state1 to SE(2) state state2.
+                Recently computed paths are remembered per thread, keyed by the relative pose of the two
+                states, so that calling distance() and then interpolate() for the same motion computes
+                the path only once. */
             DubinsPath dubins(const State *state1, const State *state2) const;
 
+            /** \brief Return a cheap lower bound on distance(\a state1, \a state2): the larger of the
+                Euclidean distance between the positions and the turning radius times the change in
+                heading. */
+            double distanceLowerBound(const State *state1, const State *state2) const;
+
+            /** \brief Compute the distances from \a state to each of \a states and store them in
+                \a distances. States whose distanceLowerBound() exceeds \a maxDistance are not
+                evaluated exactly and are assigned infinity. */
+            void batchDistance(const State *state, const std::vector<const State *> &states,
+                               std::vector<double> &distances,
+                               double maxDistance = std::numeric_limits<double>::infinity()) const;
+
         protected:
             virtual void interpolate(const State *from, const DubinsPath &path, double t, State *state) const;
 
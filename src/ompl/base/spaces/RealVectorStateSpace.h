@@ -57,6 +57,10 @@ namespace ompl
             }
 
             void sampleUniform(State *state) override;
+            /** \brief Sample \e n states, drawing all their components
+                with a single bulk call to the random number generator
+                if batch sampling is enabled. */
+            void sampleUniformBatch(State **states, std::size_t n) override;
             /** \brief Sample a state such that each component state[i] is
                 uniformly sampled from [near[i]-distance, near[i]+distance].
                 If this interval exceeds the state space bounds, the
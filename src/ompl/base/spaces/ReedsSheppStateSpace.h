@@ -40,6 +40,9 @@
 #include "ompl/base/spaces/SE2StateSpace.h"
 #include "ompl/base/MotionValidator.h"
 #include <boost/math/constants/constants.hpp>
+#include <memory>
+#include <string>
+#include <vector>
 
 namespace ompl
 {
@@ -97,6 +100,9 @@ namespace ompl
             {
             }
 
+            /** \brief Return the length of the shortest Reeds-Shepp path. If a distance table
+                is loaded (see loadDistanceTable()), the length is interpolated from the table
+                where possible. */
             double distance(const State *state1, const State *state2) const override;
 
             void interpolate(const State *from, const State *to, double t, State *state) const override;
@@ -110,14 +116,91 @@ namespace ompl
                 StateSpace::sanityChecks(zero, eps, ~STATESPACE_INTERPOLATION);
             }
 
-            /** \brief Return the shortest Reeds-Shepp path from SE(2) state state1 to SE(2) state state2 */
+            /** \brief Return the shortest Reeds-Shepp path from SE(2) state state1 to SE(2) state state2.
+                Recently computed paths are remembered per thread, keyed by the relative pose of the two
+                states, so that calling distance() and then interpolate() for the same motion computes
+                the path only once. */
             ReedsSheppPath reedsShepp(const State *state1, const State *state2) const;
 
+            /** \brief Return a cheap lower bound on distance(\a state1, \a state2): the larger of the
+                Euclidean distance between the positions and the turning radius times the change in
+                heading. */
+            double distanceLowerBound(const State *state1, const State *state2) const;
+
+            /** \brief Compute the distances from \a state to each of \a states and store them in
+                \a distances. States whose distanceLowerBound() exceeds \a maxDistance are not
+                evaluated exactly and are assigned infinity. */
+            void batchDistance(const State *state, const std::vector<const State *> &states,
+                               std::vector<double> &distances,
+                               double maxDistance = std::numeric_limits<double>::infinity()) const;
+
+            /** \brief Precompute the shortest Reeds-Shepp path lengths for a unit turning radius on
+                a regular grid of relative poses and write them to \a filename. The grid spans
+                [-\a extent, \a extent] in x and y with \a cellsXY cells along each axis, and
+                [-pi, pi] in the heading with \a cellsTheta cells, along with a conservative estimate
+                of the interpolation error of each cell. The table does not depend on the
+                turning radius and can be used by any ReedsSheppStateSpace. The file is in the
+                native byte order. Returns false if the file cannot be written. */
+            static bool generateDistanceTable(const std::string &filename, double extent = 10.,
+                                              unsigned int cellsXY = 200, unsigned int cellsTheta = 72);
+
+            /** \brief Load a table written by generateDistanceTable(). Afterwards, distance()
+                interpolates the path length from the table for relative poses within its extent.
+                The table records an estimate of the interpolation error of each cell. Where it
+                exceeds \a tolerance (in units of the turning radius), typically near changes of
+                the optimal path type, the exact length is computed instead. Returns false if the
+                file cannot be read, in which case no table is used. */
+            bool loadDistanceTable(const std::string &filename, double tolerance = 0.01);
+
+            /** \brief The interpolated distance of a loaded distance table is not guaranteed to satisfy
+                the triangle inequality, so the space is only treated as a metric space without one. */
+            bool isMetricSpace() const override
+            {
+                return distanceTable_ == nullptr;
+            }
+
+            /** \brief Stop using the distance table. */
+            void clearDistanceTable()
+            {
+                distanceTable_.reset();
+            }
+
+            /** \brief Return whether a distance table is loaded. */
+            bool hasDistanceTable() const
+            {
+                return distanceTable_ != nullptr;
+            }
+
         protected:
             virtual void interpolate(const State *from, const ReedsSheppPath &path, double t, State *state) const;
 
+            /** \brief Path lengths for a unit turning radius, precomputed on a grid of relative poses */
+            struct DistanceTable
+            {
+                /** \brief Half the width of the table in x and y */
+                double extent;
+                /** \brief Number of cells along the x and y axes */
+                unsigned int cellsXY;
+                /** \brief Number of cells along the heading axis */
+                unsigned int cellsTheta;
+                /** \brief Maximum estimated interpolation error of a cell that is interpolated */
+                double tolerance;
+                /** \brief Path lengths at the grid points, with x varying slowest and the heading fastest */
+                std::vector<float> lengths;
+                /** \brief Estimated interpolation error of each cell, in the same order */
+                std::vector<float> errors;
+            };
+
+            /** \brief Interpolate the length of the shortest path for relative pose (\a x, \a y,
+                \a phi), for a unit turning radius, from the distance table. Returns false if the
+                pose is outside of the table or its cell needs exact refinement. */
+            bool lookupDistance(double x, double y, double phi, double &length) const;
+
             /** \brief Turning radius */
             double rho_;
+
+            /** \brief Table of precomputed path lengths, if loaded */
+            std::shared_ptr<const DistanceTable> distanceTable_;
         };
 
         /** \brief A Reeds-Shepp motion validator that only uses the state validity checker.
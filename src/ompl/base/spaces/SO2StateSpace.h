@@ -53,6 +53,7 @@ namespace ompl
             }
 
             void sampleUniform(State *state) override;
+            void sampleUniformBatch(State **states, std::size_t n) override;
             void sampleUniformNear(State *state, const State *near, double distance) override;
             void sampleGaussian(State *state, const State *mean, double stdDev) override;
         };
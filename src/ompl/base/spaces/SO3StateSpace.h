@@ -53,6 +53,10 @@ namespace ompl
             }
 
             void sampleUniform(State *state) override;
+            /** \brief Sample \e n uniformly distributed unit quaternions
+                from one bulk draw of uniform random values if batch
+                sampling is enabled. */
+            void sampleUniformBatch(State **states, std::size_t n) override;
             /** \brief To sample unit quaternions uniformly within some given
                 distance, we sample a 3-vector from the R^3 tangent space.
                 This vector is drawn uniformly random from a 3D ball centered at
@@ -40,6 +40,7 @@
 #include "ompl/base/spaces/constraint/AtlasStateSpace.h"
 #include "ompl/datastructures/PDF.h"
 
+#include <limits>
 #include <vector>
 #include <Eigen/Core>
 
@@ -103,6 +104,11 @@ namespace ompl
                     return complement_;
                 }
 
+                /** \brief Record the position \a index of this halfspace in
+                 * the polytope of its owner, and copy the inequality into the
+                 * owner's halfspace arrays. */
+                void setIndex(std::size_t index);
+
                 /** \brief Get the chart to which this halfspace belongs. */
                 const AtlasChart *getOwner() const
                 {
@@ -127,6 +133,10 @@ namespace ompl
                 /** \brief Precomputed right-hand side of the inequality. */
                 double rhs_;
 
+                /** \brief Position of this halfspace in the polytope of its
+                 * owner, once it has been added to it. */
+                std::size_t index_{std::numeric_limits<std::size_t>::max()};
+
                 /** \brief Generate the linear inequality. We will divide the
                  * space in half between \a u and 0, and 0 will lie inside. */
                 void setU(const Eigen::Ref<const Eigen::VectorXd> &u);
@@ -262,6 +272,14 @@ namespace ompl
 
             /** \brief Maximum valid radius of this chart. */
             const double radius_;
+
+            /** \brief Normals of the halfspaces in the polytope, one per
+             * column, kept contiguous so inPolytope() can test all of them
+             * in one vectorized product. */
+            mutable Eigen::MatrixXd halfspaceNormals_;
+
+            /** \brief Right-hand sides of the halfspaces in the polytope. */
+            mutable Eigen::VectorXd halfspaceOffsets_;
         };
     }
 }
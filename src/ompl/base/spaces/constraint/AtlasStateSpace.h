@@ -47,6 +47,9 @@
 
 #include <boost/math/constants/constants.hpp>
 
+#include <atomic>
+#include <cstdint>
+
 namespace ompl
 {
     namespace magic
@@ -379,6 +382,36 @@ namespace ompl
             /** \brief Write a mesh representation of the atlas to a stream. */
             void printPLY(std::ostream &out) const;
 
+            /** \brief Sets whether owningChart() counts and times its chart
+             * lookups, for getChartLookupCount() and getChartLookupTime().
+             * Off by default, since timing every lookup is not free. */
+            void setChartLookupStatistics(bool statistics)
+            {
+                chartLookupStatistics_ = statistics;
+            }
+
+            /** \brief Returns whether chart lookups are counted and timed. */
+            bool getChartLookupStatistics() const
+            {
+                return chartLookupStatistics_;
+            }
+
+            /** \brief Return the number of times owningChart() looked up the
+             * chart of a state since the atlas was last cleared, if
+             * setChartLookupStatistics() is on. */
+            std::size_t getChartLookupCount() const
+            {
+                return chartLookupCount_;
+            }
+
+            /** \brief Return the total time in seconds spent looking up the
+             * chart of a state since the atlas was last cleared, if
+             * setChartLookupStatistics() is on. */
+            double getChartLookupTime() const
+            {
+                return 1e-9 * chartLookupNanoseconds_;
+            }
+
             /** @} */
 
         protected:
@@ -395,6 +428,16 @@ namespace ompl
              * nearest-neighbor queries to the chart centers. */
             mutable NearestNeighborsGNAT<NNElement> chartNN_;
 
+            /** \brief Whether owningChart() counts and times its lookups. */
+            bool chartLookupStatistics_{false};
+
+            /** \brief Number of chart lookups done by owningChart(). Atomic,
+             * since planners may look up charts from several threads. */
+            mutable std::atomic<std::size_t> chartLookupCount_{0};
+
+            /** \brief Total time in nanoseconds spent in owningChart(). */
+            mutable std::atomic<std::uint64_t> chartLookupNanoseconds_{0};
+
             /** @name Tunable Parameters
                 @{ */
 
@@ -46,6 +46,12 @@
 
 #include <Eigen/Core>
 
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
 namespace ompl
 {
     namespace magic
@@ -260,6 +266,73 @@ namespace ompl
 
             /** @} */
 
+            /** @name Geodesic Cache
+                @{ */
+
+            /** \brief A discrete geodesic computed by discreteGeodesic(). The
+             * states are freed when the last reference to it is released. */
+            class Geodesic
+            {
+            public:
+                Geodesic(const ConstrainedStateSpace *space) : space_(space)
+                {
+                }
+
+                ~Geodesic();
+
+                /** \brief The intermediate states, including a copy of the
+                 * start state. */
+                std::vector<State *> states;
+
+                /** \brief Whether the traversal reached the final state. */
+                bool reached{false};
+
+                /** \brief Whether all intermediate states are known to be
+                 * valid. */
+                mutable std::atomic<bool> valid{false};
+
+            private:
+                const ConstrainedStateSpace *space_;
+            };
+
+            /** \brief Shared pointer to an immutable Geodesic. */
+            using GeodesicPtr = std::shared_ptr<const Geodesic>;
+
+            /** \brief Set the number of geodesics remembered between calls,
+             * keyed by their end points. Geodesics are evicted least recently
+             * used first. A size of 0, the default, disables the cache.
+             *
+             * Motion checks reuse the validity of a cached geodesic without
+             * calling the state validity checker again. The cache is cleared
+             * by setup() and when the state validity checker of the space
+             * information is replaced, but if the environment seen by the
+             * validity checker changes, clearGeodesicCache() must be called. */
+            void setGeodesicCacheSize(std::size_t size);
+
+            /** \brief Get the number of geodesics remembered between calls. */
+            std::size_t getGeodesicCacheSize() const
+            {
+                return geodesicCacheSize_;
+            }
+
+            /** \brief Forget all remembered geodesics. This needs to be
+             * called if the environment seen by the state validity checker
+             * changes. */
+            void clearGeodesicCache() const;
+
+            /** \brief Get the geodesic computed by discreteGeodesic(\a from, \a
+             * to, true, ...), without collision checking. The result is taken
+             * from the cache if possible, and added to it otherwise. */
+            GeodesicPtr getGeodesic(const State *from, const State *to) const;
+
+            /** \brief Return whether the manifold can be traversed from \a
+             * from to \a to without collision, like discreteGeodesic(\a
+             * from, \a to, false). If a geodesic between the two states is
+             * cached, only the validity of its states is checked (once). */
+            bool checkGeodesic(const State *from, const State *to) const;
+
+            /** @} */
+
             /** @name Setters and Getters
                 @{ */
 
@@ -278,6 +351,7 @@ namespace ompl
                     throw ompl::Exception("ompl::base::AtlasStateSpace::setLambda(): "
                                           "lambda must be > 1.");
                 lambda_ = lambda;
+                clearGeodesicCache();
             }
 
             /** \brief Get delta, the step size across the manifold. */
@@ -337,6 +411,50 @@ namespace ompl
 
             /** \brief Whether setup() has been called. */
             bool setup_{false};
+
+        private:
+            /** \brief Key of a cached geodesic, the values of its end points. */
+            using GeodesicKey = std::vector<double>;
+
+            /** \brief Hash of a GeodesicKey. */
+            struct GeodesicKeyHash
+            {
+                std::size_t operator()(const GeodesicKey &key) const;
+            };
+
+            /** \brief Build the cache key of the geodesic from \a from to \a to. */
+            GeodesicKey geodesicKey(const State *from, const State *to) const;
+
+            /** \brief Look up a cached geodesic, marking it as the most
+             * recently used. Returns nullptr if not found. */
+            GeodesicPtr findGeodesic(const GeodesicKey &key) const;
+
+            /** \brief Add a geodesic to the cache, evicting the least
+             * recently used ones if it is full. */
+            void addGeodesic(GeodesicKey key, const GeodesicPtr &geodesic) const;
+
+            /** \brief Forget the cached geodesics if the state validity
+             * checker was replaced since they were checked. Must be called
+             * with geodesicCacheMutex_ held. */
+            void checkGeodesicCacheChecker() const;
+
+            /** \brief Maximum number of cached geodesics. */
+            std::size_t geodesicCacheSize_{0};
+
+            /** \brief Cached geodesics, most recently used first. */
+            mutable std::list<std::pair<GeodesicKey, GeodesicPtr>> geodesicCache_;
+
+            /** \brief Index of the cached geodesics by their key. */
+            mutable std::unordered_map<GeodesicKey, std::list<std::pair<GeodesicKey, GeodesicPtr>>::iterator,
+                                       GeodesicKeyHash>
+                geodesicIndex_;
+
+            /** \brief The state validity checker the cached geodesics were
+             * checked with. */
+            mutable const StateValidityChecker *geodesicCacheChecker_{nullptr};
+
+            /** \brief Protects the geodesic cache. */
+            mutable std::mutex geodesicCacheMutex_;
         };
     }
 }
@@ -95,6 +95,13 @@ bool ompl::base::AtlasChart::Halfspace::circleIntersect(const double r, Eigen::R
     return true;
 }
 
+void ompl::base::AtlasChart::Halfspace::setIndex(std::size_t index)
+{
+    index_ = index;
+    owner_->halfspaceNormals_.col(index_) = u_;
+    owner_->halfspaceOffsets_[index_] = rhs_;
+}
+
 /// Public static
 
 void ompl::base::AtlasChart::Halfspace::intersect(const Halfspace &l1, const Halfspace &l2,
@@ -125,6 +132,13 @@ void ompl::base::AtlasChart::Halfspace::setU(const Eigen::Ref<const Eigen::Vecto
 
     // Precompute the right-hand side of the linear inequality.
     rhs_ = usqnorm_ / 2;
+
+    // Keep the copy used by the owner's polytope test up to date.
+    if (index_ < owner_->polytope_.size())
+    {
+        owner_->halfspaceNormals_.col(index_) = u_;
+        owner_->halfspaceOffsets_[index_] = rhs_;
+    }
 }
 
 double ompl::base::AtlasChart::Halfspace::distanceToPoint(const Eigen::Ref<const Eigen::VectorXd> &v) const
@@ -166,6 +180,7 @@ ompl::base::AtlasChart::AtlasChart(const AtlasStateSpace *atlas, const AtlasStat
       return decomp.kernel().householderQr().householderQ() * Eigen::MatrixXd::Identity(n_, k_);
   }())
   , radius_(atlas->getRho_s())
+  , halfspaceNormals_(k_, 0)
 {
 }
 
@@ -180,6 +195,8 @@ void ompl::base::AtlasChart::clear()
         delete h;
 
     polytope_.clear();
+    halfspaceNormals_.resize(k_, 0);
+    halfspaceOffsets_.resize(0);
 }
 
 void ompl::base::AtlasChart::phi(const Eigen::Ref<const Eigen::VectorXd> &u, Eigen::Ref<Eigen::VectorXd> out) const
@@ -241,12 +258,15 @@ bool ompl::base::AtlasChart::inPolytope(const Eigen::Ref<const Eigen::VectorXd>
     if (u.norm() > radius_)
         return false;
 
-    for (Halfspace *h : polytope_)
+    if (ignore1 == nullptr && ignore2 == nullptr)
+        return (halfspaceNormals_.transpose().lazyProduct(u).array() <= halfspaceOffsets_.array()).all();
+
+    for (std::size_t i = 0; i < polytope_.size(); ++i)
     {
-        if (h == ignore1 || h == ignore2)
+        if (polytope_[i] == ignore1 || polytope_[i] == ignore2)
             continue;
 
-        if (!h->contains(u))
+        if (halfspaceNormals_.col(i).dot(u) > halfspaceOffsets_[i])
             return false;
     }
 
@@ -387,4 +407,8 @@ void ompl::base::AtlasChart::generateHalfspace(AtlasChart *c1, AtlasChart *c2)
 void ompl::base::AtlasChart::addBoundary(Halfspace *halfspace)
 {
     polytope_.push_back(halfspace);
+
+    halfspaceNormals_.conservativeResize(k_, polytope_.size());
+    halfspaceOffsets_.conservativeResize(polytope_.size());
+    halfspace->setIndex(polytope_.size() - 1);
 }
@@ -39,6 +39,7 @@
 
 #include "ompl/base/SpaceInformation.h"
 #include "ompl/util/Exception.h"
+#include "ompl/util/Time.h"
 
 /// AtlasStateSampler
 
@@ -241,6 +242,9 @@ void ompl::base::AtlasStateSpace::clear()
     chartNN_.clear();
     chartPDF_.clear();
 
+    chartLookupCount_ = 0;
+    chartLookupNanoseconds_ = 0;
+
     // Reinstate the anchor charts
     for (auto anchor : anchors_)
         newChart(anchor);
@@ -338,6 +342,8 @@ ompl::base::AtlasChart *ompl::base::AtlasStateSpace::getChart(const StateType *s
 
 ompl::base::AtlasChart *ompl::base::AtlasStateSpace::owningChart(const StateType *state) const
 {
+    const time::point start = chartLookupStatistics_ ? time::now() : time::point();
+
     Eigen::VectorXd u_t(k_);
     auto temp = allocState()->as<StateType>();
 
@@ -364,6 +370,12 @@ ompl::base::AtlasChart *ompl::base::AtlasStateSpace::owningChart(const StateType
     }
 
     freeState(temp);
+
+    if (chartLookupStatistics_)
+    {
+        ++chartLookupCount_;
+        chartLookupNanoseconds_ += std::chrono::duration_cast<std::chrono::nanoseconds>(time::now() - start).count();
+    }
     return chart;
 }
 
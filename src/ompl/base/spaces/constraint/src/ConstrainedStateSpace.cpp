@@ -54,7 +54,7 @@ ompl::base::ConstrainedMotionValidator::ConstrainedMotionValidator(const SpaceIn
 
 bool ompl::base::ConstrainedMotionValidator::checkMotion(const State *s1, const State *s2) const
 {
-    return ss_.getConstraint()->isSatisfied(s2) && ss_.discreteGeodesic(s1, s2, false);
+    return ss_.getConstraint()->isSatisfied(s2) && ss_.checkGeodesic(s1, s2);
 }
 
 bool ompl::base::ConstrainedMotionValidator::checkMotion(const State *s1, const State *s2,
@@ -206,6 +206,7 @@ void ompl::base::ConstrainedStateSpace::setSpaceInformation(SpaceInformation *si
                               "si for ConstrainedStateSpace must be constructed from the same state space object.");
 
     si_ = si;
+    clearGeodesicCache();
 }
 
 void ompl::base::ConstrainedStateSpace::setDelta(double delta)
@@ -214,6 +215,7 @@ void ompl::base::ConstrainedStateSpace::setDelta(double delta)
         throw ompl::Exception("ompl::base::ConstrainedStateSpace::setDelta(): "
                               "delta must be positive.");
     delta_ = delta;
+    clearGeodesicCache();
 
     if (setup_)
     {
@@ -224,6 +226,9 @@ void ompl::base::ConstrainedStateSpace::setDelta(double delta)
 
 void ompl::base::ConstrainedStateSpace::setup()
 {
+    // The environment may have changed since the geodesics were checked.
+    clearGeodesicCache();
+
     if (setup_)
         return;
 
@@ -260,6 +265,7 @@ void ompl::base::ConstrainedStateSpace::setup()
 
 void ompl::base::ConstrainedStateSpace::clear()
 {
+    clearGeodesicCache();
 }
 
 ompl::base::State *ompl::base::ConstrainedStateSpace::allocState() const
@@ -271,17 +277,10 @@ void ompl::base::ConstrainedStateSpace::interpolate(const State *from, const Sta
                                                     State *state) const
 {
     // Get the list of intermediate states along the manifold.
-    std::vector<State *> geodesic;
+    GeodesicPtr geodesic = getGeodesic(from, to);
 
     // Default to returning `from' if traversal fails.
-    auto temp = from;
-    if (discreteGeodesic(from, to, true, &geodesic))
-        temp = geodesicInterpolate(geodesic, t);
-
-    copyState(state, temp);
-
-    for (auto s : geodesic)
-        freeState(s);
+    copyState(state, geodesic->reached ? geodesicInterpolate(geodesic->states, t) : from);
 }
 
 ompl::base::State *ompl::base::ConstrainedStateSpace::geodesicInterpolate(const std::vector<State *> &geodesic,
@@ -316,3 +315,149 @@ ompl::base::State *ompl::base::ConstrainedStateSpace::geodesicInterpolate(const
         return (t1 < t2 || std::abs(t1 - t2) < std::numeric_limits<double>::epsilon()) ? geodesic[i] : geodesic[i + 1];
     }
 }
+
+ompl::base::ConstrainedStateSpace::Geodesic::~Geodesic()
+{
+    for (auto s : states)
+        space_->freeState(s);
+}
+
+void ompl::base::ConstrainedStateSpace::setGeodesicCacheSize(std::size_t size)
+{
+    std::lock_guard<std::mutex> lock(geodesicCacheMutex_);
+    geodesicCacheSize_ = size;
+    while (geodesicCache_.size() > geodesicCacheSize_)
+    {
+        geodesicIndex_.erase(geodesicCache_.back().first);
+        geodesicCache_.pop_back();
+    }
+}
+
+void ompl::base::ConstrainedStateSpace::clearGeodesicCache() const
+{
+    std::lock_guard<std::mutex> lock(geodesicCacheMutex_);
+    geodesicIndex_.clear();
+    geodesicCache_.clear();
+}
+
+ompl::base::ConstrainedStateSpace::GeodesicPtr ompl::base::ConstrainedStateSpace::getGeodesic(const State *from,
+                                                                                            const State *to) const
+{
+    GeodesicKey key;
+    if (geodesicCacheSize_ > 0)
+    {
+        key = geodesicKey(from, to);
+        if (GeodesicPtr geodesic = findGeodesic(key))
+            return geodesic;
+    }
+
+    auto geodesic = std::make_shared<Geodesic>(this);
+    geodesic->reached = discreteGeodesic(from, to, true, &geodesic->states);
+
+    if (geodesicCacheSize_ > 0)
+        addGeodesic(std::move(key), geodesic);
+    return geodesic;
+}
+
+bool ompl::base::ConstrainedStateSpace::checkGeodesic(const State *from, const State *to) const
+{
+    if (geodesicCacheSize_ == 0)
+        return discreteGeodesic(from, to, false);
+
+    GeodesicKey key = geodesicKey(from, to);
+    if (GeodesicPtr geodesic = findGeodesic(key))
+    {
+        if (!geodesic->reached)
+            return false;
+        if (geodesic->valid)
+            return true;
+
+        // Like discreteGeodesic(), assume that the first state is valid.
+        for (std::size_t i = 1; i < geodesic->states.size(); ++i)
+            if (!si_->isValid(geodesic->states[i]))
+                return false;
+
+        geodesic->valid = true;
+        return true;
+    }
+
+    // Stop at the first collision, and only remember complete traversals,
+    // which are the same as the ones computed without collision checking.
+    auto geodesic = std::make_shared<Geodesic>(this);
+    if (!discreteGeodesic(from, to, false, &geodesic->states))
+        return false;
+
+    geodesic->reached = true;
+    geodesic->valid = true;
+    addGeodesic(std::move(key), geodesic);
+    return true;
+}
+
+/// Private
+
+std::size_t ompl::base::ConstrainedStateSpace::GeodesicKeyHash::operator()(const GeodesicKey &key) const
+{
+    std::size_t seed = 0;
+    std::hash<double> hasher;
+    for (double value : key)
+        seed ^= hasher(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    return seed;
+}
+
+ompl::base::ConstrainedStateSpace::GeodesicKey ompl::base::ConstrainedStateSpace::geodesicKey(const State *from,
+                                                                                            const State *to) const
+{
+    GeodesicKey key(2 * n_);
+    Eigen::Map<Eigen::VectorXd>(key.data(), n_) = *from->as<StateType>();
+    Eigen::Map<Eigen::VectorXd>(key.data() + n_, n_) = *to->as<StateType>();
+    return key;
+}
+
+ompl::base::ConstrainedStateSpace::GeodesicPtr
+ompl::base::ConstrainedStateSpace::findGeodesic(const GeodesicKey &key) const
+{
+    std::lock_guard<std::mutex> lock(geodesicCacheMutex_);
+    checkGeodesicCacheChecker();
+    auto it = geodesicIndex_.find(key);
+    if (it == geodesicIndex_.end())
+        return nullptr;
+
+    geodesicCache_.splice(geodesicCache_.begin(), geodesicCache_, it->second);
+    return it->second->second;
+}
+
+void ompl::base::ConstrainedStateSpace::checkGeodesicCacheChecker() const
+{
+    const StateValidityChecker *checker = si_ != nullptr ? si_->getStateValidityChecker().get() : nullptr;
+    if (checker != geodesicCacheChecker_)
+    {
+        geodesicIndex_.clear();
+        geodesicCache_.clear();
+        geodesicCacheChecker_ = checker;
+    }
+}
+
+void ompl::base::ConstrainedStateSpace::addGeodesic(GeodesicKey key, const GeodesicPtr &geodesic) const
+{
+    std::lock_guard<std::mutex> lock(geodesicCacheMutex_);
+    if (geodesicCacheSize_ == 0)
+        return;
+    checkGeodesicCacheChecker();
+
+    // Another thread may have computed the same geodesic in the meantime.
+    auto it = geodesicIndex_.find(key);
+    if (it != geodesicIndex_.end())
+    {
+        it->second->second = geodesic;
+        geodesicCache_.splice(geodesicCache_.begin(), geodesicCache_, it->second);
+        return;
+    }
+
+    geodesicCache_.emplace_front(key, geodesic);
+    geodesicIndex_.emplace(std::move(key), geodesicCache_.begin());
+    while (geodesicCache_.size() > geodesicCacheSize_)
+    {
+        geodesicIndex_.erase(geodesicCache_.back().first);
+        geodesicCache_.pop_back();
+    }
+}
@@ -37,6 +37,7 @@
 #include "ompl/base/spaces/DubinsStateSpace.h"
 #include "ompl/base/SpaceInformation.h"
 #include "ompl/util/Exception.h"
+#include <array>
 #include <queue>
 #include <boost/math/constants/constants.hpp>
 
@@ -201,6 +202,36 @@ namespace
             path = tmp;
         return path;
     }
+
+    // Direct-mapped cache of recently computed paths, keyed by the relative pose
+    // (which is all the optimal path depends on).
+    const std::size_t PATH_CACHE_SIZE = 64;
+    struct CachedPath
+    {
+        double d, alpha, beta;
+        DubinsStateSpace::DubinsPath path;
+        bool used{false};
+    };
+    thread_local std::array<CachedPath, PATH_CACHE_SIZE> pathCache;
+
+    const DubinsStateSpace::DubinsPath &cachedDubins(double d, double alpha, double beta)
+    {
+        std::hash<double> hasher;
+        std::size_t h = hasher(d);
+        h ^= hasher(alpha) + 0x9e3779b9 + (h << 6) + (h >> 2);
+        h ^= hasher(beta) + 0x9e3779b9 + (h << 6) + (h >> 2);
+
+        CachedPath &entry = pathCache[h % PATH_CACHE_SIZE];
+        if (!entry.used || entry.d != d || entry.alpha != alpha || entry.beta != beta)
+        {
+            entry.d = d;
+            entry.alpha = alpha;
+            entry.beta = beta;
+            entry.path = dubins(d, alpha, beta);
+            entry.used = true;
+        }
+        return entry.path;
+    }
 }
 
 const ompl::base::DubinsStateSpace::DubinsPathSegmentType ompl::base::DubinsStateSpace::dubinsPathType[6][3] = {
@@ -327,7 +358,45 @@ ompl::base::DubinsStateSpace::DubinsPath ompl::base::DubinsStateSpace::dubins(co
     double x2 = s2->getX(), y2 = s2->getY(), th2 = s2->getYaw();
     double dx = x2 - x1, dy = y2 - y1, d = sqrt(dx * dx + dy * dy) / rho_, th = atan2(dy, dx);
     double alpha = mod2pi(th1 - th), beta = mod2pi(th2 - th);
-    return ::dubins(d, alpha, beta);
+    return cachedDubins(d, alpha, beta);
+}
+
+double ompl::base::DubinsStateSpace::distanceLowerBound(const State *state1, const State *state2) const
+{
+    const auto *s1 = static_cast<const StateType *>(state1);
+    const auto *s2 = static_cast<const StateType *>(state2);
+    double dx = s2->getX() - s1->getX(), dy = s2->getY() - s1->getY();
+    double dth = mod2pi(s2->getYaw() - s1->getYaw());
+    return std::max(sqrt(dx * dx + dy * dy), rho_ * std::min(dth, twopi - dth));
+}
+
+void ompl::base::DubinsStateSpace::batchDistance(const State *state, const std::vector<const State *> &states,
+                                                 std::vector<double> &distances, double maxDistance) const
+{
+    const auto *s1 = static_cast<const StateType *>(state);
+    double x1 = s1->getX(), y1 = s1->getY(), th1 = s1->getYaw();
+    const bool prune = maxDistance < std::numeric_limits<double>::infinity();
+
+    distances.resize(states.size());
+    for (std::size_t i = 0; i < states.size(); ++i)
+    {
+        if (prune && distanceLowerBound(state, states[i]) > maxDistance)
+        {
+            distances[i] = std::numeric_limits<double>::infinity();
+            continue;
+        }
+
+        if (isSymmetric_)
+        {
+            distances[i] = distance(state, states[i]);
+            continue;
+        }
+
+        const auto *s2 = static_cast<const StateType *>(states[i]);
+        double dx = s2->getX() - x1, dy = s2->getY() - y1, d = sqrt(dx * dx + dy * dy) / rho_, th = atan2(dy, dx);
+        double alpha = mod2pi(th1 - th), beta = mod2pi(s2->getYaw() - th);
+        distances[i] = rho_ * ::dubins(d, alpha, beta).length();
+    }
 }
 
 void ompl::base::DubinsMotionValidator::defaultSettings()
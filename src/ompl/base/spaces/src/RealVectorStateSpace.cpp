@@ -52,6 +52,28 @@ void ompl::base::RealVectorStateSampler::sampleUniform(State *state)
         rstate->values[i] = rng_.uniformReal(bounds.low[i], bounds.high[i]);
 }
 
+void ompl::base::RealVectorStateSampler::sampleUniformBatch(State **states, std::size_t n)
+{
+    if (!batchSampling_)
+    {
+        StateSampler::sampleUniformBatch(states, n);
+        return;
+    }
+
+    const unsigned int dim = space_->getDimension();
+    const RealVectorBounds &bounds = static_cast<const RealVectorStateSpace *>(space_)->getBounds();
+
+    std::vector<double> values(n * dim);
+    rng_.uniform01(values.data(), values.size());
+    for (std::size_t j = 0; j < n; ++j)
+    {
+        auto *rstate = static_cast<RealVectorStateSpace::StateType *>(states[j]);
+        const double *v = &values[j * dim];
+        for (unsigned int i = 0; i < dim; ++i)
+            rstate->values[i] = (bounds.high[i] - bounds.low[i]) * v[i] + bounds.low[i];
+    }
+}
+
 void ompl::base::RealVectorStateSampler::sampleUniformNear(State *state, const State *near, const double distance)
 {
     const unsigned int dim = space_->getDimension();
@@ -266,7 +288,9 @@ void ompl::base::RealVectorStateSpace::interpolate(const State *from, const Stat
 
 ompl::base::StateSamplerPtr ompl::base::RealVectorStateSpace::allocDefaultStateSampler() const
 {
-    return std::make_shared<RealVectorStateSampler>(this);
+    auto sampler(std::make_shared<RealVectorStateSampler>(this));
+    sampler->setBatchSampling(true);
+    return sampler;
 }
 
 ompl::base::State *ompl::base::RealVectorStateSpace::allocState() const
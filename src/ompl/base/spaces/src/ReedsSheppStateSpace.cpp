@@ -37,6 +37,11 @@
 #include "ompl/base/spaces/ReedsSheppStateSpace.h"
 #include "ompl/base/SpaceInformation.h"
 #include "ompl/util/Exception.h"
+#include "ompl/util/Console.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <fstream>
 #include <queue>
 #include <boost/math/constants/constants.hpp>
 
@@ -476,6 +481,36 @@ namespace
         CCSCC(x, y, phi, path);
         return path;
     }
+
+    // Direct-mapped cache of recently computed paths, keyed by the relative pose
+    // (which is all the optimal path depends on).
+    const std::size_t PATH_CACHE_SIZE = 64;
+    struct CachedPath
+    {
+        double x, y, phi;
+        ReedsSheppStateSpace::ReedsSheppPath path;
+        bool used{false};
+    };
+    thread_local std::array<CachedPath, PATH_CACHE_SIZE> pathCache;
+
+    const ReedsSheppStateSpace::ReedsSheppPath &cachedReedsShepp(double x, double y, double phi)
+    {
+        std::hash<double> hasher;
+        std::size_t h = hasher(x);
+        h ^= hasher(y) + 0x9e3779b9 + (h << 6) + (h >> 2);
+        h ^= hasher(phi) + 0x9e3779b9 + (h << 6) + (h >> 2);
+
+        CachedPath &entry = pathCache[h % PATH_CACHE_SIZE];
+        if (!entry.used || entry.x != x || entry.y != y || entry.phi != phi)
+        {
+            entry.x = x;
+            entry.y = y;
+            entry.phi = phi;
+            entry.path = reedsShepp(x, y, phi);
+            entry.used = true;
+        }
+        return entry.path;
+    }
 }
 
 const ompl::base::ReedsSheppStateSpace::ReedsSheppPathSegmentType
@@ -514,6 +549,16 @@ ompl::base::ReedsSheppStateSpace::ReedsSheppPath::ReedsSheppPath(const ReedsShep
 
 double ompl::base::ReedsSheppStateSpace::distance(const State *state1, const State *state2) const
 {
+    if (distanceTable_)
+    {
+        const auto *s1 = static_cast<const StateType *>(state1);
+        const auto *s2 = static_cast<const StateType *>(state2);
+        double dx = s2->getX() - s1->getX(), dy = s2->getY() - s1->getY();
+        double c = cos(s1->getYaw()), s = sin(s1->getYaw()), length;
+        if (lookupDistance((c * dx + s * dy) / rho_, (-s * dx + c * dy) / rho_,
+                           mod2pi(s2->getYaw() - s1->getYaw()), length))
+            return rho_ * length;
+    }
     return rho_ * reedsShepp(state1, state2).length();
 }
 
@@ -602,7 +647,38 @@ ompl::base::ReedsSheppStateSpace::ReedsSheppPath ompl::base::ReedsSheppStateSpac
     double x2 = s2->getX(), y2 = s2->getY(), th2 = s2->getYaw();
     double dx = x2 - x1, dy = y2 - y1, c = cos(th1), s = sin(th1);
     double x = c * dx + s * dy, y = -s * dx + c * dy, phi = th2 - th1;
-    return ::reedsShepp(x / rho_, y / rho_, phi);
+    return cachedReedsShepp(x / rho_, y / rho_, phi);
+}
+
+double ompl::base::ReedsSheppStateSpace::distanceLowerBound(const State *state1, const State *state2) const
+{
+    const auto *s1 = static_cast<const StateType *>(state1);
+    const auto *s2 = static_cast<const StateType *>(state2);
+    double dx = s2->getX() - s1->getX(), dy = s2->getY() - s1->getY();
+    return std::max(sqrt(dx * dx + dy * dy), rho_ * fabs(mod2pi(s2->getYaw() - s1->getYaw())));
+}
+
+void ompl::base::ReedsSheppStateSpace::batchDistance(const State *state, const std::vector<const State *> &states,
+                                                     std::vector<double> &distances, double maxDistance) const
+{
+    const auto *s1 = static_cast<const StateType *>(state);
+    double x1 = s1->getX(), y1 = s1->getY(), th1 = s1->getYaw(), c = cos(th1), s = sin(th1);
+    const bool prune = maxDistance < std::numeric_limits<double>::infinity();
+
+    distances.resize(states.size());
+    for (std::size_t i = 0; i < states.size(); ++i)
+    {
+        if (prune && distanceLowerBound(state, states[i]) > maxDistance)
+        {
+            distances[i] = std::numeric_limits<double>::infinity();
+            continue;
+        }
+
+        const auto *s2 = static_cast<const StateType *>(states[i]);
+        double dx = s2->getX() - x1, dy = s2->getY() - y1;
+        double x = c * dx + s * dy, y = -s * dx + c * dy, phi = s2->getYaw() - th1;
+        distances[i] = rho_ * ::reedsShepp(x / rho_, y / rho_, phi).length();
+    }
 }
 
 void ompl::base::ReedsSheppMotionValidator::defaultSettings()
@@ -709,3 +785,153 @@ bool ompl::base::ReedsSheppMotionValidator::checkMotion(const State *s1, const S
 
     return result;
 }
+
+namespace
+{
+    const char DISTANCE_TABLE_MAGIC[8] = {'O', 'M', 'P', 'L', 'R', 'S', 'D', 'T'};
+    // Version 2 estimates the interpolation error more conservatively
+    const std::uint32_t DISTANCE_TABLE_VERSION = 2;
+
+    // Trilinear interpolation of the corners of a cell, ordered with the x offset slowest and
+    // the heading offset fastest.
+    double interpolateCell(const float *corners, double fx, double fy, double ft)
+    {
+        const double c00 = corners[0] + ft * (corners[1] - corners[0]);
+        const double c01 = corners[2] + ft * (corners[3] - corners[2]);
+        const double c10 = corners[4] + ft * (corners[5] - corners[4]);
+        const double c11 = corners[6] + ft * (corners[7] - corners[6]);
+        const double c0 = c00 + fy * (c01 - c00);
+        const double c1 = c10 + fy * (c11 - c10);
+        return c0 + fx * (c1 - c0);
+    }
+
+    void gatherCell(const float *base, std::size_t strideX, std::size_t strideY, float *corners)
+    {
+        corners[0] = base[0];
+        corners[1] = base[1];
+        corners[2] = base[strideY];
+        corners[3] = base[strideY + 1];
+        corners[4] = base[strideX];
+        corners[5] = base[strideX + 1];
+        corners[6] = base[strideX + strideY];
+        corners[7] = base[strideX + strideY + 1];
+    }
+}
+
+bool ompl::base::ReedsSheppStateSpace::generateDistanceTable(const std::string &filename, double extent,
+                                                             unsigned int cellsXY, unsigned int cellsTheta)
+{
+    if (extent <= 0. || cellsXY == 0 || cellsTheta == 0)
+        throw Exception("ReedsSheppStateSpace::generateDistanceTable(): invalid table dimensions");
+
+    const double stepXY = 2. * extent / cellsXY, stepTheta = twopi / cellsTheta;
+    const std::size_t strideY = cellsTheta + 1, strideX = strideY * (cellsXY + 1);
+
+    // Path lengths at the grid points
+    std::vector<float> lengths(strideX * (cellsXY + 1));
+    for (unsigned int i = 0; i <= cellsXY; ++i)
+        for (unsigned int j = 0; j <= cellsXY; ++j)
+            for (unsigned int k = 0; k <= cellsTheta; ++k)
+                lengths[i * strideX + j * strideY + k] =
+                    ::reedsShepp(-extent + i * stepXY, -extent + j * stepXY, -pi + k * stepTheta).length();
+
+    // Interpolation error of each cell, estimated at the centers of its 3 x 3 x 3 subcells. The maximum error
+    // within a cell is usually somewhat larger than at these points, so a margin is added.
+    std::vector<float> errors(std::size_t(cellsXY) * cellsXY * cellsTheta);
+    const double offsets[3] = {1. / 6., 0.5, 5. / 6.};
+    const double margin = 1.5;
+    float corners[8];
+    for (unsigned int i = 0; i < cellsXY; ++i)
+        for (unsigned int j = 0; j < cellsXY; ++j)
+            for (unsigned int k = 0; k < cellsTheta; ++k)
+            {
+                gatherCell(lengths.data() + i * strideX + j * strideY + k, strideX, strideY, corners);
+                double error = 0.;
+                for (unsigned int p = 0; p < 27; ++p)
+                {
+                    const double fx = offsets[p / 9], fy = offsets[(p / 3) % 3], ft = offsets[p % 3];
+                    const double exact = ::reedsShepp(-extent + (i + fx) * stepXY, -extent + (j + fy) * stepXY,
+                                                      -pi + (k + ft) * stepTheta)
+                                             .length();
+                    error = std::max(error, std::abs(exact - interpolateCell(corners, fx, fy, ft)));
+                }
+                errors[(std::size_t(i) * cellsXY + j) * cellsTheta + k] = margin * error;
+            }
+
+    std::ofstream out(filename.c_str(), std::ios::binary);
+    if (!out.good())
+    {
+        OMPL_ERROR("Unable to open '%s' for writing the Reeds-Shepp distance table", filename.c_str());
+        return false;
+    }
+
+    const std::uint32_t header[3] = {DISTANCE_TABLE_VERSION, cellsXY, cellsTheta};
+    out.write(DISTANCE_TABLE_MAGIC, sizeof(DISTANCE_TABLE_MAGIC));
+    out.write(reinterpret_cast<const char *>(header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(&extent), sizeof(extent));
+    out.write(reinterpret_cast<const char *>(lengths.data()), lengths.size() * sizeof(float));
+    out.write(reinterpret_cast<const char *>(errors.data()), errors.size() * sizeof(float));
+    return out.good();
+}
+
+bool ompl::base::ReedsSheppStateSpace::loadDistanceTable(const std::string &filename, double tolerance)
+{
+    distanceTable_.reset();
+
+    std::ifstream in(filename.c_str(), std::ios::binary);
+    char magic[sizeof(DISTANCE_TABLE_MAGIC)];
+    std::uint32_t header[3];
+    auto table = std::make_shared<DistanceTable>();
+
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char *>(header), sizeof(header));
+    in.read(reinterpret_cast<char *>(&table->extent), sizeof(table->extent));
+    if (!in.good() || !std::equal(magic, magic + sizeof(magic), DISTANCE_TABLE_MAGIC) ||
+        header[0] != DISTANCE_TABLE_VERSION || header[1] == 0 || header[2] == 0 || !(table->extent > 0.))
+    {
+        OMPL_ERROR("'%s' is not a Reeds-Shepp distance table", filename.c_str());
+        return false;
+    }
+
+    table->cellsXY = header[1];
+    table->cellsTheta = header[2];
+    table->tolerance = tolerance;
+    table->lengths.resize(std::size_t(table->cellsXY + 1) * (table->cellsXY + 1) * (table->cellsTheta + 1));
+    table->errors.resize(std::size_t(table->cellsXY) * table->cellsXY * table->cellsTheta);
+    in.read(reinterpret_cast<char *>(table->lengths.data()), table->lengths.size() * sizeof(float));
+    in.read(reinterpret_cast<char *>(table->errors.data()), table->errors.size() * sizeof(float));
+    if (!in.good())
+    {
+        OMPL_ERROR("Reeds-Shepp distance table '%s' is truncated", filename.c_str());
+        return false;
+    }
+
+    distanceTable_ = table;
+    return true;
+}
+
+bool ompl::base::ReedsSheppStateSpace::lookupDistance(double x, double y, double phi, double &length) const
+{
+    const DistanceTable &table = *distanceTable_;
+
+    // Continuous grid coordinates
+    const double gx = (x + table.extent) * table.cellsXY / (2. * table.extent);
+    const double gy = (y + table.extent) * table.cellsXY / (2. * table.extent);
+    const double gt = (phi + pi) * table.cellsTheta / twopi;
+    if (!(gx >= 0. && gx < table.cellsXY && gy >= 0. && gy < table.cellsXY && gt >= 0.))
+        return false;
+
+    const auto i = (std::size_t)gx, j = (std::size_t)gy;
+    const auto k = std::min((std::size_t)gt, (std::size_t)table.cellsTheta - 1);
+
+    // Cells that interpolate poorly, such as those across a change of the optimal path type,
+    // are computed exactly
+    if (table.errors[(i * table.cellsXY + j) * table.cellsTheta + k] > table.tolerance)
+        return false;
+
+    const std::size_t strideY = table.cellsTheta + 1, strideX = strideY * (table.cellsXY + 1);
+    float corners[8];
+    gatherCell(table.lengths.data() + i * strideX + j * strideY + k, strideX, strideY, corners);
+    length = interpolateCell(corners, gx - i, gy - j, std::min(gt - k, 1.));
+    return true;
+}
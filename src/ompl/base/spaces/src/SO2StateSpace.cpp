@@ -49,6 +49,20 @@ void ompl::base::SO2StateSampler::sampleUniform(State *state)
         rng_.uniformReal(-pi, pi);
 }
 
+void ompl::base::SO2StateSampler::sampleUniformBatch(State **states, std::size_t n)
+{
+    if (!batchSampling_)
+    {
+        StateSampler::sampleUniformBatch(states, n);
+        return;
+    }
+
+    std::vector<double> values(n);
+    rng_.uniformReal(values.data(), n, -pi, pi);
+    for (std::size_t i = 0; i < n; ++i)
+        states[i]->as<SO2StateSpace::StateType>()->value = values[i];
+}
+
 void ompl::base::SO2StateSampler::sampleUniformNear(State *state, const State *near, const double distance)
 {
     state->as<SO2StateSpace::StateType>()->value = rng_.uniformReal(
@@ -156,7 +170,9 @@ void ompl::base::SO2StateSpace::interpolate(const State *from, const State *to,
 
 ompl::base::StateSamplerPtr ompl::base::SO2StateSpace::allocDefaultStateSampler() const
 {
-    return std::make_shared<SO2StateSampler>(this);
+    auto sampler(std::make_shared<SO2StateSampler>(this));
+    sampler->setBatchSampling(true);
+    return sampler;
 }
 
 ompl::base::State *ompl::base::SO2StateSpace::allocState() const
@@ -101,6 +101,30 @@ void ompl::base::SO3StateSampler::sampleUniform(State *state)
     rng_.quaternion(&state->as<SO3StateSpace::StateType>()->x);
 }
 
+// The same construction as RNG::quaternion(), from "Uniform Random Rotations", Ken Shoemake, Graphics Gems III
+void ompl::base::SO3StateSampler::sampleUniformBatch(State **states, std::size_t n)
+{
+    if (!batchSampling_)
+    {
+        StateSampler::sampleUniformBatch(states, n);
+        return;
+    }
+
+    std::vector<double> values(3 * n);
+    rng_.uniform01(values.data(), values.size());
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const double *v = &values[3 * i];
+        double r1 = sqrt(1.0 - v[0]), r2 = sqrt(v[0]);
+        double t1 = 2.0 * pi * v[1], t2 = 2.0 * pi * v[2];
+        auto *q = states[i]->as<SO3StateSpace::StateType>();
+        q->x = sin(t1) * r1;
+        q->y = cos(t1) * r1;
+        q->z = sin(t2) * r2;
+        q->w = cos(t2) * r2;
+    }
+}
+
 void ompl::base::SO3StateSampler::sampleUniformNear(State *state, const State *near, const double distance)
 {
     if (distance >= .25 * pi)
@@ -319,7 +343,9 @@ void ompl::base::SO3StateSpace::interpolate(const State *from, const State *to,
 
 ompl::base::StateSamplerPtr ompl::base::SO3StateSpace::allocDefaultStateSampler() const
 {
-    return std::make_shared<SO3StateSampler>(this);
+    auto sampler(std::make_shared<SO3StateSampler>(this));
+    sampler->setBatchSampling(true);
+    return sampler;
 }
 
 ompl::base::State *ompl::base::SO3StateSpace::allocState() const
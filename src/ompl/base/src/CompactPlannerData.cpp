@@ -0,0 +1,449 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2026, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+
+#include "ompl/base/CompactPlannerData.h"
+#include "ompl/base/PlannerData.h"
+#include "ompl/base/OptimizationObjective.h"
+#include "ompl/base/objectives/PathLengthOptimizationObjective.h"
+#include "ompl/base/ScopedState.h"
+#include <algorithm>
+#include <limits>
+#include <queue>
+#include <sstream>
+
+const unsigned int ompl::base::CompactPlannerData::INVALID_INDEX = std::numeric_limits<unsigned int>::max();
+
+ompl::base::CompactPlannerData::CompactPlannerData(SpaceInformationPtr si) : si_(std::move(si))
+{
+}
+
+ompl::base::CompactPlannerData::~CompactPlannerData()
+{
+    clear();
+}
+
+void ompl::base::CompactPlannerData::reserve(unsigned int vertices, unsigned int edges)
+{
+    states_.reserve(vertices);
+    tags_.reserve(vertices);
+    flags_.reserve(vertices);
+    pendingSources_.reserve(edges);
+    pendingTargets_.reserve(edges);
+    pendingWeights_.reserve(edges);
+}
+
+unsigned int ompl::base::CompactPlannerData::addVertex(const State *state, int tag)
+{
+    states_.push_back(state);
+    tags_.push_back(tag);
+    flags_.push_back(0);
+    stateIndex_.clear();
+    return states_.size() - 1;
+}
+
+unsigned int ompl::base::CompactPlannerData::addStartVertex(const State *state, int tag)
+{
+    unsigned int index = addVertex(state, tag);
+    markStartVertex(index);
+    return index;
+}
+
+unsigned int ompl::base::CompactPlannerData::addGoalVertex(const State *state, int tag)
+{
+    unsigned int index = addVertex(state, tag);
+    markGoalVertex(index);
+    return index;
+}
+
+bool ompl::base::CompactPlannerData::addEdge(unsigned int v1, unsigned int v2, Cost weight)
+{
+    if (v1 >= numVertices() || v2 >= numVertices())
+        return false;
+    pendingSources_.push_back(v1);
+    pendingTargets_.push_back(v2);
+    pendingWeights_.push_back(weight.value());
+    return true;
+}
+
+void ompl::base::CompactPlannerData::markStartVertex(unsigned int index)
+{
+    flags_[index] |= START;
+}
+
+void ompl::base::CompactPlannerData::markGoalVertex(unsigned int index)
+{
+    flags_[index] |= GOAL;
+}
+
+void ompl::base::CompactPlannerData::setTag(unsigned int index, int tag)
+{
+    tags_[index] = tag;
+}
+
+void ompl::base::CompactPlannerData::clear()
+{
+    for (unsigned int i = 0; i < decoupledCount_; ++i)
+        si_->freeState(const_cast<State *>(states_[i]));
+    decoupledCount_ = 0;
+
+    states_.clear();
+    tags_.clear();
+    flags_.clear();
+    offsets_.clear();
+    targets_.clear();
+    weights_.clear();
+    pendingSources_.clear();
+    pendingTargets_.clear();
+    pendingWeights_.clear();
+    stateIndex_.clear();
+    properties.clear();
+}
+
+void ompl::base::CompactPlannerData::decoupleFromPlanner()
+{
+    // Vertices are only ever appended, so the decoupled ones are a prefix
+    for (; decoupledCount_ < states_.size(); ++decoupledCount_)
+        states_[decoupledCount_] = si_->cloneState(states_[decoupledCount_]);
+    stateIndex_.clear();
+}
+
+unsigned int ompl::base::CompactPlannerData::numStartVertices() const
+{
+    return std::count_if(flags_.begin(), flags_.end(), [](unsigned char f) { return (f & START) != 0; });
+}
+
+unsigned int ompl::base::CompactPlannerData::numGoalVertices() const
+{
+    return std::count_if(flags_.begin(), flags_.end(), [](unsigned char f) { return (f & GOAL) != 0; });
+}
+
+unsigned int ompl::base::CompactPlannerData::getStartIndex(unsigned int i) const
+{
+    for (unsigned int v = 0; v < flags_.size(); ++v)
+        if ((flags_[v] & START) != 0 && i-- == 0)
+            return v;
+    return INVALID_INDEX;
+}
+
+unsigned int ompl::base::CompactPlannerData::getGoalIndex(unsigned int i) const
+{
+    for (unsigned int v = 0; v < flags_.size(); ++v)
+        if ((flags_[v] & GOAL) != 0 && i-- == 0)
+            return v;
+    return INVALID_INDEX;
+}
+
+unsigned int ompl::base::CompactPlannerData::vertexIndex(const State *state) const
+{
+    if (stateIndex_.size() != states_.size())
+    {
+        stateIndex_.resize(states_.size());
+        for (unsigned int i = 0; i < states_.size(); ++i)
+            stateIndex_[i] = std::make_pair(states_[i], i);
+        std::sort(stateIndex_.begin(), stateIndex_.end());
+    }
+    auto it = std::lower_bound(stateIndex_.begin(), stateIndex_.end(), std::make_pair(state, 0u));
+    return it != stateIndex_.end() && it->first == state ? it->second : INVALID_INDEX;
+}
+
+void ompl::base::CompactPlannerData::arrangeRows() const
+{
+    const unsigned int n = numVertices();
+    if (pendingSources_.empty() && offsets_.size() == n + 1)
+        return;
+
+    // Count the edges of each row, keeping the rows arranged so far
+    std::vector<unsigned int> offsets(n + 1, 0u);
+    for (unsigned int v = 0; v + 1 < offsets_.size(); ++v)
+        offsets[v + 1] = offsets_[v + 1] - offsets_[v];
+    for (unsigned int source : pendingSources_)
+        ++offsets[source + 1];
+    for (unsigned int v = 0; v < n; ++v)
+        offsets[v + 1] += offsets[v];
+
+    // Place the arranged edges first and the pending ones after them, in the order they were added
+    std::vector<unsigned int> targets(offsets[n]);
+    std::vector<float> weights(offsets[n]);
+    std::vector<unsigned int> next(offsets.begin(), offsets.end() - 1);
+    for (unsigned int v = 0; v + 1 < offsets_.size(); ++v)
+        for (unsigned int k = offsets_[v]; k < offsets_[v + 1]; ++k)
+        {
+            targets[next[v]] = targets_[k];
+            weights[next[v]++] = weights_[k];
+        }
+    for (std::size_t i = 0; i < pendingSources_.size(); ++i)
+    {
+        unsigned int &position = next[pendingSources_[i]];
+        targets[position] = pendingTargets_[i];
+        weights[position++] = pendingWeights_[i];
+    }
+
+    offsets_.swap(offsets);
+    targets_.swap(targets);
+    weights_.swap(weights);
+    std::vector<unsigned int>().swap(pendingSources_);
+    std::vector<unsigned int>().swap(pendingTargets_);
+    std::vector<float>().swap(pendingWeights_);
+}
+
+unsigned int ompl::base::CompactPlannerData::findEdge(unsigned int v1, unsigned int v2) const
+{
+    if (v1 >= numVertices())
+        return INVALID_INDEX;
+    arrangeRows();
+    for (unsigned int k = offsets_[v1]; k < offsets_[v1 + 1]; ++k)
+        if (targets_[k] == v2)
+            return k;
+    return INVALID_INDEX;
+}
+
+unsigned int ompl::base::CompactPlannerData::getEdges(unsigned int v, const unsigned int *&targets,
+                                                      const float *&weights) const
+{
+    arrangeRows();
+    targets = targets_.data() + offsets_[v];
+    weights = weights_.data() + offsets_[v];
+    return offsets_[v + 1] - offsets_[v];
+}
+
+unsigned int ompl::base::CompactPlannerData::getEdges(unsigned int v, std::vector<unsigned int> &edgeList) const
+{
+    arrangeRows();
+    edgeList.assign(targets_.begin() + offsets_[v], targets_.begin() + offsets_[v + 1]);
+    return edgeList.size();
+}
+
+bool ompl::base::CompactPlannerData::edgeExists(unsigned int v1, unsigned int v2) const
+{
+    return findEdge(v1, v2) != INVALID_INDEX;
+}
+
+bool ompl::base::CompactPlannerData::getEdgeWeight(unsigned int v1, unsigned int v2, Cost *weight) const
+{
+    unsigned int k = findEdge(v1, v2);
+    if (k == INVALID_INDEX)
+        return false;
+    *weight = Cost(weights_[k]);
+    return true;
+}
+
+bool ompl::base::CompactPlannerData::setEdgeWeight(unsigned int v1, unsigned int v2, Cost weight)
+{
+    unsigned int k = findEdge(v1, v2);
+    if (k == INVALID_INDEX)
+        return false;
+    weights_[k] = weight.value();
+    return true;
+}
+
+void ompl::base::CompactPlannerData::computeEdgeWeights(const OptimizationObjective &opt)
+{
+    arrangeRows();
+    for (unsigned int v = 0; v < numVertices(); ++v)
+        for (unsigned int k = offsets_[v]; k < offsets_[v + 1]; ++k)
+            weights_[k] = opt.motionCost(states_[v], states_[targets_[k]]).value();
+}
+
+void ompl::base::CompactPlannerData::computeEdgeWeights()
+{
+    // Create a PathLengthOptimizationObjective to compute the edge
+    // weights according to state space distance
+    PathLengthOptimizationObjective opt(si_);
+    computeEdgeWeights(opt);
+}
+
+void ompl::base::CompactPlannerData::fromPlannerData(const PlannerData &pd)
+{
+    clear();
+    const unsigned int n = pd.numVertices();
+    reserve(n, pd.numEdges());
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        const PlannerDataVertex &v = pd.getVertex(i);
+        addVertex(v.getState(), v.getTag());
+        if (pd.isStartVertex(i))
+            markStartVertex(i);
+        if (pd.isGoalVertex(i))
+            markGoalVertex(i);
+    }
+
+    std::vector<unsigned int> edgeList;
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        pd.getEdges(i, edgeList);
+        for (unsigned int j : edgeList)
+        {
+            Cost weight;
+            pd.getEdgeWeight(i, j, &weight);
+            addEdge(i, j, weight);
+        }
+    }
+    properties = pd.properties;
+}
+
+void ompl::base::CompactPlannerData::toPlannerData(PlannerData &pd) const
+{
+    // A state that is already in pd keeps its vertex there, so the indexes are not necessarily consecutive
+    std::vector<unsigned int> index(numVertices());
+    for (unsigned int i = 0; i < numVertices(); ++i)
+    {
+        index[i] = pd.addVertex(PlannerDataVertex(states_[i], tags_[i]));
+        // A vertex can be both a start and a goal
+        if (isStartVertex(i))
+            pd.markStartState(states_[i]);
+        if (isGoalVertex(i))
+            pd.markGoalState(states_[i]);
+    }
+
+    arrangeRows();
+    for (unsigned int v = 0; v < numVertices(); ++v)
+        for (unsigned int k = offsets_[v]; k < offsets_[v + 1]; ++k)
+            pd.addEdge(index[v], index[targets_[k]], PlannerDataEdge(), Cost(weights_[k]));
+
+    for (const auto &property : properties)
+        pd.properties[property.first] = property.second;
+}
+
+void ompl::base::CompactPlannerData::printGraphML(std::ostream &out) const
+{
+    // The same layout boost::write_graphml() produces for PlannerData::printGraphML()
+    out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        << "<graphml xmlns=\"http://graphml.graphdrawing.org/xmlns\" "
+           "xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\" "
+           "xsi:schemaLocation=\"http://graphml.graphdrawing.org/xmlns "
+           "http://graphml.graphdrawing.org/xmlns/1.0/graphml.xsd\">\n"
+        << "  <key id=\"key0\" for=\"node\" attr.name=\"coords\" attr.type=\"string\" />\n"
+        << "  <key id=\"key1\" for=\"edge\" attr.name=\"weight\" attr.type=\"double\" />\n"
+        << "  <graph id=\"G\" edgedefault=\"directed\" parse.nodeids=\"free\" parse.edgeids=\"canonical\" "
+           "parse.order=\"nodesfirst\">\n";
+
+    ScopedState<> s(si_);
+    std::ostringstream sstream;
+    for (unsigned int v = 0; v < numVertices(); ++v)
+    {
+        s = *states_[v];
+        std::vector<double> coords(s.reals());
+        sstream.str("");
+        if (!coords.empty())
+        {
+            sstream << coords[0];
+            for (std::size_t i = 1; i < coords.size(); ++i)
+                sstream << ',' << coords[i];
+        }
+        out << "    <node id=\"n" << v << "\">\n"
+            << "      <data key=\"key0\">" << sstream.str() << "</data>\n"
+            << "    </node>\n";
+    }
+
+    arrangeRows();
+    unsigned int edge = 0;
+    for (unsigned int v = 0; v < numVertices(); ++v)
+        for (unsigned int k = offsets_[v]; k < offsets_[v + 1]; ++k)
+        {
+            sstream.str("");
+            sstream << static_cast<double>(weights_[k]);
+            out << "    <edge id=\"e" << edge++ << "\" source=\"n" << v << "\" target=\"n" << targets_[k] << "\">\n"
+                << "      <data key=\"key1\">" << sstream.str() << "</data>\n"
+                << "    </edge>\n";
+        }
+
+    out << "  </graph>\n"
+        << "</graphml>\n";
+}
+
+void ompl::base::CompactPlannerData::extractMinimumSpanningTree(unsigned int v, const OptimizationObjective &opt,
+                                                                CompactPlannerData &mst) const
+{
+    // Prim's algorithm, with a lazy priority queue of (edge cost, vertex, predecessor)
+    const unsigned int n = numVertices();
+    std::vector<unsigned int> pred(n, INVALID_INDEX);
+    std::vector<Cost> best(n, opt.infiniteCost());
+    std::vector<bool> inTree(n, false);
+
+    using Entry = std::pair<Cost, std::pair<unsigned int, unsigned int>>;
+    auto worse = [&opt](const Entry &a, const Entry &b)
+    {
+        return opt.isCostBetterThan(b.first, a.first);
+    };
+    std::priority_queue<Entry, std::vector<Entry>, decltype(worse)> queue(worse);
+
+    arrangeRows();
+    if (v < n)
+    {
+        best[v] = opt.identityCost();
+        queue.push(std::make_pair(best[v], std::make_pair(v, v)));
+    }
+    while (!queue.empty())
+    {
+        const unsigned int u = queue.top().second.first;
+        const unsigned int p = queue.top().second.second;
+        queue.pop();
+        if (inTree[u])
+            continue;
+        inTree[u] = true;
+        pred[u] = p;
+        for (unsigned int k = offsets_[u]; k < offsets_[u + 1]; ++k)
+        {
+            const unsigned int w = targets_[k];
+            Cost c(weights_[k]);
+            if (!inTree[w] && opt.isCostBetterThan(c, best[w]))
+            {
+                best[w] = c;
+                queue.push(std::make_pair(c, std::make_pair(w, u)));
+            }
+        }
+    }
+
+    mst.clear();
+    mst.reserve(n, n);
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        mst.addVertex(states_[i], tags_[i]);
+        mst.flags_[i] = flags_[i];
+    }
+    for (unsigned int i = 0; i < n; ++i)
+        if (pred[i] != INVALID_INDEX && pred[i] != i)
+            mst.addEdge(pred[i], i, best[i]);
+}
+
+std::size_t ompl::base::CompactPlannerData::getMemoryUsage() const
+{
+    return states_.capacity() * sizeof(const State *) + tags_.capacity() * sizeof(int) +
+           flags_.capacity() * sizeof(unsigned char) + offsets_.capacity() * sizeof(unsigned int) +
+           targets_.capacity() * sizeof(unsigned int) + weights_.capacity() * sizeof(float) +
+           pendingSources_.capacity() * sizeof(unsigned int) + pendingTargets_.capacity() * sizeof(unsigned int) +
+           pendingWeights_.capacity() * sizeof(float) +
+           stateIndex_.capacity() * sizeof(std::pair<const State *, unsigned int>);
+}
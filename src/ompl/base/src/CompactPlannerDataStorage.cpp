@@ -0,0 +1,345 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2026, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+
+#include "ompl/base/CompactPlannerDataStorage.h"
+#include "ompl/util/Console.h"
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+namespace
+{
+    const std::uint32_t COMPACT_PLANNER_DATA_MARKER = 0x43504453;  // this spells CPDS
+    const std::uint32_t COMPACT_PLANNER_DATA_VERSION = 1;
+
+    template <typename T>
+    void writeValue(std::ostream &out, const T &value)
+    {
+        out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    void writeArray(std::ostream &out, const std::vector<T> &values)
+    {
+        out.write(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(T));
+    }
+
+    /// Reads values from the loaded content of a file, checking that they are within it
+    class Reader
+    {
+    public:
+        Reader(const std::vector<char> &buffer)
+          : begin_(buffer.data()), position_(buffer.data()), end_(buffer.data() + buffer.size())
+        {
+        }
+
+        /// Return the number of bytes read so far
+        std::size_t offset() const
+        {
+            return position_ - begin_;
+        }
+
+        bool done() const
+        {
+            return position_ == end_;
+        }
+
+        bool available(std::size_t bytes) const
+        {
+            return bytes <= static_cast<std::size_t>(end_ - position_);
+        }
+
+        template <typename T>
+        bool read(T &value)
+        {
+            if (!available(sizeof(T)))
+                return false;
+            std::memcpy(&value, position_, sizeof(T));
+            position_ += sizeof(T);
+            return true;
+        }
+
+        /// Return the position of the next \e bytes bytes and skip them
+        const char *skip(std::size_t bytes)
+        {
+            const char *block = position_;
+            position_ += bytes;
+            return block;
+        }
+
+    private:
+        const char *begin_;
+        const char *position_;
+        const char *end_;
+    };
+}
+
+bool ompl::base::CompactPlannerDataStorage::store(const CompactPlannerData &data, const char *filename)
+{
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    return store(data, out);
+}
+
+bool ompl::base::CompactPlannerDataStorage::store(const CompactPlannerData &data, std::ostream &out)
+{
+    if (!out.good())
+    {
+        OMPL_ERROR("Failed to store CompactPlannerData: output stream is invalid");
+        return false;
+    }
+    storeHeader(data, out);
+    storeSegment(data, 0, out);
+    out.flush();
+    if (!out.good())
+    {
+        OMPL_ERROR("Failed to store CompactPlannerData: write error");
+        return false;
+    }
+    return true;
+}
+
+bool ompl::base::CompactPlannerDataStorage::append(const CompactPlannerData &data, unsigned int fromVertex,
+                                                   const char *filename)
+{
+    // Opening for reading as well fails instead of creating a file without a header
+    std::fstream out(filename, std::ios::binary | std::ios::in | std::ios::out);
+    if (!out.good())
+    {
+        OMPL_ERROR("Failed to append CompactPlannerData: cannot open '%s'", filename);
+        return false;
+    }
+    out.seekp(0, std::ios::end);
+    return append(data, fromVertex, out);
+}
+
+bool ompl::base::CompactPlannerDataStorage::append(const CompactPlannerData &data, unsigned int fromVertex,
+                                                   std::ostream &out)
+{
+    storeSegment(data, fromVertex, out);
+    out.flush();
+    if (!out.good())
+    {
+        OMPL_ERROR("Failed to append CompactPlannerData: write error");
+        return false;
+    }
+    return true;
+}
+
+void ompl::base::CompactPlannerDataStorage::storeHeader(const CompactPlannerData &data, std::ostream &out) const
+{
+    const StateSpacePtr &space = data.getSpaceInformation()->getStateSpace();
+    std::vector<int> signature;
+    space->computeSignature(signature);
+
+    writeValue(out, COMPACT_PLANNER_DATA_MARKER);
+    writeValue(out, COMPACT_PLANNER_DATA_VERSION);
+    writeValue<std::uint32_t>(out, space->getSerializationLength());
+    writeValue<std::uint32_t>(out, signature.size());
+    writeArray(out, signature);
+}
+
+void ompl::base::CompactPlannerDataStorage::storeSegment(const CompactPlannerData &data, unsigned int fromVertex,
+                                                         std::ostream &out) const
+{
+    const StateSpacePtr &space = data.getSpaceInformation()->getStateSpace();
+    const unsigned int length = space->getSerializationLength();
+    const unsigned int count = fromVertex < data.numVertices() ? data.numVertices() - fromVertex : 0;
+
+    std::vector<char> states(static_cast<std::size_t>(count) * length);
+    std::vector<int> tags(count);
+    std::vector<unsigned char> flags(count);
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        space->serialize(states.data() + static_cast<std::size_t>(i) * length, data.getState(fromVertex + i));
+        tags[i] = data.getTag(fromVertex + i);
+        flags[i] = data.flags_[fromVertex + i];
+    }
+
+    std::vector<std::uint32_t> sources, targets;
+    std::vector<float> weights;
+    for (unsigned int v = 0; v < data.numVertices(); ++v)
+    {
+        const unsigned int *rowTargets;
+        const float *rowWeights;
+        const unsigned int degree = data.getEdges(v, rowTargets, rowWeights);
+        for (unsigned int i = 0; i < degree; ++i)
+            if (v >= fromVertex || rowTargets[i] >= fromVertex)
+            {
+                sources.push_back(v);
+                targets.push_back(rowTargets[i]);
+                weights.push_back(rowWeights[i]);
+            }
+    }
+
+    writeValue<std::uint32_t>(out, fromVertex);
+    writeValue<std::uint32_t>(out, count);
+    writeValue<std::uint32_t>(out, sources.size());
+    writeArray(out, states);
+    writeArray(out, tags);
+    writeArray(out, flags);
+    writeArray(out, sources);
+    writeArray(out, targets);
+    writeArray(out, weights);
+}
+
+bool ompl::base::CompactPlannerDataStorage::load(const char *filename, CompactPlannerData &data)
+{
+    std::size_t completeBytes;
+    return load(filename, data, completeBytes);
+}
+
+bool ompl::base::CompactPlannerDataStorage::load(std::istream &in, CompactPlannerData &data)
+{
+    std::size_t completeBytes;
+    return load(in, data, completeBytes);
+}
+
+bool ompl::base::CompactPlannerDataStorage::load(const char *filename, CompactPlannerData &data,
+                                                 std::size_t &completeBytes)
+{
+    completeBytes = 0;
+    std::ifstream in(filename, std::ios::binary);
+    if (!in.good())
+    {
+        OMPL_ERROR("Failed to load CompactPlannerData: cannot open '%s'", filename);
+        return false;
+    }
+    return load(in, data, completeBytes);
+}
+
+bool ompl::base::CompactPlannerDataStorage::load(std::istream &in, CompactPlannerData &data,
+                                                 std::size_t &completeBytes)
+{
+    data.clear();
+    completeBytes = 0;
+
+    // Read everything at once; the states are deserialized straight from the buffer
+    std::vector<char> buffer;
+    const std::streampos begin = in.tellg();
+    if (begin != std::streampos(-1) && in.seekg(0, std::ios::end))
+    {
+        buffer.resize(static_cast<std::size_t>(in.tellg() - begin));
+        in.seekg(begin);
+        in.read(buffer.data(), buffer.size());
+    }
+    else
+    {
+        in.clear();
+        buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    if (in.bad())
+    {
+        OMPL_ERROR("Failed to load CompactPlannerData: read error");
+        return false;
+    }
+
+    const SpaceInformationPtr &si = data.getSpaceInformation();
+    const StateSpacePtr &space = si->getStateSpace();
+    Reader reader(buffer);
+    std::uint32_t marker, version, length, signatureSize;
+    if (!reader.read(marker) || marker != COMPACT_PLANNER_DATA_MARKER || !reader.read(version) ||
+        version != COMPACT_PLANNER_DATA_VERSION || !reader.read(length) || !reader.read(signatureSize) ||
+        !reader.available(static_cast<std::size_t>(signatureSize) * sizeof(int)))
+    {
+        OMPL_ERROR("Failed to load CompactPlannerData: not a CompactPlannerData file");
+        return false;
+    }
+    std::vector<int> signature(signatureSize), expected;
+    std::memcpy(signature.data(), reader.skip(signature.size() * sizeof(int)), signature.size() * sizeof(int));
+    space->computeSignature(expected);
+    if (signature != expected || length != space->getSerializationLength())
+    {
+        OMPL_ERROR("Failed to load CompactPlannerData: StateSpace signature mismatch");
+        return false;
+    }
+
+    completeBytes = reader.offset();
+    while (!reader.done())
+    {
+        std::uint32_t first, count, edges;
+        const std::size_t vertexBytes = length + sizeof(int) + sizeof(unsigned char);
+        const std::size_t edgeBytes = 2 * sizeof(std::uint32_t) + sizeof(float);
+        if (!reader.read(first) || !reader.read(count) || !reader.read(edges) ||
+            !reader.available(count * vertexBytes + edges * edgeBytes))
+        {
+            OMPL_WARN("Ignoring an incomplete segment at the end of the stored CompactPlannerData");
+            break;
+        }
+        if (first != data.numVertices())
+        {
+            OMPL_WARN("Ignoring stored CompactPlannerData segments starting at vertex %u after %u vertices", first,
+                      data.numVertices());
+            break;
+        }
+
+        const char *states = reader.skip(static_cast<std::size_t>(count) * length);
+        const char *tags = reader.skip(count * sizeof(int));
+        const char *flags = reader.skip(count * sizeof(unsigned char));
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            State *state = si->allocState();
+            space->deserialize(state, states + static_cast<std::size_t>(i) * length);
+            int tag;
+            std::memcpy(&tag, tags + i * sizeof(int), sizeof(int));
+            data.addVertex(state, tag);
+            data.flags_.back() = flags[i];
+        }
+        // All the states were allocated here
+        data.decoupledCount_ = data.numVertices();
+
+        const char *sources = reader.skip(edges * sizeof(std::uint32_t));
+        const char *targets = reader.skip(edges * sizeof(std::uint32_t));
+        const char *weights = reader.skip(edges * sizeof(float));
+        for (std::uint32_t i = 0; i < edges; ++i)
+        {
+            std::uint32_t source, target;
+            float weight;
+            std::memcpy(&source, sources + i * sizeof(std::uint32_t), sizeof(std::uint32_t));
+            std::memcpy(&target, targets + i * sizeof(std::uint32_t), sizeof(std::uint32_t));
+            std::memcpy(&weight, weights + i * sizeof(float), sizeof(float));
+            if (!data.addEdge(source, target, Cost(weight)))
+            {
+                OMPL_ERROR("Failed to load CompactPlannerData: edge from vertex %u to vertex %u is out of range",
+                           source, target);
+                data.clear();
+                return false;
+            }
+        }
+        completeBytes = reader.offset();
+    }
+    return true;
+}
@@ -37,6 +37,66 @@
 #include "ompl/base/Constraint.h"
 #include "ompl/base/spaces/constraint/ConstrainedStateSpace.h"
 
+#include <Eigen/SVD>
+
+namespace
+{
+    /** \brief Temporaries of Newton's method for constraints of arbitrary dimension. */
+    struct ProjectionWorkspace
+    {
+        Eigen::VectorXd f;
+        Eigen::MatrixXd j;
+        Eigen::JacobiSVD<Eigen::MatrixXd> svd;
+
+        /** \brief Set while a projection uses the workspace, in case a
+         * constraint function projects onto another constraint. */
+        bool inUse{false};
+    };
+
+    thread_local ProjectionWorkspace workspace;
+
+    /** \brief Marks a workspace as in use for its lifetime, so the workspace
+     * is released even if the constraint function throws. */
+    struct WorkspaceGuard
+    {
+        explicit WorkspaceGuard(ProjectionWorkspace &ws) : ws_(ws)
+        {
+            ws_.inUse = true;
+        }
+
+        ~WorkspaceGuard()
+        {
+            ws_.inUse = false;
+        }
+
+        ProjectionWorkspace &ws_;
+    };
+
+    /** \brief Newton's method with temporaries of fixed size \a K (co-dimension) by
+     * \a N (ambient dimension), which live on the stack. */
+    template <int K, int N>
+    bool projectFixed(const ompl::base::Constraint &constraint, Eigen::Ref<Eigen::VectorXd> x,
+                      double squaredTolerance, unsigned int maxIterations)
+    {
+        unsigned int iter = 0;
+        double norm = 0;
+        Eigen::Matrix<double, K, 1> f;
+        Eigen::Matrix<double, K, N> j;
+        // A single-row Jacobian is row-major, which has the same layout as a column-major one
+        Eigen::Map<Eigen::MatrixXd> jacobian(j.data(), K, N);
+
+        constraint.function(x, f);
+        while ((norm = f.squaredNorm()) > squaredTolerance && iter++ < maxIterations)
+        {
+            constraint.jacobian(x, jacobian);
+            x -= j.jacobiSvd(Eigen::ComputeFullU | Eigen::ComputeFullV).solve(f);
+            constraint.function(x, f);
+        }
+
+        return norm < squaredTolerance;
+    }
+}  // namespace
+
 void ompl::base::Constraint::function(const State *state, Eigen::Ref<Eigen::VectorXd> out) const
 {
     function(*state->as<ConstrainedStateSpace::StateType>(), out);
@@ -92,25 +152,117 @@ bool ompl::base::Constraint::project(State *state) const
 
 bool ompl::base::Constraint::project(Eigen::Ref<Eigen::VectorXd> x) const
 {
+    const double squaredTolerance = tolerance_ * tolerance_;
+
+    // Use fixed-size temporaries for small constraints
+    switch (getCoDimension())
+    {
+        case 1:
+            switch (n_)
+            {
+                case 2:
+                    return projectFixed<1, 2>(*this, x, squaredTolerance, maxIterations_);
+                case 3:
+                    return projectFixed<1, 3>(*this, x, squaredTolerance, maxIterations_);
+                case 4:
+                    return projectFixed<1, 4>(*this, x, squaredTolerance, maxIterations_);
+                case 5:
+                    return projectFixed<1, 5>(*this, x, squaredTolerance, maxIterations_);
+                case 6:
+                    return projectFixed<1, 6>(*this, x, squaredTolerance, maxIterations_);
+            }
+            break;
+        case 2:
+            switch (n_)
+            {
+                case 3:
+                    return projectFixed<2, 3>(*this, x, squaredTolerance, maxIterations_);
+                case 4:
+                    return projectFixed<2, 4>(*this, x, squaredTolerance, maxIterations_);
+                case 5:
+                    return projectFixed<2, 5>(*this, x, squaredTolerance, maxIterations_);
+                case 6:
+                    return projectFixed<2, 6>(*this, x, squaredTolerance, maxIterations_);
+            }
+            break;
+        case 3:
+            switch (n_)
+            {
+                case 4:
+                    return projectFixed<3, 4>(*this, x, squaredTolerance, maxIterations_);
+                case 5:
+                    return projectFixed<3, 5>(*this, x, squaredTolerance, maxIterations_);
+                case 6:
+                    return projectFixed<3, 6>(*this, x, squaredTolerance, maxIterations_);
+            }
+            break;
+    }
+
+    return projectDynamic(x);
+}
+
+bool ompl::base::Constraint::projectDynamic(Eigen::Ref<Eigen::VectorXd> x) const
+{
+    // Fall back to temporaries on the heap if the workspace of this thread is taken
+    ProjectionWorkspace local;
+    ProjectionWorkspace &ws = workspace.inUse ? local : workspace;
+    WorkspaceGuard guard(ws);
+
     // Newton's method
     unsigned int iter = 0;
     double norm = 0;
-    Eigen::VectorXd f(getCoDimension());
-    Eigen::MatrixXd j(getCoDimension(), n_);
+    ws.f.resize(getCoDimension());
+    ws.j.resize(getCoDimension(), n_);
 
     const double squaredTolerance = tolerance_ * tolerance_;
 
-    function(x, f);
-    while ((norm = f.squaredNorm()) > squaredTolerance && iter++ < maxIterations_)
+    function(x, ws.f);
+    while ((norm = ws.f.squaredNorm()) > squaredTolerance && iter++ < maxIterations_)
     {
-        jacobian(x, j);
-        x -= j.jacobiSvd(Eigen::ComputeThinU | Eigen::ComputeThinV).solve(f);
-        function(x, f);
+        jacobian(x, ws.j);
+        ws.svd.compute(ws.j, Eigen::ComputeThinU | Eigen::ComputeThinV);
+        x -= ws.svd.solve(ws.f);
+        function(x, ws.f);
     }
 
     return norm < squaredTolerance;
 }
 
+std::size_t ompl::base::Constraint::projectBatch(Eigen::Ref<Eigen::MatrixXd> xs, std::vector<bool> *projected) const
+{
+    if (projected != nullptr)
+        projected->resize(xs.cols());
+
+    std::size_t count = 0;
+    for (Eigen::Index i = 0; i < xs.cols(); ++i)
+    {
+        bool result = project(xs.col(i));
+        if (projected != nullptr)
+            (*projected)[i] = result;
+        if (result)
+            ++count;
+    }
+    return count;
+}
+
+std::size_t ompl::base::Constraint::projectBatch(const std::vector<State *> &states,
+                                                 std::vector<bool> *projected) const
+{
+    if (projected != nullptr)
+        projected->resize(states.size());
+
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < states.size(); ++i)
+    {
+        bool result = project(states[i]);
+        if (projected != nullptr)
+            (*projected)[i] = result;
+        if (result)
+            ++count;
+    }
+    return count;
+}
+
 double ompl::base::Constraint::distance(const State *state) const
 {
     return distance(*state->as<ConstrainedStateSpace::StateType>());
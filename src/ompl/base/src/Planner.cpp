@@ -132,6 +132,18 @@ void ompl::base::Planner::getPlannerData(PlannerData &data) const
         data.properties[plannerProgressProperty.first] = plannerProgressProperty.second();
 }
 
+void ompl::base::Planner::getCompactPlannerData(CompactPlannerData &data) const
+{
+    PlannerData pd(data.getSpaceInformation());
+    getPlannerData(pd);
+    data.fromPlannerData(pd);
+}
+
+bool ompl::base::Planner::setCompactPlannerData(const CompactPlannerData & /*data*/)
+{
+    return false;
+}
+
 ompl::base::PlannerStatus ompl::base::Planner::solve(const PlannerTerminationConditionFn &ptc, double checkInterval)
 {
     return solve(PlannerTerminationCondition(ptc, checkInterval));
@@ -140,3 +140,34 @@ void ompl::base::PlannerDataStorage::load(std::istream &in, PlannerData &pd)
         OMPL_ERROR("Failed to load PlannerData: %s", ae.what());
     }
 }
+
+void ompl::base::PlannerDataStorage::store(const CompactPlannerData &pd, const char *filename)
+{
+    std::ofstream out(filename, std::ios::binary);
+    store(pd, out);
+    out.close();
+}
+
+void ompl::base::PlannerDataStorage::store(const CompactPlannerData &pd, std::ostream &out)
+{
+    PlannerData data(pd.getSpaceInformation());
+    pd.toPlannerData(data);
+    store(data, out);
+}
+
+void ompl::base::PlannerDataStorage::load(const char *filename, CompactPlannerData &pd)
+{
+    std::ifstream in(filename, std::ios::binary);
+    load(in, pd);
+    in.close();
+}
+
+void ompl::base::PlannerDataStorage::load(std::istream &in, CompactPlannerData &pd)
+{
+    PlannerData data(pd.getSpaceInformation());
+    load(in, data);
+
+    // The states of data are freed with it
+    pd.fromPlannerData(data);
+    pd.decoupleFromPlanner();
+}
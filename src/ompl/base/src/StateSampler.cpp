@@ -37,6 +37,12 @@
 #include "ompl/base/StateSampler.h"
 #include "ompl/base/StateSpace.h"
 
+void ompl::base::StateSampler::sampleUniformBatch(State **states, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i)
+        sampleUniform(states[i]);
+}
+
 void ompl::base::CompoundStateSampler::addSampler(const StateSamplerPtr &sampler, double weightImportance)
 {
     samplers_.push_back(sampler);
@@ -51,6 +57,23 @@ void ompl::base::CompoundStateSampler::sampleUniform(State *state)
         samplers_[i]->sampleUniform(comps[i]);
 }
 
+void ompl::base::CompoundStateSampler::sampleUniformBatch(State **states, std::size_t n)
+{
+    if (!batchSampling_)
+    {
+        StateSampler::sampleUniformBatch(states, n);
+        return;
+    }
+
+    std::vector<State *> comps(n);
+    for (unsigned int i = 0; i < samplerCount_; ++i)
+    {
+        for (std::size_t j = 0; j < n; ++j)
+            comps[j] = states[j]->as<CompoundState>()->components[i];
+        samplers_[i]->sampleUniformBatch(comps.data(), n);
+    }
+}
+
 void ompl::base::CompoundStateSampler::sampleUniformNear(State *state, const State *near, const double distance)
 {
     State **comps = state->as<CompoundState>()->components;
@@ -1118,6 +1118,7 @@ void ompl::base::CompoundStateSpace::interpolate(const State *from, const State
 ompl::base::StateSamplerPtr ompl::base::CompoundStateSpace::allocDefaultStateSampler() const
 {
     auto ss(std::make_shared<CompoundStateSampler>(this));
+    ss->setBatchSampling(true);
     if (weightSum_ < std::numeric_limits<double>::epsilon())
         for (unsigned int i = 0; i < componentCount_; ++i)
             ss->addSampler(components_[i]->allocStateSampler(), 1.0);
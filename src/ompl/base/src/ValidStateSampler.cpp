@@ -52,3 +52,12 @@ ompl::base::ValidStateSampler::ValidStateSampler(const SpaceInformation *si)
 }
 
 ompl::base::ValidStateSampler::~ValidStateSampler() = default;
+
+std::size_t ompl::base::ValidStateSampler::sampleBatch(State **states, std::size_t n)
+{
+    std::size_t found = 0;
+    for (std::size_t i = 0; i < n; ++i)
+        if (sample(states[found]))
+            ++found;
+    return found;
+}
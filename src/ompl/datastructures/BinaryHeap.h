@@ -37,7 +37,10 @@
 #ifndef OMPL_DATASTRUCTURES_BINARY_HEAP_
 #define OMPL_DATASTRUCTURES_BINARY_HEAP_
 
+#include <algorithm>
 #include <functional>
+#include <new>
+#include <type_traits>
 #include <utility>
 #include <vector>
 #include <cassert>
@@ -47,10 +50,20 @@ namespace ompl
     /** \brief This class provides an implementation of an updatable
         min-heap. Using it is a bit cumbersome, as it requires keeping
         track of the BinaryHeap::Element* type, however, it should be
-        as fast as it gets with an updatable heap. */
-    template <typename _T, class LessThan = std::less<_T>>
+        as fast as it gets with an updatable heap.
+
+        Each node of the heap has \e Arity children. The default is a
+        binary heap; a 4-ary heap is shallower and keeps the children of
+        a node next to each other in memory, which makes insertions and
+        decrease-key operations cheaper at the cost of more comparisons
+        per level when removing the top element. The elements are
+        allocated in blocks and reused, so inserting usually does not
+        allocate memory. */
+    template <typename _T, class LessThan = std::less<_T>, unsigned int Arity = 2>
     class BinaryHeap
     {
+        static_assert(Arity >= 2, "A heap needs at least two children per node");
+
     public:
         /** \brief When an element is added to the heap, an instance
             of Element* is created. This instance contains the data
@@ -89,9 +102,45 @@ namespace ompl
             eventBeforeRemove_ = nullptr;
         }
 
+        BinaryHeap(const BinaryHeap &) = delete;
+        BinaryHeap &operator=(const BinaryHeap &) = delete;
+
+        /** \brief Move constructor. The Elements of \e other are now owned by this heap. */
+        BinaryHeap(BinaryHeap &&other) noexcept
+          : lt_(std::move(other.lt_))
+          , vector_(std::move(other.vector_))
+          , eventAfterInsert_(other.eventAfterInsert_)
+          , eventAfterInsertData_(other.eventAfterInsertData_)
+          , eventBeforeRemove_(other.eventBeforeRemove_)
+          , eventBeforeRemoveData_(other.eventBeforeRemoveData_)
+          , blocks_(std::move(other.blocks_))
+          , freeElements_(std::move(other.freeElements_))
+        {
+            other.vector_.clear();
+            other.blocks_.clear();
+            other.freeElements_.clear();
+        }
+
+        /** \brief Move assignment. The Elements of \e other are now owned by this heap, and the ones of this heap
+            are freed with \e other. */
+        BinaryHeap &operator=(BinaryHeap &&other) noexcept
+        {
+            std::swap(lt_, other.lt_);
+            vector_.swap(other.vector_);
+            std::swap(eventAfterInsert_, other.eventAfterInsert_);
+            std::swap(eventAfterInsertData_, other.eventAfterInsertData_);
+            std::swap(eventBeforeRemove_, other.eventBeforeRemove_);
+            std::swap(eventBeforeRemoveData_, other.eventBeforeRemoveData_);
+            blocks_.swap(other.blocks_);
+            freeElements_.swap(other.freeElements_);
+            return *this;
+        }
+
         ~BinaryHeap()
         {
             clear();
+            for (auto &block : blocks_)
+                delete[] block;
         }
 
         /** \brief Set the event that gets called after insertion */
@@ -112,7 +161,7 @@ namespace ompl
         void clear()
         {
             for (auto &element : vector_)
-                delete element;
+                freeElement(element);
             vector_.clear();
         }
 
@@ -139,10 +188,8 @@ namespace ompl
         /** \brief Add a new element */
         Element *insert(const _T &data)
         {
-            auto *element = new Element();
-            element->data = data;
             const unsigned int pos = vector_.size();
-            element->position = pos;
+            Element *element = newElement(data, pos);
             vector_.push_back(element);
             percolateUp(pos);
             if (eventAfterInsert_)
@@ -242,14 +289,26 @@ namespace ompl
         std::vector<Element *> vector_;
 
         EventAfterInsert eventAfterInsert_;
-        void *eventAfterInsertData_;
+        void *eventAfterInsertData_{nullptr};
         EventBeforeRemove eventBeforeRemove_;
-        void *eventBeforeRemoveData_;
+        void *eventBeforeRemoveData_{nullptr};
+
+        /** \brief Raw storage for one Element */
+        using ElementStorage = typename std::aligned_storage<sizeof(Element), alignof(Element)>::type;
+
+        /** \brief The number of Elements allocated at once */
+        static const unsigned int ELEMENTS_PER_BLOCK = 64;
+
+        /** \brief The blocks of storage the Elements are allocated from */
+        std::vector<ElementStorage *> blocks_;
+
+        /** \brief The unused storage in blocks_ */
+        std::vector<Element *> freeElements_;
 
         void removePos(unsigned int pos)
         {
             const int n = vector_.size() - 1;
-            delete vector_[pos];
+            freeElement(vector_[pos]);
             if ((int)pos < n)
             {
                 vector_[pos] = vector_.back();
@@ -261,17 +320,32 @@ namespace ompl
                 vector_.pop_back();
         }
 
-        Element *newElement(const _T &data, unsigned int pos) const
+        Element *newElement(const _T &data, unsigned int pos)
         {
-            auto *element = new Element();
+            if (freeElements_.empty())
+            {
+                blocks_.push_back(new ElementStorage[ELEMENTS_PER_BLOCK]);
+                for (unsigned int i = ELEMENTS_PER_BLOCK; i > 0; --i)
+                    freeElements_.push_back(reinterpret_cast<Element *>(&blocks_.back()[i - 1]));
+            }
+            auto *element = new (freeElements_.back()) Element();
+            freeElements_.pop_back();
             element->data = data;
             element->position = pos;
             return element;
         }
 
+        void freeElement(Element *element)
+        {
+            element->~Element();
+            freeElements_.push_back(element);
+        }
+
         void build()
         {
-            for (int i = vector_.size() / 2 - 1; i >= 0; --i)
+            if (vector_.size() < 2)
+                return;
+            for (int i = (vector_.size() - 2) / Arity; i >= 0; --i)
                 percolateDown(i);
         }
 
@@ -280,12 +354,16 @@ namespace ompl
             const unsigned int n = vector_.size();
             Element *tmp = vector_[pos];
             unsigned int parent = pos;
-            unsigned int child = (pos + 1) << 1;
+            unsigned int first = pos * Arity + 1;
 
-            while (child < n)
+            while (first < n)
             {
-                if (lt_(vector_[child - 1]->data, vector_[child]->data))
-                    --child;
+                // Find the smallest child; among equal children, the last one is preferred
+                const unsigned int last = std::min(first + Arity, n);
+                unsigned int child = last - 1;
+                for (unsigned int c = last - 1; c-- > first;)
+                    if (lt_(vector_[c]->data, vector_[child]->data))
+                        child = c;
                 if (lt_(vector_[child]->data, tmp->data))
                 {
                     vector_[parent] = vector_[child];
@@ -294,17 +372,7 @@ namespace ompl
                 else
                     break;
                 parent = child;
-                child = (child + 1) << 1;
-            }
-            if (child == n)
-            {
-                --child;
-                if (lt_(vector_[child]->data, tmp->data))
-                {
-                    vector_[parent] = vector_[child];
-                    vector_[parent]->position = parent;
-                    parent = child;
-                }
+                first = child * Arity + 1;
             }
             if (parent != pos)
             {
@@ -317,14 +385,14 @@ namespace ompl
         {
             Element *tmp = vector_[pos];
             unsigned int child = pos;
-            unsigned int parent = (pos - 1) >> 1;
+            unsigned int parent = (pos - 1) / Arity;
 
             while (child > 0 && lt_(tmp->data, vector_[parent]->data))
             {
                 vector_[child] = vector_[parent];
                 vector_[child]->position = child;
                 child = parent;
-                parent = (parent - 1) >> 1;
+                parent = (parent - 1) / Arity;
             }
             if (child != pos)
             {
@@ -40,8 +40,10 @@
 #include <Eigen/Core>
 #include <vector>
 #include <iostream>
+#include <cstdint>
 #include <cstdlib>
 #include <unordered_map>
+#include <utility>
 #include <algorithm>
 
 namespace ompl
@@ -116,7 +118,7 @@ namespace ompl
         /// Get the cell at a specified coordinate
         Cell *getCell(const Coord &coord) const
         {
-            auto pos = hash_.find(const_cast<Coord *>(&coord));
+            auto pos = hash_.find(&coord);
             Cell *c = (pos != hash_.end()) ? pos->second : nullptr;
             return c;
         }
@@ -124,39 +126,31 @@ namespace ompl
         /// Get the list of neighbors for a given cell
         void neighbors(const Cell *cell, CellArray &list) const
         {
-            Coord test = cell->coord;
-            neighbors(test, list);
+            neighbors(cell->coord, list);
         }
 
         /// Get the list of neighbors for a given coordinate
-        void neighbors(const Coord &coord, CellArray &list) const
+        void neighbors(Coord &coord, CellArray &list) const
         {
-            Coord test = coord;
-            neighbors(test, list);
+            neighbors(static_cast<const Coord &>(coord), list);
         }
 
-        /// Get the list of neighbors for a given coordinate
-        void neighbors(Coord &coord, CellArray &list) const
+        /// Get the list of neighbors for a given coordinate. The
+        /// neighboring coordinates are probed without being constructed.
+        void neighbors(const Coord &coord, CellArray &list) const
         {
             list.reserve(list.size() + maxNeighbors_);
 
+            const std::size_t h = CoordHash::hashCoord(coord);
             for (int i = dimension_ - 1; i >= 0; --i)
             {
-                coord[i]--;
-
-                auto pos = hash_.find(&coord);
-                Cell *cell = (pos != hash_.end()) ? pos->second : nullptr;
-
+                Cell *cell = hash_.findNeighbor(coord, h, i, -1);
                 if (cell)
                     list.push_back(cell);
-                coord[i] += 2;
-
-                pos = hash_.find(&coord);
-                cell = (pos != hash_.end()) ? pos->second : nullptr;
 
+                cell = hash_.findNeighbor(coord, h, i, 1);
                 if (cell)
                     list.push_back(cell);
-                coord[i]--;
             }
         }
 
@@ -348,8 +342,223 @@ namespace ompl
             }
         };
 
-        /// Define the datatype for the used hash structure
-        using CoordHash = std::unordered_map<Coord *, Cell *, HashFunCoordPtr, EqualCoordPtr>;
+        /// Open-addressing hash table from coordinates to cells. The
+        /// (coordinate, cell) pairs are stored with their hash values in one
+        /// flat array and collisions are resolved by linear probing, so a
+        /// lookup usually reads a single cache line. The hash of a coordinate
+        /// combines one mixed word per dimension, which lets the hash of a
+        /// neighboring coordinate be updated in constant time.
+        class CoordHash
+        {
+        public:
+            /// The (coordinate, cell) pairs stored in the table
+            using value_type = std::pair<Coord *, Cell *>;
+
+        private:
+            /// A slot of the table; it is empty if the coordinate is null
+            struct Slot
+            {
+                value_type value{nullptr, nullptr};
+                std::size_t hash{0};
+            };
+
+        public:
+            /// Iterator over the occupied slots of the table
+            class const_iterator
+            {
+            public:
+                const_iterator() = default;
+
+                const value_type &operator*() const
+                {
+                    return slot_->value;
+                }
+
+                const value_type *operator->() const
+                {
+                    return &slot_->value;
+                }
+
+                const_iterator &operator++()
+                {
+                    ++slot_;
+                    skipEmpty();
+                    return *this;
+                }
+
+                bool operator==(const const_iterator &other) const
+                {
+                    return slot_ == other.slot_;
+                }
+
+                bool operator!=(const const_iterator &other) const
+                {
+                    return slot_ != other.slot_;
+                }
+
+            private:
+                friend class CoordHash;
+
+                const_iterator(const Slot *slot, const Slot *last)
+                  : slot_(slot), last_(last)
+                {
+                }
+
+                void skipEmpty()
+                {
+                    while (slot_ != last_ && slot_->value.first == nullptr)
+                        ++slot_;
+                }
+
+                const Slot *slot_{nullptr};
+                const Slot *last_{nullptr};
+            };
+
+            /// Hash a coordinate
+            static std::size_t hashCoord(const Coord &coord)
+            {
+                std::size_t h = 0;
+                for (int i = 0; i < coord.size(); ++i)
+                    h ^= hashComponent(i, coord[i]);
+                return h;
+            }
+
+            const_iterator begin() const
+            {
+                const_iterator it(slots_.data(), slots_.data() + slots_.size());
+                it.skipEmpty();
+                return it;
+            }
+
+            const_iterator end() const
+            {
+                return const_iterator(slots_.data() + slots_.size(), slots_.data() + slots_.size());
+            }
+
+            /// Find the slot of a coordinate
+            const_iterator find(const Coord *coord) const
+            {
+                if (size_ == 0)
+                    return end();
+                const std::size_t h = hashCoord(*coord);
+                for (std::size_t i = h & mask_;; i = (i + 1) & mask_)
+                {
+                    const Slot &slot = slots_[i];
+                    if (slot.value.first == nullptr)
+                        return end();
+                    if (slot.hash == h && *slot.value.first == *coord)
+                        return const_iterator(&slot, slots_.data() + slots_.size());
+                }
+            }
+
+            /// Find the cell at \e coord, with component \e dim moved by
+            /// \e delta, given the hash \e h of \e coord
+            Cell *findNeighbor(const Coord &coord, std::size_t h, int dim, int delta) const
+            {
+                if (size_ == 0)
+                    return nullptr;
+                const int c = coord[dim] + delta;
+                h ^= hashComponent(dim, coord[dim]) ^ hashComponent(dim, c);
+                for (std::size_t i = h & mask_;; i = (i + 1) & mask_)
+                {
+                    const Slot &slot = slots_[i];
+                    if (slot.value.first == nullptr)
+                        return nullptr;
+                    if (slot.hash == h)
+                    {
+                        const Coord &other = *slot.value.first;
+                        bool equal = other[dim] == c;
+                        for (int j = 0; equal && j < coord.size(); ++j)
+                            equal = j == dim || other[j] == coord[j];
+                        if (equal)
+                            return slot.value.second;
+                    }
+                }
+            }
+
+            /// Insert a pair, unless its coordinate is already in the table
+            void insert(const value_type &value)
+            {
+                if (2 * (size_ + 1) > slots_.size())
+                    rehash(std::max<std::size_t>(16, 2 * slots_.size()));
+                const std::size_t h = hashCoord(*value.first);
+                std::size_t i = h & mask_;
+                for (; slots_[i].value.first != nullptr; i = (i + 1) & mask_)
+                    if (slots_[i].hash == h && *slots_[i].value.first == *value.first)
+                        return;
+                slots_[i].value = value;
+                slots_[i].hash = h;
+                ++size_;
+            }
+
+            /// Remove the pair at \e pos. Iterators are invalidated.
+            void erase(const_iterator pos)
+            {
+                // Shift back the following slots of the probe sequence, so no tombstones are needed
+                std::size_t i = pos.slot_ - slots_.data();
+                slots_[i].value = value_type(nullptr, nullptr);
+                for (std::size_t j = (i + 1) & mask_; slots_[j].value.first != nullptr; j = (j + 1) & mask_)
+                {
+                    const std::size_t home = slots_[j].hash & mask_;
+                    // Move slot j to the hole at i if its home slot is not in (i, j]
+                    if (((j - home) & mask_) >= ((j - i) & mask_))
+                    {
+                        slots_[i] = slots_[j];
+                        slots_[j].value = value_type(nullptr, nullptr);
+                        i = j;
+                    }
+                }
+                --size_;
+            }
+
+            void clear()
+            {
+                slots_.clear();
+                mask_ = 0;
+                size_ = 0;
+            }
+
+            bool empty() const
+            {
+                return size_ == 0;
+            }
+
+            std::size_t size() const
+            {
+                return size_;
+            }
+
+        private:
+            /// The hash of one component of a coordinate (splitmix64 finalizer)
+            static std::size_t hashComponent(int dim, int value)
+            {
+                std::uint64_t z = ((std::uint64_t)(unsigned int)dim << 32) ^ (std::uint64_t)(unsigned int)value;
+                z += 0x9e3779b97f4a7c15ULL;
+                z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+                z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+                return (std::size_t)(z ^ (z >> 31));
+            }
+
+            /// Move the pairs to a table with \e capacity slots (a power of two)
+            void rehash(std::size_t capacity)
+            {
+                std::vector<Slot> old(capacity);
+                old.swap(slots_);
+                mask_ = capacity - 1;
+                for (const auto &slot : old)
+                    if (slot.value.first != nullptr)
+                    {
+                        std::size_t i = slot.hash & mask_;
+                        while (slots_[i].value.first != nullptr)
+                            i = (i + 1) & mask_;
+                        slots_[i] = slot;
+                    }
+            }
+
+            std::vector<Slot> slots_;
+            std::size_t mask_{0};
+            std::size_t size_{0};
+        };
 
         /// Helper to sort components by size
         struct SortComponents
@@ -64,13 +64,16 @@ Lifelong Planning A. Artif. Intell. 155(1-2): 93-146 (2004)
 
 namespace ompl
 {
-    // Data is of type std::size_t
+    // Data is the vertex descriptor of the graph (std::size_t for vecS vertex lists). Edge weights
+    // are either doubles or objects with a value() method, such as base::Cost, and are added up.
     template <typename Graph,      // Boost graph
               typename Heuristic>  // heuristic to estimate cost
     class LPAstarOnGraph
     {
     public:
-        LPAstarOnGraph(std::size_t source, std::size_t target, Graph &graph, Heuristic &h)
+        using Vertex = typename boost::graph_traits<Graph>::vertex_descriptor;
+
+        LPAstarOnGraph(Vertex source, Vertex target, Graph &graph, Heuristic &h)
           : costEstimator_(h), graph_(graph)
         {
             // initialization
@@ -86,7 +89,7 @@ namespace ompl
             clear();
         }
 
-        void insertEdge(std::size_t u, std::size_t v, double c)
+        void insertEdge(Vertex u, Vertex v, double c)
         {
             Node *n_u = getNode(u);
             Node *n_v = getNode(v);
@@ -98,7 +101,7 @@ namespace ompl
                 updateVertex(n_v);
             }
         }
-        void removeEdge(std::size_t u, std::size_t v)
+        void removeEdge(Vertex u, Vertex v)
         {
             assert(v != source_->getId());
 
@@ -113,14 +116,25 @@ namespace ompl
 
             updateVertex(n_v);
         }
-        double computeShortestPath(std::list<std::size_t> &path)
+        /// forget vertex v before it is removed from the graph; its edges must have been removed with removeEdge()
+        void removeVertex(Vertex v)
+        {
+            assert(v != source_->getId() && v != target_->getId());
+
+            auto iter = idNodeMap_.find(v);
+            if (iter == idNodeMap_.end())
+                return;
+            removeQueue(iter->second);
+            delete iter->second;
+            idNodeMap_.erase(iter);
+        }
+        double computeShortestPath(std::list<Vertex> &path)
         {
             WeightMap weights = boost::get(boost::edge_weight_t(), graph_);
 
-            if (queue_.empty())
-                return std::numeric_limits<double>::infinity();
-
-            while (topHead()->key() < target_->calculateKey() || target_->rhs() != target_->costToCome())
+            // when the queue is empty, the costs are consistent and the last path is still the shortest
+            while (!queue_.empty() &&
+                   (topHead()->key() < target_->calculateKey() || target_->rhs() != target_->costToCome()))
             {
                 // pop from queue and process
                 Node *u = topHead();
@@ -134,9 +148,9 @@ namespace ompl
                     typename boost::graph_traits<Graph>::out_edge_iterator ei, ei_end;
                     for (boost::tie(ei, ei_end) = boost::out_edges(u->getId(), graph_); ei != ei_end; ++ei)
                     {
-                        std::size_t v = boost::target(*ei, graph_);
+                        Vertex v = boost::target(*ei, graph_);
                         Node *n_v = getNode(v);
-                        double c = boost::get(weights, *ei);  // edge weight from u to v
+                        double c = weightValue(boost::get(weights, *ei));  // edge weight from u to v
 
                         if (n_v->rhs() > u->costToCome() + c)
                         {
@@ -155,7 +169,7 @@ namespace ompl
                     typename boost::graph_traits<Graph>::out_edge_iterator ei, ei_end;
                     for (boost::tie(ei, ei_end) = boost::out_edges(u->getId(), graph_); ei != ei_end; ++ei)
                     {
-                        std::size_t v = boost::target(*ei, graph_);
+                        Vertex v = boost::target(*ei, graph_);
                         Node *n_v = getNode(v);
 
                         if ((n_v == source_) || (n_v->getParent() != u))
@@ -182,7 +196,7 @@ namespace ompl
         }
 
         /// using LPA* to approximate costToCome
-        double operator()(std::size_t u)
+        double operator()(Vertex u)
         {
             auto iter = idNodeMap_.find(u);
             if (iter != idNodeMap_.end())
@@ -206,7 +220,7 @@ namespace ompl
         class Node
         {
         public:
-            Node(double costToCome, double costToGo, double rhs, std::size_t &dataId, Node *parentNode = nullptr)
+            Node(double costToCome, double costToGo, double rhs, const Vertex &dataId, Node *parentNode = nullptr)
               : g(costToCome), h(costToGo), r(rhs), isInQ(false), parent(parentNode), id(dataId)
             {
                 calculateKey();
@@ -261,7 +275,7 @@ namespace ompl
                 parent = p;
             }
             // data field
-            std::size_t getId() const
+            Vertex getId() const
             {
                 return id;
             }
@@ -277,7 +291,7 @@ namespace ompl
             Key k;     // key
             bool isInQ;
             Node *parent;
-            std::size_t id;  // unique data associated with node
+            Vertex id;  // unique data associated with node
         };                   // Node
 
         struct LessThanNodeK
@@ -290,18 +304,28 @@ namespace ompl
 
         struct Hash
         {
-            std::size_t operator()(const std::size_t id) const
+            std::size_t operator()(const Vertex id) const
             {
                 return h(id);
             }
-            std::hash<std::size_t> h;
+            std::hash<Vertex> h;
         };  // Hash
 
         using Queue = std::multiset<Node *, LessThanNodeK>;
-        using IdNodeMap = std::unordered_map<std::size_t, Node *, Hash>;
+        using IdNodeMap = std::unordered_map<Vertex, Node *, Hash>;
         using IdNodeMapIter = typename IdNodeMap::iterator;
         using WeightMap = typename boost::property_map<Graph, boost::edge_weight_t>::type;
 
+        static double weightValue(double w)
+        {
+            return w;
+        }
+        template <typename Weight>
+        static double weightValue(const Weight &w)
+        {
+            return w.value();
+        }
+
         // LPA* subprocedures
         void updateVertex(Node *n)
         {
@@ -360,9 +384,9 @@ namespace ompl
             typename boost::graph_traits<Graph>::in_edge_iterator ei, ei_end;
             for (boost::tie(ei, ei_end) = boost::in_edges(n_v->getId(), graph_); ei != ei_end; ++ei)
             {
-                std::size_t u = boost::source(*ei, graph_);
+                Vertex u = boost::source(*ei, graph_);
                 Node *n_u = getNode(u);
-                double c = boost::get(weights, *ei);  // edge weight from u to v
+                double c = weightValue(boost::get(weights, *ei));  // edge weight from u to v
 
                 double curr = n_u->costToCome() + c;
                 if (curr < min)
@@ -381,7 +405,7 @@ namespace ompl
             idNodeMap_[n->getId()] = n;
         }
 
-        Node *getNode(std::size_t id)
+        Node *getNode(Vertex id)
         {
             auto iter = idNodeMap_.find(id);
             if (iter != idNodeMap_.end())
@@ -0,0 +1,186 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2026, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef OMPL_DATASTRUCTURES_NEAREST_NEIGHBORS_GRAPH_
+#define OMPL_DATASTRUCTURES_NEAREST_NEIGHBORS_GRAPH_
+
+#include "ompl/datastructures/NearestNeighbors.h"
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace ompl
+{
+    /** \brief The graph connecting each of a set of elements to its nearest
+        neighbors in a NearestNeighbors structure, stored in compressed
+        sparse row form: the neighbors of all elements are kept in one
+        array, and each element's neighbors are a contiguous row of it.
+
+        The graph is computed once, with the queries split among several
+        threads, and is read-only afterwards. Concurrent queries require
+        a NearestNeighbors structure that is safe to query from several
+        threads at once (e.g., NearestNeighborsGNAT, but not
+        NearestNeighborsGNATNoThreadSafety). */
+    template <typename _T>
+    class NearestNeighborsGraph
+    {
+    public:
+        /** \brief The neighbors of one element, in the order reported by
+            the NearestNeighbors structure */
+        class Row
+        {
+        public:
+            Row() = default;
+
+            Row(const _T *first, const _T *last) : first_(first), last_(last)
+            {
+            }
+
+            const _T *begin() const
+            {
+                return first_;
+            }
+
+            const _T *end() const
+            {
+                return last_;
+            }
+
+            std::size_t size() const
+            {
+                return last_ - first_;
+            }
+
+            bool empty() const
+            {
+                return first_ == last_;
+            }
+
+            const _T &operator[](std::size_t i) const
+            {
+                return first_[i];
+            }
+
+            const _T &back() const
+            {
+                return *(last_ - 1);
+            }
+
+        private:
+            const _T *first_{nullptr};
+            const _T *last_{nullptr};
+        };
+
+        /** \brief Compute the neighbors of \e elements in \e nn. Row \e i
+            holds the neighbors of elements[i], which are its \e k nearest
+            neighbors if \e k is positive, and the neighbors within \e radius
+            otherwise. An element is not a neighbor of itself. The queries
+            are split among \e numThreads threads. */
+        void build(const NearestNeighbors<_T> &nn, const std::vector<_T> &elements, std::size_t k, double radius,
+                   unsigned int numThreads)
+        {
+            numThreads = std::max(1u, std::min<unsigned int>(numThreads, elements.size()));
+
+            // Each thread computes the rows of a contiguous chunk of elements
+            std::vector<std::vector<std::size_t>> chunkOffsets(numThreads);
+            std::vector<std::vector<_T>> chunkNeighbors(numThreads);
+            const std::size_t chunk = (elements.size() + numThreads - 1) / numThreads;
+            auto work = [&](unsigned int t)
+            {
+                std::vector<_T> nbh;
+                const std::size_t first = std::min(elements.size(), t * chunk);
+                const std::size_t last = std::min(elements.size(), first + chunk);
+                chunkOffsets[t].reserve(last - first);
+                for (std::size_t i = first; i < last; ++i)
+                {
+                    if (k > 0)
+                        nn.nearestK(elements[i], k, nbh);
+                    else
+                        nn.nearestR(elements[i], radius, nbh);
+                    for (const auto &n : nbh)
+                        if (n != elements[i])
+                            chunkNeighbors[t].push_back(n);
+                    chunkOffsets[t].push_back(chunkNeighbors[t].size());
+                }
+            };
+            std::vector<std::thread> threads;
+            for (unsigned int t = 1; t < numThreads; ++t)
+                threads.emplace_back(work, t);
+            if (!elements.empty())
+                work(0);
+            for (auto &thread : threads)
+                thread.join();
+
+            // Concatenate the chunks
+            clear();
+            offsets_.reserve(elements.size() + 1);
+            offsets_.push_back(0);
+            for (unsigned int t = 0; t < numThreads; ++t)
+            {
+                const std::size_t base = neighbors_.size();
+                for (std::size_t offset : chunkOffsets[t])
+                    offsets_.push_back(base + offset);
+                neighbors_.insert(neighbors_.end(), chunkNeighbors[t].begin(), chunkNeighbors[t].end());
+            }
+        }
+
+        /** \brief Remove all rows */
+        void clear()
+        {
+            offsets_.clear();
+            neighbors_.clear();
+        }
+
+        /** \brief The number of rows */
+        std::size_t size() const
+        {
+            return offsets_.empty() ? 0 : offsets_.size() - 1;
+        }
+
+        /** \brief The neighbors of the element that was at position \e i when the graph was built */
+        Row row(std::size_t i) const
+        {
+            return Row(neighbors_.data() + offsets_[i], neighbors_.data() + offsets_[i + 1]);
+        }
+
+    private:
+        /** \brief Row \e i is neighbors_[offsets_[i] .. offsets_[i + 1]) */
+        std::vector<std::size_t> offsets_;
+
+        /** \brief The neighbors of all the elements, row after row */
+        std::vector<_T> neighbors_;
+    };
+}
+
+#endif
@@ -38,12 +38,17 @@
 #define OMPL_DATASTRUCTURES_PDF_
 
 #include "ompl/util/Exception.h"
+#include <algorithm>
 #include <iostream>
+#include <new>
+#include <type_traits>
 #include <vector>
 
 namespace ompl
 {
-    /** \brief A container that supports probabilistic sampling over weighted data. */
+    /** \brief A container that supports probabilistic sampling over weighted data. The weights are kept in an
+        implicit binary tree stored in one contiguous array: the leaves hold the weights of the elements, in the order
+        of getElements(), and every other node holds the sum of its two children. */
     template <typename _T>
     class PDF
     {
@@ -72,18 +77,35 @@ namespace ompl
         {
             if (d.size() != weights.size())
                 throw Exception("Data vector and weight vector must be of equal length");
-            // by default, reserve space for 512 elements
-            data_.reserve(512u);
-            // n elements require at most log2(n)+2 rows of the tree
-            tree_.reserve(11u);
+            data_.reserve(d.size());
             for (std::size_t i = 0; i < d.size(); ++i)
                 add(d[i], weights[i]);
         }
 
+        /** \brief Copy constructor. The copy has its own Elements, in the same order. */
+        PDF(const PDF &other)
+        {
+            *this = other;
+        }
+
         /** \brief Destructor. Clears allocated memory. */
         ~PDF()
         {
             clear();
+            for (auto &block : blocks_)
+                delete[] block;
+        }
+
+        /** \brief Assignment operator. The Elements of this PDF are replaced by copies of the ones of \e other. */
+        PDF &operator=(const PDF &other)
+        {
+            if (this != &other)
+            {
+                clear();
+                for (const auto &elem : other.data_)
+                    add(elem->data_, other.getWeight(elem));
+            }
+            return *this;
         }
 
         /** \brief Get the current set of stored elements */
@@ -98,32 +120,11 @@ namespace ompl
         {
             if (w < 0)
                 throw Exception("Weight argument must be a nonnegative value");
-            auto *elem = new Element(d, data_.size());
+            Element *elem = allocElement(d, data_.size());
             data_.push_back(elem);
-            if (data_.size() == 1)
-            {
-                std::vector<double> r(1, w);
-                tree_.push_back(r);
-                return elem;
-            }
-            tree_.front().push_back(w);
-            for (std::size_t i = 1; i < tree_.size(); ++i)
-            {
-                if (tree_[i - 1].size() % 2 == 1)
-                    tree_[i].push_back(w);
-                else
-                {
-                    while (i < tree_.size())
-                    {
-                        tree_[i].back() += w;
-                        ++i;
-                    }
-                    return elem;
-                }
-            }
-            // If we've made it here, then we need to add a new head to the tree.
-            std::vector<double> head(1, tree_.back()[0] + tree_.back()[1]);
-            tree_.push_back(head);
+            if (data_.size() > capacity_)
+                grow();
+            setWeight(elem->index_, w);
             return elem;
         }
 
@@ -135,20 +136,20 @@ which must be between 0 and 1. */
                 throw Exception("Cannot sample from an empty PDF");
             if (r < 0 || r > 1)
                 throw Exception("Sampling value must be between 0 and 1");
-            std::size_t row = tree_.size() - 1;
-            r *= tree_[row].front();
-            std::size_t node = 0;
-            while (row != 0)
+            r *= tree_[1];
+            std::size_t node = 1;
+            while (node < capacity_)
             {
-                --row;
                 node <<= 1;
-                if (r > tree_[row][node])
+                // Never descend into an empty subtree, such as the padding past the last element
+                if (r > tree_[node] && tree_[node + 1] > 0.0)
                 {
-                    r -= tree_[row][node];
+                    r -= tree_[node];
                     ++node;
                 }
             }
-            return data_[node]->data_;
+            // Guard against rounding in the sums sending the descent past the last element
+            return data_[std::min(node - capacity_, data_.size() - 1)]->data_;
         }
 
         /** \brief Updates the data in the given Element with a new weight value. */
@@ -157,20 +158,41 @@ which must be between 0 and 1. */
             std::size_t index = elem->index_;
             if (index >= data_.size())
                 throw Exception("Element to update is not in PDF");
-            const double weightChange = w - tree_.front()[index];
-            tree_.front()[index] = w;
-            index >>= 1;
-            for (std::size_t row = 1; row < tree_.size(); ++row)
+            setWeight(index, w);
+        }
+
+        /** \brief Updates the weights of several Elements at once. The sums in the tree are recomputed once for
+            all the updated elements, instead of once per element. */
+        void update(const std::vector<Element *> &elems, const std::vector<double> &weights)
+        {
+            if (elems.size() != weights.size())
+                throw Exception("Element vector and weight vector must be of equal length");
+            std::vector<std::size_t> nodes;
+            nodes.reserve(elems.size());
+            for (std::size_t i = 0; i < elems.size(); ++i)
             {
-                tree_[row][index] += weightChange;
-                index >>= 1;
+                if (elems[i]->index_ >= data_.size())
+                    throw Exception("Element to update is not in PDF");
+                tree_[capacity_ + elems[i]->index_] = weights[i];
+                nodes.push_back((capacity_ + elems[i]->index_) >> 1);
+            }
+            // Recompute the sums one level of the tree at a time
+            while (!nodes.empty() && nodes.front() > 0)
+            {
+                std::sort(nodes.begin(), nodes.end());
+                nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+                for (auto &node : nodes)
+                {
+                    tree_[node] = tree_[2 * node] + tree_[2 * node + 1];
+                    node >>= 1;
+                }
             }
         }
 
         /** \brief Returns the current weight of the given Element. */
         double getWeight(const Element *elem) const
         {
-            return tree_.front()[elem->index_];
+            return tree_[capacity_ + elem->index_];
         }
 
         /** \brief Removes the data in the given Element from the PDF. After calling this function, the Element object
@@ -179,72 +201,35 @@ which must be between 0 and 1. */
         {
             if (data_.size() == 1)
             {
-                delete data_.front();
+                freeElement(data_.front());
                 data_.clear();
                 tree_.clear();
+                capacity_ = 0;
                 return;
             }
 
+            // Move the last element to the place of the removed one
             const std::size_t index = elem->index_;
-            delete data_[index];
-
-            double weight;
-            if (index + 1 == data_.size())
-                weight = tree_.front().back();
-            else
+            const std::size_t last = data_.size() - 1;
+            freeElement(data_[index]);
+            if (index != last)
             {
-                std::swap(data_[index], data_.back());
+                data_[index] = data_[last];
                 data_[index]->index_ = index;
-                std::swap(tree_.front()[index], tree_.front().back());
-
-                /* If index and back() are siblings in the tree, then
-                 * we don't need to make an extra pass over the tree.
-                 * The amount by which we change the values at the edge
-                 * of the tree is different in this case. */
-                if (index + 2 == data_.size() && index % 2 == 0)
-                    weight = tree_.front().back();
-                else
-                {
-                    weight = tree_.front()[index];
-                    const double weightChange = weight - tree_.front().back();
-                    std::size_t parent = index >> 1;
-                    for (std::size_t row = 1; row < tree_.size(); ++row)
-                    {
-                        tree_[row][parent] += weightChange;
-                        parent >>= 1;
-                    }
-                }
+                setWeight(index, tree_[capacity_ + last]);
             }
-
-            /* Now that the element to remove is at the edge of the tree,
-             * pop it off and update the corresponding weights. */
             data_.pop_back();
-            tree_.front().pop_back();
-            for (std::size_t i = 1; i < tree_.size() && tree_[i - 1].size() > 1; ++i)
-            {
-                if (tree_[i - 1].size() % 2 == 0)
-                    tree_[i].pop_back();
-                else
-                {
-                    while (i < tree_.size())
-                    {
-                        tree_[i].back() -= weight;
-                        ++i;
-                    }
-                    return;
-                }
-            }
-            // If we've made it here, then we need to remove a redundant head from the tree.
-            tree_.pop_back();
+            setWeight(last, 0.0);
         }
 
         /** \brief Clears the PDF. */
         void clear()
         {
             for (auto e = data_.begin(); e != data_.end(); ++e)
-                delete *e;
+                freeElement(*e);
             data_.clear();
             tree_.clear();
+            capacity_ = 0;
         }
 
         /** \brief Returns the number of elements in the PDF. */
@@ -268,23 +253,86 @@ which must be between 0 and 1. */
         /** \brief Prints the PDF tree to a given output stream. Used for debugging purposes. */
         void printTree(std::ostream &out = std::cout) const
         {
-            if (tree_.empty())
+            if (data_.empty())
                 return;
-            for (std::size_t j = 0; j < tree_[0].size(); ++j)
-                out << "(" << data_[j]->data_ << "," << tree_[0][j] << ") ";
+            for (std::size_t j = 0; j < data_.size(); ++j)
+                out << "(" << data_[j]->data_ << "," << tree_[capacity_ + j] << ") ";
             out << std::endl;
-            for (std::size_t i = 1; i < tree_.size(); ++i)
+            for (std::size_t level = capacity_ >> 1; level > 0; level >>= 1)
             {
-                for (std::size_t j = 0; j < tree_[i].size(); ++j)
-                    out << tree_[i][j] << " ";
+                for (std::size_t j = level; j < 2 * level; ++j)
+                    out << tree_[j] << " ";
                 out << std::endl;
             }
             out << std::endl;
         }
 
     private:
+        /** \brief Raw storage for one Element */
+        using ElementStorage = typename std::aligned_storage<sizeof(Element), alignof(Element)>::type;
+
+        /** \brief The number of Elements allocated at once */
+        static const std::size_t ELEMENTS_PER_BLOCK = 64;
+
+        /** \brief Construct an Element in storage from the pool, so adding and removing data does not allocate
+            memory most of the time */
+        Element *allocElement(const _T &d, std::size_t index)
+        {
+            if (freeElements_.empty())
+            {
+                blocks_.push_back(new ElementStorage[ELEMENTS_PER_BLOCK]);
+                for (std::size_t i = ELEMENTS_PER_BLOCK; i > 0; --i)
+                    freeElements_.push_back(reinterpret_cast<Element *>(&blocks_.back()[i - 1]));
+            }
+            Element *elem = freeElements_.back();
+            freeElements_.pop_back();
+            return new (elem) Element(d, index);
+        }
+
+        /** \brief Destroy an Element and return its storage to the pool */
+        void freeElement(Element *elem)
+        {
+            elem->~Element();
+            freeElements_.push_back(elem);
+        }
+
+        /** \brief Set the weight of the leaf at \e index and update the sums above it. The sums are recomputed from
+            the children rather than adjusted by the change in weight, so no rounding residue accumulates and an empty
+            subtree always sums to exactly zero. */
+        void setWeight(std::size_t index, double w)
+        {
+            std::size_t node = capacity_ + index;
+            tree_[node] = w;
+            for (node >>= 1; node > 0; node >>= 1)
+                tree_[node] = tree_[2 * node] + tree_[2 * node + 1];
+        }
+
+        /** \brief Double the number of leaves of the tree and recompute the sums */
+        void grow()
+        {
+            const std::size_t capacity = std::max<std::size_t>(1, 2 * capacity_);
+            std::vector<double> tree(2 * capacity, 0.0);
+            std::copy(tree_.begin() + capacity_, tree_.end(), tree.begin() + capacity);
+            for (std::size_t node = capacity - 1; node > 0; --node)
+                tree[node] = tree[2 * node] + tree[2 * node + 1];
+            tree_.swap(tree);
+            capacity_ = capacity;
+        }
+
         std::vector<Element *> data_;
-        std::vector<std::vector<double>> tree_;
+
+        /** \brief The blocks of storage the Elements are allocated from */
+        std::vector<ElementStorage *> blocks_;
+
+        /** \brief The unused storage in blocks_ */
+        std::vector<Element *> freeElements_;
+
+        /** \brief The implicit tree: node 1 is the root, the children of node i are 2i and 2i + 1, and the leaves
+            are the nodes capacity_ to 2 capacity_ - 1 */
+        std::vector<double> tree_;
+
+        /** \brief The number of leaves of the tree, a power of two */
+        std::size_t capacity_{0};
     };
 }
 
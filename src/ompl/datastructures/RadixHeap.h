@@ -0,0 +1,256 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2026, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef OMPL_DATASTRUCTURES_RADIX_HEAP_
+#define OMPL_DATASTRUCTURES_RADIX_HEAP_
+
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace ompl
+{
+    /** \brief A monotone radix heap: an updatable min-heap for searches
+        that never insert an element with a key smaller than the key of
+        the last element returned by top(), such as Dijkstra's algorithm
+        or A* with a consistent heuristic. It has the same interface as
+        BinaryHeap, except that the order is given by a nonnegative
+        double computed by \e KeyOf from the data, instead of a
+        comparison.
+
+        Elements are kept in 65 buckets according to the highest bit in
+        which their key differs from the last key returned by top().
+        Insertion and update are constant time; top() occasionally
+        redistributes one bucket into the lower ones, and each element
+        moves at most 64 times overall. Keys smaller than the last key
+        returned by top() are treated as equal to it. */
+    template <typename _T, class KeyOf>
+    class RadixHeap
+    {
+    public:
+        /** \brief When an element is added to the heap, an instance
+            of Element* is created. This instance contains the data
+            that was added and internal information about the position
+            of the data in the heap's internal storage. */
+        class Element
+        {
+            friend class RadixHeap;
+
+        private:
+            Element() = default;
+            ~Element() = default;
+            /** \brief The encoded key of the element */
+            std::uint64_t key;
+            /** \brief The bucket the element is in */
+            unsigned int bucket;
+            /** \brief The location of the element in its bucket */
+            unsigned int position;
+
+        public:
+            /** \brief The data of this element */
+            _T data;
+        };
+
+        RadixHeap() = default;
+
+        RadixHeap(KeyOf keyOf) : keyOf_(std::move(keyOf))
+        {
+        }
+
+        RadixHeap(const RadixHeap &) = delete;
+        RadixHeap &operator=(const RadixHeap &) = delete;
+
+        ~RadixHeap()
+        {
+            clear();
+        }
+
+        /** \brief Clear the heap */
+        void clear()
+        {
+            for (auto &bucket : buckets_)
+            {
+                for (auto &element : bucket)
+                    delete element;
+                bucket.clear();
+            }
+            last_ = 0;
+            size_ = 0;
+        }
+
+        /** \brief Return the top element. nullptr for an empty heap. */
+        Element *top()
+        {
+            if (size_ == 0)
+                return nullptr;
+            if (buckets_[0].empty())
+            {
+                // The smallest key of the first nonempty bucket becomes the new reference key
+                unsigned int b = 1;
+                while (buckets_[b].empty())
+                    ++b;
+                std::vector<Element *> moved;
+                moved.swap(buckets_[b]);
+                last_ = moved.front()->key;
+                for (const auto &element : moved)
+                    if (element->key < last_)
+                        last_ = element->key;
+                // All the keys of bucket b share the bits above bit b - 1 with the new reference key, so they
+                // move to lower buckets
+                for (auto &element : moved)
+                    place(element);
+            }
+            return buckets_[0].back();
+        }
+
+        /** \brief Remove the top element */
+        void pop()
+        {
+            remove(top());
+        }
+
+        /** \brief Remove a specific element */
+        void remove(Element *element)
+        {
+            unplace(element);
+            delete element;
+            --size_;
+        }
+
+        /** \brief Add a new element */
+        Element *insert(const _T &data)
+        {
+            auto *element = new Element();
+            element->data = data;
+            element->key = encode(keyOf_(data));
+            place(element);
+            ++size_;
+            return element;
+        }
+
+        /** \brief Add a set of elements to the heap */
+        void insert(const std::vector<_T> &list)
+        {
+            for (const auto &data : list)
+                insert(data);
+        }
+
+        /** \brief Update an element in the heap, after its key changed */
+        void update(Element *element)
+        {
+            unplace(element);
+            element->key = encode(keyOf_(element->data));
+            place(element);
+        }
+
+        /** \brief Check if the heap is empty */
+        bool empty() const
+        {
+            return size_ == 0;
+        }
+
+        /** \brief Get the number of elements in the heap */
+        unsigned int size() const
+        {
+            return size_;
+        }
+
+        /** \brief Get the data stored in this heap */
+        void getContent(std::vector<_T> &content) const
+        {
+            for (const auto &bucket : buckets_)
+                for (const auto &element : bucket)
+                    content.push_back(element->data);
+        }
+
+        /** \brief Return a reference to the key function */
+        KeyOf &getKeyFunction()
+        {
+            return keyOf_;
+        }
+
+    private:
+        /** \brief Map a nonnegative double to an integer with the same order */
+        static std::uint64_t encode(double key)
+        {
+            if (!(key > 0.0))
+                return 0;  // also maps -0.0 to 0
+            std::uint64_t bits;
+            std::memcpy(&bits, &key, sizeof(bits));
+            return bits;
+        }
+
+        /** \brief Put an element in the bucket of its key */
+        void place(Element *element)
+        {
+            if (element->key < last_)
+                element->key = last_;
+            const std::uint64_t diff = element->key ^ last_;
+#if defined(__GNUC__) || defined(__clang__)
+            const unsigned int b = diff == 0 ? 0 : 64 - __builtin_clzll(diff);
+#else
+            unsigned int b = 0;
+            for (std::uint64_t d = diff; d != 0; d >>= 1)
+                ++b;
+#endif
+            element->bucket = b;
+            element->position = buckets_[b].size();
+            buckets_[b].push_back(element);
+        }
+
+        /** \brief Take an element out of its bucket */
+        void unplace(Element *element)
+        {
+            std::vector<Element *> &bucket = buckets_[element->bucket];
+            bucket[element->position] = bucket.back();
+            bucket[element->position]->position = element->position;
+            bucket.pop_back();
+        }
+
+        KeyOf keyOf_;
+
+        /** \brief Bucket 0 holds the keys equal to last_; bucket b > 0 holds the keys whose highest bit that differs
+            from last_ is bit b - 1 */
+        std::vector<Element *> buckets_[65];
+
+        /** \brief The last key returned by top() */
+        std::uint64_t last_{0};
+
+        /** \brief The number of elements in the heap */
+        unsigned int size_{0};
+    };
+}
+
+#endif
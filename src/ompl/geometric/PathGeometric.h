@@ -143,6 +143,21 @@ namespace ompl
                 ompl::base::StateSpace::copyToReals. */
             virtual void printAsMatrix(std::ostream &out) const;
 
+            /** \brief Copy the real values of all states to \e reals, as a row-major matrix where the
+                i-th row holds the values of the i-th state (in the order of
+                ompl::base::StateSpace::getValueLocations()). \e reals is resized as needed,
+                so reusing the same vector across calls avoids allocations. */
+            void copyToReals(std::vector<double> &reals) const;
+
+            /** \brief Write the states of the path one after the other to \e buffer, using
+                ompl::base::StateSpace::serialize(). For spaces made of real vectors this is a
+                plain memory copy. \e buffer is resized as needed. */
+            void serialize(std::vector<unsigned char> &buffer) const;
+
+            /** \brief Replace the states of the path with the ones stored in \e buffer by
+                serialize(). Memory of states already in the path is reused. */
+            void deserialize(const std::vector<unsigned char> &buffer);
+
             /** @name Path operations
                 @{ */
 
@@ -266,9 +281,13 @@ namespace ompl
             /** \brief Free the memory corresponding to the states on this path */
             void freeMemory();
 
-            /** \brief Copy data to this path from another path instance */
+            /** \brief Copy data to this path from another path instance. States already in this path are
+                overwritten rather than reallocated. */
             void copyFrom(const PathGeometric &other);
 
+            /** \brief Resize the path to \e count states, allocating or freeing states at the end as needed */
+            void resizeStates(std::size_t count);
+
             /** \brief The list of states that make up the path */
             std::vector<base::State *> states_;
         };
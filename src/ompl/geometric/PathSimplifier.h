@@ -45,6 +45,7 @@
 #include "ompl/util/ClassForward.h"
 #include "ompl/util/RandomNumbers.h"
 #include "ompl/util/Console.h"
+#include <algorithm>
 #include <limits>
 
 namespace ompl
@@ -93,6 +94,14 @@ namespace ompl
             bool reduceVertices(PathGeometric &path, unsigned int maxSteps = 0, unsigned int maxEmptySteps = 0,
                                 double rangeRatio = 0.33);
 
+            /** \brief Same as reduceVertices(), but in each step getNumThreads() random connections between
+                non-overlapping parts of the path are checked concurrently, and all valid ones are applied. Every
+                checked connection counts as one attempt towards \e maxSteps and \e maxEmptySteps. The worker threads
+                are started once per call and reused for every step. The motion validator and the state validity
+                checker need to be thread safe. */
+            bool reduceVerticesParallel(PathGeometric &path, unsigned int maxSteps = 0,
+                                        unsigned int maxEmptySteps = 0, double rangeRatio = 0.33);
+
             /** \brief Given a path, attempt to shorten it while maintaining its validity. This is an iterative process
                 that attempts to do "short-cutting" on the path. Connection is attempted between random points along the
                 path segments. Unlike the reduceVertices() function, this function does not sample only vertices
@@ -203,6 +212,13 @@ namespace ompl
                true, and at least once if \e atLeastOnce. Return \e false iff the simplified path is not valid. */
             bool simplify(PathGeometric &path, const base::PlannerTerminationCondition &ptc, bool atLeastOnce = true);
 
+            /** \brief Run simplify() concurrently on \e numStarts copies of \e path, each with a differently seeded
+               random number generator, and replace \e path by the copy of lowest cost. Since goal sampling is not
+               thread safe, only the first copy looks for a better goal. Return \e false iff the selected path is not
+               valid. */
+            bool simplifyMultiStart(PathGeometric &path, unsigned int numStarts,
+                                    const base::PlannerTerminationCondition &ptc, bool atLeastOnce = true);
+
             /** \brief Attempt to improve the solution path by sampling a new goal state and connecting this state to
                 the solution path for at most \e maxTime seconds.
 
@@ -245,6 +261,20 @@ namespace ompl
              * simplification */
             bool freeStates() const;
 
+            /** \brief Set the number of threads used to check shortcuts concurrently. If this is larger than 1,
+                simplify() uses reduceVerticesParallel() instead of reduceVertices(). shortcutPath() stays serial,
+                since each of its steps changes the path and the costs the next step is computed from. */
+            void setNumThreads(unsigned int numThreads)
+            {
+                numThreads_ = std::max(1u, numThreads);
+            }
+
+            /** \brief Get the number of threads used to check shortcuts concurrently */
+            unsigned int getNumThreads() const
+            {
+                return numThreads_;
+            }
+
         protected:
 
             int selectAlongPath(std::vector<double> dists, std::vector<base::State *> states,
@@ -263,6 +293,9 @@ namespace ompl
             /** \brief Flag indicating whether the states removed from a motion should be freed */
             bool freeStates_;
 
+            /** \brief The number of threads used to check shortcuts concurrently */
+            unsigned int numThreads_{1u};
+
             /** \brief Instance of random number generator */
             RNG rng_;
         };
@@ -45,6 +45,8 @@
 #include "ompl/geometric/PathSimplifier.h"
 #include "ompl/util/Console.h"
 #include "ompl/util/Exception.h"
+#include <string>
+#include <thread>
 
 namespace ompl
 {
@@ -68,7 +70,7 @@ namespace ompl
             /** \brief Constructor needs the state space used for planning. */
             explicit SimpleSetup(const base::StateSpacePtr &space);
 
-            virtual ~SimpleSetup() = default;
+            virtual ~SimpleSetup();
 
             /** \brief Get the current instance of the space information */
             const base::SpaceInformationPtr &getSpaceInformation() const
@@ -266,9 +268,34 @@ namespace ompl
 
             /** \brief Clear all planning data. This only includes
                 data generated by motion plan computation. Planner
-                settings, start & goal states are not affected. */
+                settings, start & goal states are not affected. If a
+                roadmap cache is set, the next setup() loads it again. */
             virtual void clear();
 
+            /** \brief Keep the roadmap of the planner in the file \e
+                filename across runs (an empty name turns this off). When
+                the planner is set up, the roadmap in the file, if the file
+                exists and was written for the same state space, is passed
+                to the planner with base::Planner::setCompactPlannerData().
+                After each call to solve(), the vertices and edges the
+                planner added are appended to the file (see
+                base::CompactPlannerDataStorage) by a background thread,
+                which the next call to solve() or clear() waits for. The
+                cache is only used with planners that set
+                base::PlannerSpecs::canLoadCompactPlannerData, and assumes
+                the planner only adds to its roadmap between calls to
+                clear(), as PRM does. */
+            void setRoadmapCache(const std::string &filename);
+
+            /** \brief Get the file the roadmap of the planner is kept in (empty if none) */
+            const std::string &getRoadmapCache() const
+            {
+                return roadmapCache_;
+            }
+
+            /** \brief Wait until the roadmap cache file is up to date */
+            void waitForRoadmapCache();
+
             /** \brief Print information about the current setup */
             virtual void print(std::ostream &out = std::cout) const;
 
@@ -278,6 +305,12 @@ namespace ompl
             virtual void setup();
 
         protected:
+            /// Pass the roadmap in the cache file to the planner
+            void loadRoadmapCache();
+
+            /// Start writing the vertices and edges the planner added to the cache file
+            void appendRoadmapCache();
+
             /// The created space information
             base::SpaceInformationPtr si_;
 
@@ -304,6 +337,21 @@ namespace ompl
 
             /// The status of the last planning request
             base::PlannerStatus lastStatus_;
+
+            /// The file the roadmap of the planner is kept in (empty if none)
+            std::string roadmapCache_;
+
+            /// The planner the roadmap cache was last loaded into
+            base::PlannerPtr roadmapCachePlanner_;
+
+            /// Flag indicating whether the planner's roadmap can be written to the cache file
+            bool roadmapCacheWritable_{false};
+
+            /// The number of roadmap vertices in the cache file
+            unsigned int roadmapCacheVertices_{0};
+
+            /// The thread writing to the cache file
+            std::thread roadmapCacheWriter_;
         };
     }
 }
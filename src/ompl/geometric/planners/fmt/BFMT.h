@@ -44,8 +44,10 @@
 #include <ompl/geometric/planners/PlannerIncludes.h>
 #include <ompl/base/goals/GoalSampleableRegion.h>
 #include <ompl/datastructures/NearestNeighbors.h>
+#include <ompl/datastructures/NearestNeighborsGraph.h>
 #include <ompl/datastructures/BinaryHeap.h>
 #include <ompl/base/OptimizationObjective.h>
+#include <algorithm>
 #include <map>
 #include <utility>
 
@@ -269,6 +271,24 @@ namespace ompl
                 return precomputeNN_;
             }
 
+            /** \brief Set the number of threads used to sample the free
+                space and, when Nearest Neighbors precomputation is enabled,
+                to compute the neighborhoods of all samples. The state
+                validity checker needs to be thread safe. Call before
+                setup(), so a nearest neighbors structure that supports
+                concurrent queries is selected. The default value is 1. */
+            void setNumThreads(unsigned int numThreads)
+            {
+                numThreads_ = std::max(1u, numThreads);
+                specs_.multithreaded = numThreads_ > 1;
+            }
+
+            /** \brief Get the number of threads used before planning */
+            unsigned int getNumThreads() const
+            {
+                return numThreads_;
+            }
+
             /** \brief Representation of a bidirectional motion. */
             class BiDirMotion
             {
@@ -511,6 +531,10 @@ namespace ompl
                 used (nearestK or nearestR depends on the planner configuration */
             void saveNeighborhood(BiDirMotion *m);
 
+            /** \brief Save the neighborhoods of all the motions in the nearest
+                neighbors structure, computing them with numThreads_ threads */
+            void saveAllNeighborhoods();
+
             /** \brief Sample a state from the free configuration space and save
                 it into the nearest neighbors data structure */
             void sampleFree(const std::shared_ptr<NearestNeighbors<BiDirMotion *>> &nn,
@@ -590,6 +614,9 @@ namespace ompl
             /** \brief If true all the nearest neighbors maps are precomputed before solving. */
             bool precomputeNN_{false};
 
+            /** \brief The number of threads used before planning */
+            unsigned int numThreads_{1u};
+
             /** \brief A nearest-neighbor datastructure containing the set of all motions */
             std::shared_ptr<NearestNeighbors<BiDirMotion *>> nn_;
 
@@ -45,8 +45,11 @@
 #include <ompl/geometric/planners/PlannerIncludes.h>
 #include <ompl/base/goals/GoalSampleableRegion.h>
 #include <ompl/datastructures/NearestNeighbors.h>
+#include <ompl/datastructures/NearestNeighborsGraph.h>
 #include <ompl/datastructures/BinaryHeap.h>
 #include <ompl/base/OptimizationObjective.h>
+#include <algorithm>
+#include <limits>
 #include <map>
 
 namespace ompl
@@ -208,6 +211,26 @@ namespace ompl
                 return extendedFMT_;
             }
 
+            /** \brief Set the number of threads used to sample the free
+                space and to compute the neighborhoods of all samples before
+                planning. With more than one thread, the neighborhoods are
+                precomputed in a compressed sparse row graph instead of being
+                computed as the tree reaches each sample. The state validity
+                checker needs to be thread safe. Call before setup(), so a
+                nearest neighbors structure that supports concurrent queries
+                is selected. The default value is 1. */
+            void setNumThreads(unsigned int numThreads)
+            {
+                numThreads_ = std::max(1u, numThreads);
+                specs_.multithreaded = numThreads_ > 1;
+            }
+
+            /** \brief Get the number of threads used before planning */
+            unsigned int getNumThreads() const
+            {
+                return numThreads_;
+            }
+
         protected:
             /** \brief Representation of a motion
               */
@@ -317,6 +340,24 @@ namespace ompl
                     return children_;
                 }
 
+                /** \brief Set the row of the precomputed neighborhood graph that holds the neighbors of this motion */
+                void setNeighborhoodRow(std::size_t row)
+                {
+                    nbhRow_ = row;
+                }
+
+                /** \brief Get the row of the precomputed neighborhood graph that holds the neighbors of this motion */
+                std::size_t getNeighborhoodRow() const
+                {
+                    return nbhRow_;
+                }
+
+                /** \brief Returns true if the neighbors of this motion are in the precomputed neighborhood graph */
+                bool hasNeighborhoodRow() const
+                {
+                    return nbhRow_ != std::numeric_limits<std::size_t>::max();
+                }
+
             protected:
                 /** \brief The state contained by the motion */
                 base::State *state_{nullptr};
@@ -338,8 +379,14 @@ namespace ompl
 
                 /** \brief The set of motions descending from the current motion */
                 std::vector<Motion *> children_;
+
+                /** \brief The row of the precomputed neighborhood graph for this motion, if any */
+                std::size_t nbhRow_{std::numeric_limits<std::size_t>::max()};
             };
 
+            /** \brief A read-only view of the neighbors of a motion */
+            using Neighborhood = NearestNeighborsGraph<Motion *>::Row;
+
             /** \brief Comparator used to order motions in a binary heap */
             struct MotionCompare
             {
@@ -399,6 +446,14 @@ namespace ompl
                 used (nearestK or nearestR depends on the planner configuration */
             void saveNeighborhood(Motion *m);
 
+            /** \brief Get the neighbors of a motion, computing them first if needed. The view is valid until the
+                neighborhood of the motion is updated. */
+            Neighborhood getNeighborhood(Motion *m);
+
+            /** \brief Compute the neighborhoods of all the motions in the nearest neighbors structure, using
+                numThreads_ threads */
+            void buildNeighborhoodGraph();
+
             /** \brief Trace the path from a goal state back to the start state
                 and save the result as a solution in the Problem Definiton. */
             void traceSolutionPathThroughTree(Motion *goalMotion);
@@ -430,9 +485,18 @@ namespace ompl
             MotionBinHeap Open_;
 
             /** \brief A map linking a motion to all of the motions within a
-                distance r of that motion */
+                distance r of that motion. Motions in the precomputed
+                neighborhood graph only appear here once their neighborhood
+                is updated */
             std::map<Motion *, std::vector<Motion *>> neighborhoods_;
 
+            /** \brief The neighborhoods of all samples, precomputed when
+                more than one thread is used */
+            NearestNeighborsGraph<Motion *> nbhGraph_;
+
+            /** \brief The number of threads used before planning */
+            unsigned int numThreads_{1u};
+
             /** \brief The number of samples to use when planning */
             unsigned int numSamples_{1000u};
 
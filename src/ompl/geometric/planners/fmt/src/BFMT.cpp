@@ -8,7 +8,9 @@
 #include <ompl/base/objectives/PathLengthOptimizationObjective.h>
 #include <ompl/geometric/planners/fmt/BFMT.h>
 
+#include <atomic>
 #include <fstream>
+#include <thread>
 #include <ompl/base/spaces/RealVectorStateSpace.h>
 
 namespace ompl
@@ -38,6 +40,8 @@ namespace ompl
             ompl::base::Planner::declareParam<bool>("cache_cc", this, &BFMT::setCacheCC, &BFMT::getCacheCC, "0,1");
             ompl::base::Planner::declareParam<bool>("extended_fmt", this, &BFMT::setExtendedFMT, &BFMT::getExtendedFMT,
                                                     "0,1");
+            ompl::base::Planner::declareParam<unsigned int>("num_threads", this, &BFMT::setNumThreads,
+                                                            &BFMT::getNumThreads, "1:1:64");
         }
 
         ompl::geometric::BFMT::~BFMT()
@@ -212,31 +216,75 @@ namespace ompl
             }
         }
 
+        void BFMT::saveAllNeighborhoods()
+        {
+            BiDirMotionPtrs motions;
+            nn_->list(motions);
+            if (numThreads_ <= 1)
+            {
+                for (auto &motion : motions)
+                    saveNeighborhood(motion);  // nearest neighbors
+                return;
+            }
+
+            // As in saveNeighborhood(), NNk_ counts the motion itself, which the graph leaves out
+            NearestNeighborsGraph<BiDirMotion *> graph;
+            graph.build(*nn_, motions, nearestK_ ? std::max(NNk_, 1u) : 0, NNr_, numThreads_);
+            for (std::size_t i = 0; i < motions.size(); ++i)
+            {
+                const NearestNeighborsGraph<BiDirMotion *>::Row row = graph.row(i);
+                neighborhoods_.emplace(motions[i], BiDirMotionPtrs(row.begin(), row.end()));
+            }
+        }
+
         void BFMT::sampleFree(const std::shared_ptr<NearestNeighbors<BiDirMotion *>> &nn,
                               const base::PlannerTerminationCondition &ptc)
         {
-            unsigned int nodeCount = 0;
-            unsigned int sampleAttempts = 0;
-            auto *motion = new BiDirMotion(si_, &tree_);
+            // Each thread samples with its own sampler, created here so the seeds they get do not depend on
+            // thread scheduling
+            std::vector<base::StateSamplerPtr> samplers(1, sampler_);
+            for (unsigned int t = 1; t < numThreads_; ++t)
+                samplers.push_back(si_->allocStateSampler());
+            std::vector<BiDirMotionPtrs> found(numThreads_);
+            std::vector<unsigned int> sampleAttempts(numThreads_, 0u);
+            std::atomic<unsigned int> nodeCount(0u);
 
             // Sample numSamples_ number of nodes from the free configuration space
-            while (nodeCount < numSamples_ && !ptc)
-            {
-                sampler_->sampleUniform(motion->getState());
-                sampleAttempts++;
-                if (si_->isValid(motion->getState()))
-                {  // collision checking
-                    ++nodeCount;
-                    nn->add(motion);
-                    motion = new BiDirMotion(si_, &tree_);
+            auto work = [&](unsigned int t)
+            {
+                auto *motion = new BiDirMotion(si_, &tree_);
+                while (nodeCount < numSamples_ && !ptc)
+                {
+                    samplers[t]->sampleUniform(motion->getState());
+                    sampleAttempts[t]++;
+                    if (si_->isValid(motion->getState()) && nodeCount++ < numSamples_)
+                    {  // collision checking
+                        found[t].push_back(motion);
+                        motion = new BiDirMotion(si_, &tree_);
+                    }
                 }
+                si_->freeState(motion->getState());
+                delete motion;
+            };
+            std::vector<std::thread> threads;
+            for (unsigned int t = 1; t < numThreads_; ++t)
+                threads.emplace_back(work, t);
+            work(0);
+            for (auto &thread : threads)
+                thread.join();
+
+            unsigned int totalFound = 0;
+            unsigned int totalAttempts = 0;
+            for (unsigned int t = 0; t < numThreads_; ++t)
+            {
+                nn->add(found[t]);
+                totalFound += found[t].size();
+                totalAttempts += sampleAttempts[t];
             }
-            si_->freeState(motion->getState());
-            delete motion;
 
             // 95% confidence limit for an upper bound for the true free space volume
             freeSpaceVolume_ =
-                boost::math::binomial_distribution<>::find_upper_bound_on_p(sampleAttempts, nodeCount, 0.05) *
+                boost::math::binomial_distribution<>::find_upper_bound_on_p(totalAttempts, totalFound, 0.05) *
                 si_->getStateSpace()->getMeasure();
         }
 
@@ -580,10 +628,7 @@ namespace ompl
             /// otherwise is probably a waste of time. Do a real precomputation before calling solve().
             if (precomputeNN_)
             {
-                for (auto &sampleNode : sampleNodes)
-                {
-                    saveNeighborhood(sampleNode);  // nearest neighbors
-                }
+                saveAllNeighborhoods();
             }
             else
             {
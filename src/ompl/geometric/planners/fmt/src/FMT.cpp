@@ -39,13 +39,16 @@
 /* Acknowledgements for insightful comments: Oren Salzman (Tel Aviv University),
  *                                           Joseph Starek (Stanford) */
 
+#include <atomic>
 #include <limits>
 #include <iostream>
+#include <thread>
 
 #include <boost/math/constants/constants.hpp>
 #include <boost/math/distributions/binomial.hpp>
 
 #include <ompl/datastructures/BinaryHeap.h>
+#include <ompl/tools/config/MagicConstants.h>
 #include <ompl/tools/config/SelfConfig.h>
 #include <ompl/base/objectives/PathLengthOptimizationObjective.h>
 #include <ompl/geometric/planners/fmt/FMT.h>
@@ -68,6 +71,8 @@ ompl::geometric::FMT::FMT(const base::SpaceInformationPtr &si)
     ompl::base::Planner::declareParam<bool>("cache_cc", this, &FMT::setCacheCC, &FMT::getCacheCC, "0,1");
     ompl::base::Planner::declareParam<bool>("heuristics", this, &FMT::setHeuristics, &FMT::getHeuristics, "0,1");
     ompl::base::Planner::declareParam<bool>("extended_fmt", this, &FMT::setExtendedFMT, &FMT::getExtendedFMT, "0,1");
+    ompl::base::Planner::declareParam<unsigned int>("num_threads", this, &FMT::setNumThreads, &FMT::getNumThreads,
+                                                    "1:1:64");
 }
 
 ompl::geometric::FMT::~FMT()
@@ -142,6 +147,7 @@ void ompl::geometric::FMT::clear()
         nn_->clear();
     Open_.clear();
     neighborhoods_.clear();
+    nbhGraph_.clear();
 
     collisionChecks_ = 0;
 }
@@ -169,7 +175,7 @@ void ompl::geometric::FMT::getPlannerData(base::PlannerData &data) const
 void ompl::geometric::FMT::saveNeighborhood(Motion *m)
 {
     // Check to see if neighborhood has not been saved yet
-    if (neighborhoods_.find(m) == neighborhoods_.end())
+    if (!m->hasNeighborhoodRow() && neighborhoods_.find(m) == neighborhoods_.end())
     {
         std::vector<Motion *> nbh;
         if (nearestK_)
@@ -190,6 +196,30 @@ void ompl::geometric::FMT::saveNeighborhood(Motion *m)
     }  // If neighborhood hadn't been saved yet
 }
 
+ompl::geometric::FMT::Neighborhood ompl::geometric::FMT::getNeighborhood(Motion *m)
+{
+    // An updated neighborhood takes precedence over the precomputed one
+    auto it = neighborhoods_.find(m);
+    if (it == neighborhoods_.end())
+    {
+        if (m->hasNeighborhoodRow())
+            return nbhGraph_.row(m->getNeighborhoodRow());
+        saveNeighborhood(m);
+        it = neighborhoods_.find(m);
+    }
+    return Neighborhood(it->second.data(), it->second.data() + it->second.size());
+}
+
+void ompl::geometric::FMT::buildNeighborhoodGraph()
+{
+    std::vector<Motion *> motions;
+    nn_->list(motions);
+    for (std::size_t i = 0; i < motions.size(); ++i)
+        motions[i]->setNeighborhoodRow(i);
+    // As in saveNeighborhood(), NNk_ counts the motion itself, which the graph leaves out
+    nbhGraph_.build(*nn_, motions, nearestK_ ? std::max(NNk_, 1u) : 0, NNr_, numThreads_);
+}
+
 // Calculate the unit ball volume for a given dimension
 double ompl::geometric::FMT::calculateUnitBallVolume(const unsigned int dimension) const
 {
@@ -211,30 +241,69 @@ double ompl::geometric::FMT::calculateRadius(const unsigned int dimension, const
 
 void ompl::geometric::FMT::sampleFree(const base::PlannerTerminationCondition &ptc)
 {
-    unsigned int nodeCount = 0;
-    unsigned int sampleAttempts = 0;
-    auto *motion = new Motion(si_);
-
-    // Sample numSamples_ number of nodes from the free configuration space
-    while (nodeCount < numSamples_ && !ptc)
+    // Each thread samples with its own sampler, created here so the seeds they get do not depend on thread scheduling
+    std::vector<base::StateSamplerPtr> samplers(1, sampler_);
+    for (unsigned int t = 1; t < numThreads_; ++t)
+        samplers.push_back(si_->allocStateSampler());
+    std::vector<std::vector<Motion *>> found(numThreads_);
+    std::vector<unsigned int> sampleAttempts(numThreads_, 0u);
+    std::atomic<unsigned int> nodeCount(0u);
+
+    // Sample numSamples_ number of nodes from the free configuration space, a batch at a time
+    auto work = [&](unsigned int t)
     {
-        sampler_->sampleUniform(motion->getState());
-        sampleAttempts++;
-
-        bool collision_free = si_->isValid(motion->getState());
-
-        if (collision_free)
+        std::vector<Motion *> motions;
+        std::vector<Motion *> spare;
+        std::vector<base::State *> states;
+        unsigned int count;
+        while ((count = nodeCount) < numSamples_ && !ptc)
         {
-            nodeCount++;
-            nn_->add(motion);
-            motion = new Motion(si_);
-        }  // If collision free
-    }      // While nodeCount < numSamples
-    si_->freeState(motion->getState());
-    delete motion;
+            const std::size_t batchSize = std::min<std::size_t>(magic::SAMPLE_BATCH_SIZE, numSamples_ - count);
+            while (motions.size() < batchSize)
+                motions.push_back(new Motion(si_));
+            states.resize(batchSize);
+            for (std::size_t i = 0; i < batchSize; ++i)
+                states[i] = motions[i]->getState();
+
+            samplers[t]->sampleUniformBatch(states.data(), batchSize);
+            sampleAttempts[t] += batchSize;
+
+            // Keep the collision free samples that are still needed; the other motions are reused for the next batch
+            spare.clear();
+            for (std::size_t i = 0; i < batchSize; ++i)
+            {
+                if (si_->isValid(motions[i]->getState()) && nodeCount++ < numSamples_)
+                    found[t].push_back(motions[i]);
+                else
+                    spare.push_back(motions[i]);
+            }
+            spare.insert(spare.end(), motions.begin() + batchSize, motions.end());
+            motions.swap(spare);
+        }  // While nodeCount < numSamples
+        for (auto &motion : motions)
+        {
+            si_->freeState(motion->getState());
+            delete motion;
+        }
+    };
+    std::vector<std::thread> threads;
+    for (unsigned int t = 1; t < numThreads_; ++t)
+        threads.emplace_back(work, t);
+    work(0);
+    for (auto &thread : threads)
+        thread.join();
+
+    unsigned int totalFound = 0;
+    unsigned int totalAttempts = 0;
+    for (unsigned int t = 0; t < numThreads_; ++t)
+    {
+        nn_->add(found[t]);
+        totalFound += found[t].size();
+        totalAttempts += sampleAttempts[t];
+    }
 
     // 95% confidence limit for an upper bound for the true free space volume
-    freeSpaceVolume_ = boost::math::binomial_distribution<>::find_upper_bound_on_p(sampleAttempts, nodeCount, 0.05) *
+    freeSpaceVolume_ = boost::math::binomial_distribution<>::find_upper_bound_on_p(totalAttempts, totalFound, 0.05) *
                        si_->getStateSpace()->getMeasure();
 }
 
@@ -337,6 +406,10 @@ ompl::base::PlannerStatus ompl::geometric::FMT::solve(const base::PlannerTermina
         OMPL_DEBUG("Using radius of %f", NNr_);
     }
 
+    // With several threads, compute all the neighborhoods up front
+    if (numThreads_ > 1)
+        buildNeighborhoodGraph();
+
     // Execute the planner, and return early if the planner returns a failure
     bool plannerSuccess = false;
     bool successfulExpansion = false;
@@ -389,7 +462,7 @@ ompl::base::PlannerStatus ompl::geometric::FMT::solve(const base::PlannerTermina
                             // Relies on NN datastructure returning k-nearest in sorted order
                             const base::Cost connCost = opt_->motionCost(j->getState(), m->getState());
                             const base::Cost worstCost =
-                                opt_->motionCost(neighborhoods_[j].back()->getState(), j->getState());
+                                opt_->motionCost(getNeighborhood(j).back()->getState(), j->getState());
 
                             if (opt_->isCostBetterThan(worstCost, connCost))
                                 continue;
@@ -500,7 +573,7 @@ bool ompl::geometric::FMT::expandTreeFromNode(Motion **z)
     // Find all nodes that are near z, and also in set Unvisited
 
     std::vector<Motion *> xNear;
-    const std::vector<Motion *> &zNeighborhood = neighborhoods_[*z];
+    const Neighborhood zNeighborhood = getNeighborhood(*z);
     const unsigned int zNeighborhoodSize = zNeighborhood.size();
     xNear.reserve(zNeighborhoodSize);
 
@@ -515,7 +588,7 @@ bool ompl::geometric::FMT::expandTreeFromNode(Motion **z)
                 // Only include neighbors that are mutually k-nearest
                 // Relies on NN datastructure returning k-nearest in sorted order
                 const base::Cost connCost = opt_->motionCost((*z)->getState(), x->getState());
-                const base::Cost worstCost = opt_->motionCost(neighborhoods_[x].back()->getState(), x->getState());
+                const base::Cost worstCost = opt_->motionCost(getNeighborhood(x).back()->getState(), x->getState());
 
                 if (opt_->isCostBetterThan(worstCost, connCost))
                     continue;
@@ -535,7 +608,7 @@ bool ompl::geometric::FMT::expandTreeFromNode(Motion **z)
         Motion *x = xNear[i];
 
         // Find all nodes that are near x and in set Open
-        const std::vector<Motion *> &xNeighborhood = neighborhoods_[x];
+        const Neighborhood xNeighborhood = getNeighborhood(x);
 
         const unsigned int xNeighborhoodSize = xNeighborhood.size();
         yNear.reserve(xNeighborhoodSize);
@@ -640,16 +713,23 @@ void ompl::geometric::FMT::updateNeighborhood(Motion *m, const std::vector<Motio
     {
         // If CLOSED, the neighborhood already exists. If neighborhood already exists, we have
         // to insert the node in the corresponding place of the neighborhood of the neighbor of m.
-        if (i->getSetType() == Motion::SET_CLOSED || neighborhoods_.find(i) != neighborhoods_.end())
+        if (i->getSetType() == Motion::SET_CLOSED || i->hasNeighborhoodRow() ||
+            neighborhoods_.find(i) != neighborhoods_.end())
         {
             const base::Cost connCost = opt_->motionCost(i->getState(), m->getState());
-            const base::Cost worstCost = opt_->motionCost(neighborhoods_[i].back()->getState(), i->getState());
+            const base::Cost worstCost = opt_->motionCost(getNeighborhood(i).back()->getState(), i->getState());
 
             if (opt_->isCostBetterThan(worstCost, connCost))
                 continue;
 
-            // Insert the neighbor in the vector in the correct order
-            std::vector<Motion *> &nbhToUpdate = neighborhoods_[i];
+            // Insert the neighbor in the vector in the correct order, copying a precomputed neighborhood first
+            auto it = neighborhoods_.find(i);
+            if (it == neighborhoods_.end())
+            {
+                const Neighborhood row = getNeighborhood(i);
+                it = neighborhoods_.emplace(i, std::vector<Motion *>(row.begin(), row.end())).first;
+            }
+            std::vector<Motion *> &nbhToUpdate = it->second;
             for (std::size_t j = 0; j < nbhToUpdate.size(); ++j)
             {
                 // If connection to the new state is better than the current neighbor tested, insert.
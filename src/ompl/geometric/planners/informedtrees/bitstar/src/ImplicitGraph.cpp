@@ -40,6 +40,8 @@
 // STL/Boost:
 // For std::move
 #include <utility>
+// For std::min
+#include <algorithm>
 // For smart pointers
 #include <memory>
 // For, you know, math
@@ -945,32 +947,84 @@ namespace ompl
                 // Actually generate the new samples
                 VertexPtrVector newStates{};
                 newStates.reserve(numRequiredSamples);
-                for (std::size_t tries = 0u;
-                     tries < averageNumOfAllowedFailedAttemptsWhenSampling_ * numRequiredSamples &&
-                     numSamples_ < numRequiredSamples;
-                     ++tries)
+
+                // If the lower bound of the interval is the minimum possible cost, it does not restrict the samples
+                // and they can be drawn in batches.
+                if (!costHelpPtr_->isCostBetterThan(minCost_, sampledCost_))
                 {
                     // Variable
-                    // The new state:
-                    auto newState =
-                        std::make_shared<Vertex>(spaceInformation_, costHelpPtr_, queuePtr_, approximationId_);
+                    // The number of attempts allowed
+                    const std::size_t maxTries = averageNumOfAllowedFailedAttemptsWhenSampling_ * numRequiredSamples;
 
-                    // Sample in the interval [costSampled_, costReqd):
-                    if (sampler_->sampleUniform(newState->state(), sampledCost_, requiredCost))
+                    for (std::size_t tries = 0u; tries < maxTries && numSamples_ < numRequiredSamples;)
                     {
-                        // If the state is collision free, add it to the set of free states
-                        ++numStateCollisionChecks_;
-                        if (spaceInformation_->isValid(newState->state()))
+                        // Variables
+                        // The number of samples to draw in this batch:
+                        auto batchSize = static_cast<unsigned int>(
+                            std::min<std::size_t>(numRequiredSamples - numSamples_, maxTries - tries));
+                        // The new vertices and their states:
+                        VertexPtrVector candidates;
+                        std::vector<ompl::base::State *> candidateStates;
+                        candidates.reserve(batchSize);
+                        candidateStates.reserve(batchSize);
+                        for (unsigned int i = 0u; i < batchSize; ++i)
+                        {
+                            candidates.push_back(
+                                std::make_shared<Vertex>(spaceInformation_, costHelpPtr_, queuePtr_, approximationId_));
+                            candidateStates.push_back(candidates.back()->state());
+                        }
+
+                        // Sample in the interval [costSampled_, costReqd), which fills the first states in order:
+                        unsigned int numSampled = sampler_->sampleUniformBatch(candidateStates, batchSize, requiredCost);
+                        tries += batchSize;
+
+                        for (unsigned int i = 0u; i < numSampled; ++i)
                         {
-                            newStates.push_back(newState);
+                            // If the state is collision free, add it to the set of free states
+                            ++numStateCollisionChecks_;
+                            if (spaceInformation_->isValid(candidates.at(i)->state()))
+                            {
+                                newStates.push_back(candidates.at(i));
 
-                            // Update the number of uniformly distributed states
-                            ++numUniformStates_;
+                                // Update the number of uniformly distributed states
+                                ++numUniformStates_;
 
-                            // Update the number of sample
-                            ++numSamples_;
+                                // Update the number of sample
+                                ++numSamples_;
+                            }
+                            // No else
+                        }
+                    }
+                }
+                else
+                {
+                    for (std::size_t tries = 0u;
+                         tries < averageNumOfAllowedFailedAttemptsWhenSampling_ * numRequiredSamples &&
+                         numSamples_ < numRequiredSamples;
+                         ++tries)
+                    {
+                        // Variable
+                        // The new state:
+                        auto newState =
+                            std::make_shared<Vertex>(spaceInformation_, costHelpPtr_, queuePtr_, approximationId_);
+
+                        // Sample in the interval [costSampled_, costReqd):
+                        if (sampler_->sampleUniform(newState->state(), sampledCost_, requiredCost))
+                        {
+                            // If the state is collision free, add it to the set of free states
+                            ++numStateCollisionChecks_;
+                            if (spaceInformation_->isValid(newState->state()))
+                            {
+                                newStates.push_back(newState);
+
+                                // Update the number of uniformly distributed states
+                                ++numUniformStates_;
+
+                                // Update the number of sample
+                                ++numSamples_;
+                            }
+                            // No else
                         }
-                        // No else
                     }
                 }
 
@@ -39,11 +39,13 @@
 
 #include "ompl/geometric/planners/PlannerIncludes.h"
 #include "ompl/datastructures/NearestNeighbors.h"
+#include "ompl/datastructures/LPAstarOnGraph.h"
 #include <boost/graph/graph_traits.hpp>
 #include <boost/graph/adjacency_list.hpp>
 #include <utility>
 #include <vector>
 #include <map>
+#include <memory>
 
 namespace ompl
 {
@@ -220,6 +222,39 @@ namespace ompl
                 connectionFilter_ = connectionFilter;
             }
 
+            /** \brief Repair the shortest path incrementally (with LPA*) when
+                edges and milestones are invalidated or added during solve(),
+                instead of running a new A* search every time. The incremental
+                search adds up edge costs, so it assumes an optimization
+                objective that combines costs by addition and prefers smaller
+                costs, such as path length. */
+            void setIncrementalSearch(bool incremental)
+            {
+                incrementalSearch_ = incremental;
+                incrementalSearchTree_.reset();
+            }
+
+            /** \brief Return true if the shortest path is repaired incrementally */
+            bool getIncrementalSearch() const
+            {
+                return incrementalSearch_;
+            }
+
+            /** \brief When checking the edges of a candidate path, check the
+                edges with the largest cost first, since they are the most
+                likely to be invalid. By default, edges are checked from the
+                goal to the start. */
+            void setCheckCostliestEdgesFirst(bool costliestFirst)
+            {
+                checkCostliestEdgesFirst_ = costliestFirst;
+            }
+
+            /** \brief Return true if the costliest edges of a candidate path are checked first */
+            bool getCheckCostliestEdgesFirst() const
+            {
+                return checkCostliestEdgesFirst_;
+            }
+
             /** \brief Return the number of milestones currently in the graph */
             unsigned long int milestoneCount() const
             {
@@ -295,6 +330,17 @@ namespace ompl
              * it as the solution */
             ompl::base::PathPtr constructSolution(const Vertex &start, const Vertex &goal);
 
+            /** \brief Compute a shortest path from \e start to \e goal in the roadmap, without checking its
+                validity. The vertices of the path are stored in \e path, from the goal to the start. False is
+                returned if the two milestones are not connected. */
+            bool shortestPath(const Vertex &start, const Vertex &goal, std::vector<Vertex> &path);
+
+            /** \brief Remove the edge \e e between \e u and \e v from the roadmap (not from the components) */
+            void removeRoadmapEdge(const Edge &e, const Vertex &u, const Vertex &v);
+
+            /** \brief Remove milestone \e v and its edges from the roadmap (not from the components) */
+            void removeRoadmapMilestone(const Vertex &v);
+
             /** \brief Compute distance between two milestones (this is simply distance between the states of the
              * milestones) */
             double distanceFunction(const Vertex a, const Vertex b) const
@@ -306,6 +352,37 @@ namespace ompl
                 This method wraps OptimizationObjective::motionCostHeuristic */
             base::Cost costHeuristic(Vertex u, Vertex v) const;
 
+            /** \brief Heuristic estimate of the cost to go to the goal of the incremental search */
+            struct CostToGoHeuristic
+            {
+                double operator()(Vertex v) const
+                {
+                    return planner->costHeuristic(v, goal).value();
+                }
+
+                const LazyPRM *planner;
+                Vertex goal;
+            };
+
+            /** \brief Incremental shortest path search on the roadmap */
+            using IncrementalSearch = LPAstarOnGraph<Graph, CostToGoHeuristic>;
+
+            /** \brief Flag indicating whether shortest paths are repaired incrementally */
+            bool incrementalSearch_{false};
+
+            /** \brief Flag indicating whether the costliest edges of a candidate path are checked first */
+            bool checkCostliestEdgesFirst_{false};
+
+            /** \brief The heuristic of the incremental search */
+            CostToGoHeuristic incrementalSearchHeuristic_{nullptr, nullptr};
+
+            /** \brief The start milestone of the incremental search */
+            Vertex incrementalSearchStart_{nullptr};
+
+            /** \brief The incremental search from incrementalSearchStart_ to incrementalSearchHeuristic_.goal,
+                kept up to date with the changes to the roadmap. Null when there is no search in progress. */
+            std::unique_ptr<IncrementalSearch> incrementalSearchTree_;
+
             /** \brief Flag indicating whether the default connection strategy is the Star strategy */
             bool starStrategy_;
 
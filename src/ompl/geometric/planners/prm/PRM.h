@@ -203,6 +203,16 @@ namespace ompl
 
             void getPlannerData(base::PlannerData &data) const override;
 
+            /** \brief Fill \e data with every vertex of the roadmap, in the
+                order they were added, and both directions of every edge,
+                weighted by the edge costs. */
+            void getCompactPlannerData(base::CompactPlannerData &data) const override;
+
+            /** \brief Replace the roadmap by the vertices and edges of \e
+                data, keeping the edge weights. Both directions of an edge
+                become a single roadmap edge. The query is cleared. */
+            bool setCompactPlannerData(const base::CompactPlannerData &data) override;
+
             /** \brief While the termination condition allows, this function will construct the roadmap (using
                growRoadmap() and expandRoadmap(),
                 maintaining a 2:1 ratio for growing/expansion of roadmap) */
@@ -243,6 +253,22 @@ namespace ompl
                 using the clearQuery() function. */
             base::PlannerStatus solve(const base::PlannerTerminationCondition &ptc) override;
 
+            /** \brief Answer many queries at once using the current
+                roadmap, which is not modified. Query \e i asks for a path
+                from queries[i].first to queries[i].second: each of the two
+                states is connected to the milestones the connection
+                strategy chooses for it, and the best path between them is
+                found with A* in the roadmap. solutions[i] is set to the
+                path, or to nullptr if the query could not be answered.
+
+                The queries are split among \e numThreads threads (one per
+                hardware thread if 0), each with its own search buffers, so
+                the state validity checker, the motion validator and the
+                optimization objective must be safe to call concurrently.
+                Returns the number of queries answered. */
+            unsigned int solveBatch(const std::vector<std::pair<const base::State *, const base::State *>> &queries,
+                                    std::vector<base::PathPtr> &solutions, unsigned int numThreads = 0);
+
             /** \brief Clear the query previously loaded from the ProblemDefinition.
                 Subsequent calls to solve() will reuse the previously computed roadmap,
                 but will clear the set of input states constructed by the previous call to solve().
@@ -308,7 +334,9 @@ namespace ompl
 
             /** \brief Randomly sample the state space, add and connect milestones
                  in the roadmap. Stop this process when the termination condition
-                 \e ptc returns true.  Use \e workState as temporary memory. */
+                 \e ptc returns true. Valid states are sampled a batch at a time;
+                 the ones not yet added when \e ptc returns true are kept for the
+                 next call. \e workState is not used. */
             void growRoadmap(const base::PlannerTerminationCondition &ptc, base::State *workState);
 
             /** \brief Attempt to connect disjoint components in the
@@ -336,6 +364,18 @@ namespace ompl
              * it as the solution */
             base::PathPtr constructSolution(const Vertex &start, const Vertex &goal);
 
+            /** \brief The search buffers of one thread of solveBatch() */
+            struct BatchSearch;
+
+            /** \brief Answer one query of solveBatch(): connect \e start to the milestones \e startNeighbors and
+                \e goal to the milestones \e goalNeighbors, and search the roadmap for the best path between them.
+                \e components holds the connected component of every milestone. */
+            base::PathPtr solveBatchQuery(const base::State *start, const base::State *goal,
+                                          const std::vector<Vertex> &startNeighbors,
+                                          const std::vector<Vertex> &goalNeighbors,
+                                          const std::vector<Vertex> &components,
+                                          const base::OptimizationObjective &opt, BatchSearch &search) const;
+
             /** \brief Given two vertices, returns a heuristic on the cost of the path connecting them.
                 This method wraps OptimizationObjective::motionCostHeuristic */
             base::Cost costHeuristic(Vertex u, Vertex v) const;
@@ -372,6 +412,16 @@ namespace ompl
             /** \brief Sampler user for generating valid samples in the state space */
             base::ValidStateSamplerPtr sampler_;
 
+            /** \brief Valid states sampled by growRoadmap(); the ones from validSamplesNext_ to validSamplesFound_
+                are not in the roadmap yet */
+            std::vector<base::State *> validSamples_;
+
+            /** \brief The next state of validSamples_ to add to the roadmap */
+            std::size_t validSamplesNext_{0};
+
+            /** \brief The number of valid states at the front of validSamples_ */
+            std::size_t validSamplesFound_{0};
+
             /** \brief Sampler user for generating random in the state space */
             base::StateSamplerPtr simpleSampler_;
 
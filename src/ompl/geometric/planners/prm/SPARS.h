@@ -43,6 +43,7 @@
 #include "ompl/util/Time.h"
 
 #include <boost/range/adaptor/map.hpp>
+#include <algorithm>
 #include <unordered_map>
 #include <boost/graph/graph_traits.hpp>
 #include <boost/graph/adjacency_list.hpp>
@@ -198,6 +199,25 @@ namespace ompl
 
             void getPlannerData(base::PlannerData &data) const override;
 
+            /** \brief Set the number of threads that construct the roadmaps. With
+                more than one thread, samples are generated in batches: the
+                threads sample the states and check the motions to the dense
+                milestones and guards around them in parallel, and the samples
+                are then added to the roadmaps one at a time, as with a single
+                thread. Only the motions to milestones and guards added since
+                the batch started are checked while adding. The state validity
+                checker needs to be thread safe. The default value is 1. */
+            void setNumThreads(unsigned int numThreads)
+            {
+                numThreads_ = std::max(1u, numThreads);
+            }
+
+            /** \brief Get the number of threads that construct the roadmaps */
+            unsigned int getNumThreads() const
+            {
+                return numThreads_;
+            }
+
             /** \brief While the termination condition permits, construct the spanner graph */
             void constructRoadmap(const base::PlannerTerminationCondition &ptc);
 
@@ -367,9 +387,47 @@ namespace ompl
             }
 
         protected:
+            /** \brief A sample generated in parallel when constructing the
+                roadmaps with several threads, with the motion checks computed
+                for it against the roadmaps as they were when its batch started */
+            struct BatchSample
+            {
+                /** \brief The sample; nullptr if no valid state was found */
+                base::State *state{nullptr};
+
+                /** \brief The milestones the connection strategy selects for \e state */
+                std::vector<std::pair<DenseVertex, base::State *>> denseNeighbors;
+
+                /** \brief The guards within sparseDelta_ of \e state */
+                std::vector<std::pair<SparseVertex, base::State *>> sparseNeighbors;
+
+                /** \brief The results of the motion checks from \e state to a milestone */
+                std::map<DenseVertex, bool> denseMotions;
+
+                /** \brief The results of the motion checks from \e state to a guard */
+                std::map<SparseVertex, bool> sparseMotions;
+            };
+
             /** \brief Attempt to add a single sample to the roadmap. */
             DenseVertex addSample(base::State *workState, const base::PlannerTerminationCondition &ptc);
 
+            /** \brief Construct the roadmaps with numThreads_ threads, in batches of samples */
+            void constructRoadmapParallel(const base::PlannerTerminationCondition &ptc);
+
+            /** \brief Runs the coverage, connectivity, interface and quality checks for the milestone q, whose state
+             * is \e workState, adding to the spanner as needed */
+            void checkAddSample(DenseVertex q, base::State *workState, std::vector<SparseVertex> &graphNeighborhood,
+                                std::vector<SparseVertex> &visibleNeighborhood,
+                                std::vector<DenseVertex> &interfaceNeighborhood);
+
+            /** \brief Check the motion from \e st to milestone \e v, using the result computed for batchSample_ if
+             * there is one */
+            bool checkDenseMotion(const base::State *st, DenseVertex v) const;
+
+            /** \brief Check the motion from \e st to guard \e v, using the result computed for batchSample_ if
+             * there is one */
+            bool checkSparseMotion(const base::State *st, SparseVertex v) const;
+
             /** \brief Check that the query vertex is initialized (used for internal nearest neighbor searches) */
             void checkQueryStateInitialization();
 
@@ -549,6 +607,12 @@ namespace ompl
             /** \brief The maximum number of failures before terminating the algorithm */
             unsigned int maxFailures_{1000u};
 
+            /** \brief The number of threads that construct the roadmaps */
+            unsigned int numThreads_{1u};
+
+            /** \brief The sample being added by constructRoadmapParallel(), if any */
+            const BatchSample *batchSample_{nullptr};
+
             /** \brief A flag indicating that a solution has been added during solve() */
             bool addedSolution_{false};
 
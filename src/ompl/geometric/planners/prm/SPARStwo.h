@@ -44,6 +44,7 @@
 #include "ompl/util/Hash.h"
 
 #include <boost/range/adaptor/map.hpp>
+#include <algorithm>
 #include <unordered_map>
 #include <boost/graph/graph_traits.hpp>
 #include <boost/graph/adjacency_list.hpp>
@@ -278,6 +279,25 @@ namespace ompl
                 return stretchFactor_;
             }
 
+            /** \brief Set the number of threads that construct the spanner. With
+                more than one thread, samples are generated in batches: the
+                threads sample the states and check the motions to the guards
+                around them in parallel, and the samples are then added to the
+                spanner one at a time, as with a single thread. Only the motions
+                to guards added since the batch started are checked while
+                adding. The state validity checker needs to be thread safe. The
+                default value is 1. */
+            void setNumThreads(unsigned int numThreads)
+            {
+                numThreads_ = std::max(1u, numThreads);
+            }
+
+            /** \brief Get the number of threads that construct the spanner */
+            unsigned int getNumThreads() const
+            {
+                return numThreads_;
+            }
+
             /** \brief While the termination condition permits, construct the spanner graph */
             void constructRoadmap(const base::PlannerTerminationCondition &ptc);
 
@@ -351,9 +371,44 @@ namespace ompl
             }
 
         protected:
+            /** \brief A sample generated in parallel when constructing the
+                spanner with several threads, with the motion checks computed
+                for it against the spanner as it was when its batch started */
+            struct BatchSample
+            {
+                /** \brief The sample; nullptr if no valid state was found */
+                base::State *state{nullptr};
+
+                /** \brief The guards within sparseDelta_ of \e state, closest first */
+                std::vector<std::pair<Vertex, base::State *>> neighbors;
+
+                /** \brief The states near \e state used to detect interfaces,
+                    sampled only if \e state sees some guard */
+                std::vector<base::State *> nearStates;
+
+                /** \brief The guards within sparseDelta_ of each of \e nearStates, closest first */
+                std::vector<std::vector<std::pair<Vertex, base::State *>>> nearNeighbors;
+
+                /** \brief The results of the motion checks from \e state or one
+                    of \e nearStates to a guard */
+                std::map<std::pair<const base::State *, Vertex>, bool> motions;
+            };
+
             /** \brief Free all the memory allocated by the planner */
             void freeMemory();
 
+            /** \brief Construct the spanner with numThreads_ threads, in batches of samples */
+            void constructRoadmapParallel(const base::PlannerTerminationCondition &ptc);
+
+            /** \brief Runs the coverage, connectivity, interface and quality checks for the sample qNew, adding to
+             * the spanner as needed */
+            void checkAddSample(base::State *qNew, base::State *workState, std::vector<Vertex> &graphNeighborhood,
+                                std::vector<Vertex> &visibleNeighborhood, const base::PlannerTerminationCondition &ptc);
+
+            /** \brief Check the motion from \e st to guard \e v, using the result computed for batchSample_ if
+             * there is one */
+            bool checkMotion(const base::State *st, Vertex v) const;
+
             /** \brief Check that the query vertex is initialized (used for internal nearest neighbor searches) */
             void checkQueryStateInitialization();
 
@@ -483,6 +538,12 @@ namespace ompl
             /** \brief Number of sample points to use when trying to detect interfaces. */
             unsigned int nearSamplePoints_;
 
+            /** \brief The number of threads that construct the spanner */
+            unsigned int numThreads_{1u};
+
+            /** \brief The sample being added by constructRoadmapParallel(), if any */
+            const BatchSample *batchSample_{nullptr};
+
             /** \brief Access to the internal base::state at each Vertex */
             boost::property_map<Graph, vertex_state_t>::type stateProperty_;
 
@@ -43,6 +43,8 @@
 #include <boost/graph/incremental_components.hpp>
 #include <boost/graph/lookup_edge.hpp>
 #include <boost/foreach.hpp>
+#include <algorithm>
+#include <numeric>
 #include <queue>
 
 #include "GoalVisitor.hpp"
@@ -82,6 +84,10 @@ ompl::geometric::LazyPRM::LazyPRM(const base::SpaceInformationPtr &si, bool star
     if (!starStrategy_)
         Planner::declareParam<unsigned int>("max_nearest_neighbors", this, &LazyPRM::setMaxNearestNeighbors,
                                             std::string("8:1000"));
+    Planner::declareParam<bool>("incremental_search", this, &LazyPRM::setIncrementalSearch,
+                                &LazyPRM::getIncrementalSearch, "0,1");
+    Planner::declareParam<bool>("check_costliest_edges_first", this, &LazyPRM::setCheckCostliestEdgesFirst,
+                                &LazyPRM::getCheckCostliestEdgesFirst, "0,1");
 
     addPlannerProgressProperty("iterations INTEGER", [this]
                                {
@@ -249,6 +255,7 @@ void ompl::geometric::LazyPRM::setProblemDefinition(const base::ProblemDefinitio
 
 void ompl::geometric::LazyPRM::clearQuery()
 {
+    incrementalSearchTree_.reset();
     startM_.clear();
     goalM_.clear();
     pis_.restart();
@@ -277,6 +284,7 @@ void ompl::geometric::LazyPRM::clear()
 
 void ompl::geometric::LazyPRM::freeMemory()
 {
+    incrementalSearchTree_.reset();
     foreach (Vertex v, boost::vertices(g_))
         si_->freeState(stateProperty_[v]);
     g_.clear();
@@ -301,6 +309,11 @@ ompl::geometric::LazyPRM::Vertex ompl::geometric::LazyPRM::addMilestone(base::St
             const Edge &e = boost::add_edge(m, n, properties, g_).first;
             edgeValidityProperty_[e] = VALIDITY_UNKNOWN;
             uniteComponents(m, n);
+            if (incrementalSearchTree_)
+            {
+                incrementalSearchTree_->insertEdge(m, n, weight.value());
+                incrementalSearchTree_->insertEdge(n, m, weight.value());
+            }
         }
 
     nn_->add(m);
@@ -413,6 +426,9 @@ ompl::base::PlannerStatus ompl::geometric::LazyPRM::solve(const base::PlannerTer
 
     si_->freeState(workState);
 
+    // The roadmap may change outside of solve()
+    incrementalSearchTree_.reset();
+
     if (bestSolution)
     {
         base::PlannerSolution psol(bestSolution);
@@ -482,8 +498,27 @@ long int ompl::geometric::LazyPRM::solutionComponent(std::pair<std::size_t, std:
     return -1;
 }
 
-ompl::base::PathPtr ompl::geometric::LazyPRM::constructSolution(const Vertex &start, const Vertex &goal)
+bool ompl::geometric::LazyPRM::shortestPath(const Vertex &start, const Vertex &goal, std::vector<Vertex> &path)
 {
+    path.clear();
+    if (incrementalSearch_)
+    {
+        // Keep the search from the previous call, which was repaired as the roadmap changed
+        if (!incrementalSearchTree_ || incrementalSearchStart_ != start || incrementalSearchHeuristic_.goal != goal)
+        {
+            incrementalSearchTree_.reset();
+            incrementalSearchStart_ = start;
+            incrementalSearchHeuristic_.planner = this;
+            incrementalSearchHeuristic_.goal = goal;
+            incrementalSearchTree_ =
+                std::make_unique<IncrementalSearch>(start, goal, g_, incrementalSearchHeuristic_);
+        }
+        std::list<Vertex> startToGoal;
+        incrementalSearchTree_->computeShortestPath(startToGoal);
+        path.assign(startToGoal.rbegin(), startToGoal.rend());
+        return path.size() > 1;
+    }
+
     // Need to update the index map here, becuse nodes may have been removed and
     // the numbering will not be 0 .. N-1 otherwise.
     unsigned long int index = 0;
@@ -517,6 +552,58 @@ ompl::base::PathPtr ompl::geometric::LazyPRM::constructSolution(const Vertex &st
     {
     }
     if (prev[goal] == goal)
+        return false;
+
+    for (Vertex pos = goal; prev[pos] != pos; pos = prev[pos])
+        path.push_back(pos);
+    path.push_back(start);
+    return true;
+}
+
+void ompl::geometric::LazyPRM::removeRoadmapEdge(const Edge &e, const Vertex &u, const Vertex &v)
+{
+    boost::remove_edge(e, g_);
+    if (incrementalSearchTree_)
+    {
+        // The start is the root of the search and never changes
+        if (v != incrementalSearchStart_)
+            incrementalSearchTree_->removeEdge(u, v);
+        if (u != incrementalSearchStart_)
+            incrementalSearchTree_->removeEdge(v, u);
+    }
+}
+
+void ompl::geometric::LazyPRM::removeRoadmapMilestone(const Vertex &v)
+{
+    std::vector<Vertex> neighbors;
+    if (incrementalSearchTree_)
+    {
+        boost::graph_traits<Graph>::adjacency_iterator nbh, last;
+        for (boost::tie(nbh, last) = boost::adjacent_vertices(v, g_); nbh != last; ++nbh)
+            neighbors.push_back(*nbh);
+    }
+    // Remove vertex from nearest neighbors data structure.
+    nn_->remove(v);
+    // Free vertex state.
+    si_->freeState(stateProperty_[v]);
+    // Remove all edges.
+    boost::clear_vertex(v, g_);
+    if (incrementalSearchTree_)
+    {
+        for (Vertex n : neighbors)
+            if (n != incrementalSearchStart_)
+                incrementalSearchTree_->removeEdge(v, n);
+        incrementalSearchTree_->removeVertex(v);
+    }
+    // Remove the vertex.
+    boost::remove_vertex(v, g_);
+}
+
+ompl::base::PathPtr ompl::geometric::LazyPRM::constructSolution(const Vertex &start, const Vertex &goal)
+{
+    // The vertices of the shortest path, from the goal to the start
+    std::vector<Vertex> path;
+    if (!shortestPath(start, goal, path))
         throw Exception(name_, "Could not find solution path");
 
     // First, get the solution states without copying them, and check them for validity.
@@ -524,8 +611,9 @@ ompl::base::PathPtr ompl::geometric::LazyPRM::constructSolution(const Vertex &st
     // part of the graph (compared to removing an edge).
     std::vector<const base::State *> states(1, stateProperty_[goal]);
     std::set<Vertex> milestonesToRemove;
-    for (Vertex pos = prev[goal]; prev[pos] != pos; pos = prev[pos])
+    for (std::size_t i = 1; i + 1 < path.size(); ++i)
     {
+        const Vertex pos = path[i];
         const base::State *st = stateProperty_[pos];
         unsigned int &vd = vertexValidityProperty_[pos];
         if ((vd & VALIDITY_TRUE) == 0)
@@ -552,14 +640,7 @@ ompl::base::PathPtr ompl::geometric::LazyPRM::constructSolution(const Vertex &st
             for (boost::tie(nbh, last) = boost::adjacent_vertices(*it, g_); nbh != last; ++nbh)
                 if (milestonesToRemove.find(*nbh) == milestonesToRemove.end())
                     neighbors.insert(*nbh);
-            // Remove vertex from nearest neighbors data structure.
-            nn_->remove(*it);
-            // Free vertex state.
-            si_->freeState(stateProperty_[*it]);
-            // Remove all edges.
-            boost::clear_vertex(*it, g_);
-            // Remove the vertex.
-            boost::remove_vertex(*it, g_);
+            removeRoadmapMilestone(*it);
         }
         // Update the connected component ID for neighbors.
         for (auto neighbor : neighbors)
@@ -578,30 +659,34 @@ ompl::base::PathPtr ompl::geometric::LazyPRM::constructSolution(const Vertex &st
     states.push_back(stateProperty_[start]);
 
     // Check the edges too, if the vertices were valid. Remove the first invalid edge only.
-    std::vector<const base::State *>::const_iterator prevState = states.begin(), state = prevState + 1;
-    Vertex prevVertex = goal, pos = prev[goal];
-    do
+    // Edge i connects path[i + 1] to path[i].
+    std::vector<Edge> edges(path.size() - 1);
+    for (std::size_t i = 0; i < edges.size(); ++i)
+        edges[i] = boost::lookup_edge(path[i + 1], path[i], g_).first;
+    std::vector<std::size_t> order(edges.size());
+    std::iota(order.begin(), order.end(), 0);
+    if (checkCostliestEdgesFirst_)
+        std::stable_sort(order.begin(), order.end(), [this, &edges](std::size_t a, std::size_t b)
+                         {
+                             return opt_->isCostBetterThan(weightProperty_[edges[b]], weightProperty_[edges[a]]);
+                         });
+    for (std::size_t i : order)
     {
-        Edge e = boost::lookup_edge(pos, prevVertex, g_).first;
-        unsigned int &evd = edgeValidityProperty_[e];
+        unsigned int &evd = edgeValidityProperty_[edges[i]];
         if ((evd & VALIDITY_TRUE) == 0)
         {
-            if (si_->checkMotion(*state, *prevState))
+            if (si_->checkMotion(states[i + 1], states[i]))
                 evd |= VALIDITY_TRUE;
         }
         if ((evd & VALIDITY_TRUE) == 0)
         {
-            boost::remove_edge(e, g_);
+            removeRoadmapEdge(edges[i], path[i + 1], path[i]);
             unsigned long int newComponent = componentCount_++;
             componentSize_[newComponent] = 0;
-            markComponent(pos, newComponent);
+            markComponent(path[i + 1], newComponent);
             return base::PathPtr();
         }
-        prevState = state;
-        ++state;
-        prevVertex = pos;
-        pos = prev[pos];
-    } while (prevVertex != pos);
+    }
 
     auto p(std::make_shared<PathGeometric>(si_));
     for (std::vector<const base::State *>::const_reverse_iterator st = states.rbegin(); st != states.rend(); ++st)
@@ -45,7 +45,10 @@
 #include <boost/graph/incremental_components.hpp>
 #include <boost/property_map/vector_property_map.hpp>
 #include <boost/foreach.hpp>
+#include <algorithm>
+#include <atomic>
 #include <thread>
+#include <tuple>
 #include <typeinfo>
 
 #include "GoalVisitor.hpp"
@@ -82,6 +85,7 @@ ompl::geometric::PRM::PRM(const base::SpaceInformationPtr &si, bool starStrategy
     specs_.approximateSolutions = true;
     specs_.optimizingPaths = true;
     specs_.multithreaded = true;
+    specs_.canLoadCompactPlannerData = true;
 
     if (!starStrategy_)
         Planner::declareParam<unsigned int>("max_nearest_neighbors", this, &PRM::setMaxNearestNeighbors,
@@ -167,6 +171,9 @@ void ompl::geometric::PRM::setup()
     if (!connectionFilter_)
         connectionFilter_ = [](const Vertex &, const Vertex &) { return true; };
 
+    // drop the valid samples left over from a previous solve
+    validSamplesNext_ = validSamplesFound_ = 0;
+
     // Setup optimization objective
     //
     // If no optimization objective was specified, then default to
@@ -253,6 +260,11 @@ void ompl::geometric::PRM::freeMemory()
     foreach (Vertex v, boost::vertices(g_))
         si_->freeState(stateProperty_[v]);
     g_.clear();
+
+    // the samples may not be valid for a new problem
+    si_->freeStates(validSamples_);
+    validSamples_.clear();
+    validSamplesNext_ = validSamplesFound_ = 0;
 }
 
 void ompl::geometric::PRM::expandRoadmap(double expandTime)
@@ -353,26 +365,35 @@ void ompl::geometric::PRM::growRoadmap(const base::PlannerTerminationCondition &
     si_->freeState(workState);
 }
 
-void ompl::geometric::PRM::growRoadmap(const base::PlannerTerminationCondition &ptc, base::State *workState)
+void ompl::geometric::PRM::growRoadmap(const base::PlannerTerminationCondition &ptc, base::State * /*workState*/)
 {
     /* grow roadmap in the regular fashion -- sample valid states, add them to the roadmap, add valid connections */
+    if (validSamples_.empty())
+    {
+        validSamples_.resize(magic::SAMPLE_BATCH_SIZE);
+        si_->allocStates(validSamples_);
+    }
+
+    // the states left over from the previous call may have been checked by a different validity checker
+    std::size_t kept = validSamplesNext_;
+    for (std::size_t i = validSamplesNext_; i < validSamplesFound_; ++i)
+        if (si_->isValid(validSamples_[i]))
+            std::swap(validSamples_[kept++], validSamples_[i]);
+    validSamplesFound_ = kept;
+
     while (!ptc)
     {
-        iterations_++;
-        // search for a valid state
-        bool found = false;
-        while (!found && !ptc)
+        // search for valid states once the previous batch is used up; what is left of a batch when ptc becomes
+        // true is used by the next call
+        if (validSamplesNext_ == validSamplesFound_)
         {
-            unsigned int attempts = 0;
-            do
-            {
-                found = sampler_->sample(workState);
-                attempts++;
-            } while (attempts < magic::FIND_VALID_STATE_ATTEMPTS_WITHOUT_TERMINATION_CHECK && !found);
+            validSamplesNext_ = 0;
+            validSamplesFound_ = sampler_->sampleBatch(validSamples_.data(), validSamples_.size());
+            continue;
         }
-        // add it as a milestone
-        if (found)
-            addMilestone(si_->cloneState(workState));
+        // add the next one as a milestone; each milestone counts as one iteration
+        iterations_++;
+        addMilestone(si_->cloneState(validSamples_[validSamplesNext_++]));
     }
 }
 
@@ -527,6 +548,186 @@ ompl::base::PlannerStatus ompl::geometric::PRM::solve(const base::PlannerTermina
     return sol ? base::PlannerStatus::EXACT_SOLUTION : base::PlannerStatus::TIMEOUT;
 }
 
+struct ompl::geometric::PRM::BatchSearch
+{
+    BatchSearch(std::size_t milestones)
+      : costs(milestones), parents(milestones), stamps(milestones, 0), costsToGoal(milestones), goalStamps(milestones, 0)
+    {
+    }
+
+    /** \brief The best known cost from the start to each milestone */
+    std::vector<base::Cost> costs;
+
+    /** \brief The predecessor of each milestone on its best known path from the start; the milestones connected to
+        the start are their own predecessors */
+    std::vector<Vertex> parents;
+
+    /** \brief The query in which costs and parents were last set for each milestone; entries of other queries are
+        stale, so the buffers never need to be reset */
+    std::vector<unsigned int> stamps;
+
+    /** \brief The cost from each milestone connected to the goal to the goal */
+    std::vector<base::Cost> costsToGoal;
+
+    /** \brief The query in which costsToGoal was last set for each milestone */
+    std::vector<unsigned int> goalStamps;
+
+    /** \brief The connected components of the milestones connected to the goal */
+    std::vector<Vertex> goalComponents;
+
+    /** \brief The open list of A*: (estimated total cost, cost from the start, milestone), kept as a heap */
+    std::vector<std::tuple<base::Cost, base::Cost, Vertex>> open;
+
+    /** \brief The number of the current query */
+    unsigned int query{0};
+};
+
+unsigned int ompl::geometric::PRM::solveBatch(
+    const std::vector<std::pair<const base::State *, const base::State *>> &queries,
+    std::vector<base::PathPtr> &solutions, unsigned int numThreads)
+{
+    if (!isSetup())
+        setup();
+    solutions.assign(queries.size(), nullptr);
+
+    // The roadmap is not changed until all the queries are answered
+    std::lock_guard<std::mutex> _(graphMutex_);
+    const std::size_t milestones = boost::num_vertices(g_);
+    if (queries.empty() || milestones == 0)
+        return 0;
+
+    base::OptimizationObjectivePtr opt = opt_;
+    if (!opt)
+        opt = std::make_shared<base::PathLengthOptimizationObjective>(si_);
+
+    // find_set() compresses paths in the disjoint sets, so the components are computed before the threads start
+    std::vector<Vertex> components(milestones);
+    foreach (Vertex v, boost::vertices(g_))
+        components[v] = disjointSets_.find_set(v);
+
+    // The milestones each query state is connected to are the ones the connection strategy chooses for a temporary
+    // milestone at that state. The nearest neighbors data structure is not necessarily safe to query concurrently, so
+    // this is done before the threads start as well.
+    std::vector<std::vector<Vertex>> startNeighbors(queries.size());
+    std::vector<std::vector<Vertex>> goalNeighbors(queries.size());
+    Vertex query = boost::add_vertex(g_);
+    for (std::size_t i = 0; i < queries.size(); ++i)
+    {
+        stateProperty_[query] = const_cast<base::State *>(queries[i].first);
+        startNeighbors[i] = connectionStrategy_(query);
+        stateProperty_[query] = const_cast<base::State *>(queries[i].second);
+        goalNeighbors[i] = connectionStrategy_(query);
+    }
+    boost::remove_vertex(query, g_);
+
+    if (numThreads == 0)
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    numThreads = std::min<std::size_t>(numThreads, queries.size());
+
+    std::atomic<std::size_t> next(0);
+    std::atomic<unsigned int> solved(0);
+    auto work = [&]
+    {
+        BatchSearch search(milestones);
+        for (std::size_t i = next++; i < queries.size(); i = next++)
+        {
+            solutions[i] = solveBatchQuery(queries[i].first, queries[i].second, startNeighbors[i], goalNeighbors[i],
+                                           components, *opt, search);
+            if (solutions[i])
+                ++solved;
+        }
+    };
+    std::vector<std::thread> threads;
+    for (unsigned int t = 1; t < numThreads; ++t)
+        threads.emplace_back(work);
+    work();
+    for (auto &thread : threads)
+        thread.join();
+
+    return solved;
+}
+
+ompl::base::PathPtr ompl::geometric::PRM::solveBatchQuery(const base::State *start, const base::State *goal,
+                                                          const std::vector<Vertex> &startNeighbors,
+                                                          const std::vector<Vertex> &goalNeighbors,
+                                                          const std::vector<Vertex> &components,
+                                                          const base::OptimizationObjective &opt,
+                                                          BatchSearch &search) const
+{
+    if (!si_->isValid(start) || !si_->isValid(goal))
+        return nullptr;
+    const unsigned int query = ++search.query;
+
+    search.goalComponents.clear();
+    for (Vertex n : goalNeighbors)
+        if (si_->checkMotion(stateProperty_[n], goal))
+        {
+            search.goalStamps[n] = query;
+            search.costsToGoal[n] = opt.motionCost(stateProperty_[n], goal);
+            search.goalComponents.push_back(components[n]);
+        }
+
+    // The open list is a heap with the smallest estimated total cost on top
+    const auto worse = [&opt](const std::tuple<base::Cost, base::Cost, Vertex> &a,
+                              const std::tuple<base::Cost, base::Cost, Vertex> &b)
+    { return opt.isCostBetterThan(std::get<0>(b), std::get<0>(a)); };
+    const auto reach = [&](Vertex v, Vertex parent, base::Cost cost)
+    {
+        if (search.stamps[v] == query && !opt.isCostBetterThan(cost, search.costs[v]))
+            return;
+        search.stamps[v] = query;
+        search.costs[v] = cost;
+        search.parents[v] = parent;
+        search.open.emplace_back(opt.combineCosts(cost, opt.motionCostHeuristic(stateProperty_[v], goal)), cost, v);
+        std::push_heap(search.open.begin(), search.open.end(), worse);
+    };
+
+    // Only the milestones in the same component as a milestone connected to the goal are worth connecting to the
+    // start
+    search.open.clear();
+    for (Vertex n : startNeighbors)
+        if (std::find(search.goalComponents.begin(), search.goalComponents.end(), components[n]) !=
+                search.goalComponents.end() &&
+            si_->checkMotion(start, stateProperty_[n]))
+            reach(n, n, opt.motionCost(start, stateProperty_[n]));
+
+    base::Cost bestCost = opt.infiniteCost();
+    Vertex last = 0;
+    while (!search.open.empty() && opt.isCostBetterThan(std::get<0>(search.open.front()), bestCost))
+    {
+        std::pop_heap(search.open.begin(), search.open.end(), worse);
+        const Vertex v = std::get<2>(search.open.back());
+        const base::Cost cost = std::get<1>(search.open.back());
+        search.open.pop_back();
+        if (opt.isCostBetterThan(search.costs[v], cost))
+            continue;  // v was reached again with a smaller cost after this entry was added
+
+        if (search.goalStamps[v] == query)
+        {
+            const base::Cost total = opt.combineCosts(cost, search.costsToGoal[v]);
+            if (opt.isCostBetterThan(total, bestCost))
+            {
+                bestCost = total;
+                last = v;
+            }
+        }
+        foreach (const Edge e, boost::out_edges(v, g_))
+            reach(boost::target(e, g_), v, opt.combineCosts(cost, weightProperty_[e]));
+    }
+    if (!opt.isFinite(bestCost))
+        return nullptr;
+
+    auto p(std::make_shared<PathGeometric>(si_));
+    p->append(goal);
+    Vertex pos = last;
+    for (; search.parents[pos] != pos; pos = search.parents[pos])
+        p->append(stateProperty_[pos]);
+    p->append(stateProperty_[pos]);
+    p->append(start);
+    p->reverse();
+    return p;
+}
+
 void ompl::geometric::PRM::constructRoadmap(const base::PlannerTerminationCondition &ptc)
 {
     if (!isSetup())
@@ -747,6 +948,85 @@ void ompl::geometric::PRM::getPlannerData(base::PlannerData &data) const
     }
 }
 
+void ompl::geometric::PRM::getCompactPlannerData(base::CompactPlannerData &data) const
+{
+    data.clear();
+    for (const auto &plannerProgressProperty : plannerProgressProperties_)
+        data.properties[plannerProgressProperty.first] = plannerProgressProperty.second();
+
+    // Vertex descriptors are indexes, so they are also the indexes in data
+    auto &disjointSets = const_cast<PRM *>(this)->disjointSets_;
+    data.reserve(boost::num_vertices(g_), 2 * boost::num_edges(g_));
+    foreach (Vertex v, boost::vertices(g_))
+        data.addVertex(stateProperty_[v], disjointSets.find_set(v));
+    for (unsigned long i : startM_)
+        data.markStartVertex(i);
+    for (unsigned long i : goalM_)
+        data.markGoalVertex(i);
+
+    // Add both directions of each edge, since we're exporting an undirected roadmap
+    foreach (const Edge e, boost::edges(g_))
+    {
+        const Vertex v1 = boost::source(e, g_);
+        const Vertex v2 = boost::target(e, g_);
+        data.addEdge(v1, v2, weightProperty_[e]);
+        data.addEdge(v2, v1, weightProperty_[e]);
+    }
+}
+
+bool ompl::geometric::PRM::setCompactPlannerData(const base::CompactPlannerData &data)
+{
+    freeMemory();
+    if (nn_)
+        nn_->clear();
+    else
+    {
+        specs_.multithreaded = false;  // temporarily set to false since nn_ is used only in single thread
+        nn_.reset(tools::SelfConfig::getDefaultNearestNeighbors<Vertex>(this));
+        specs_.multithreaded = true;
+        nn_->setDistanceFunction([this](const Vertex a, const Vertex b) { return distanceFunction(a, b); });
+    }
+    clearQuery();
+
+    std::lock_guard<std::mutex> _(graphMutex_);
+
+    // Vertex descriptors are indexes, so they are also the indexes in data
+    std::vector<Vertex> milestones(data.numVertices());
+    for (unsigned int i = 0; i < data.numVertices(); ++i)
+    {
+        Vertex m = boost::add_vertex(g_);
+        stateProperty_[m] = si_->cloneState(data.getState(i));
+        totalConnectionAttemptsProperty_[m] = 1;
+        successfulConnectionAttemptsProperty_[m] = 0;
+        disjointSets_.make_set(m);
+        milestones[i] = m;
+    }
+
+    for (unsigned int i = 0; i < data.numVertices(); ++i)
+    {
+        const unsigned int *targets;
+        const float *weights;
+        const unsigned int degree = data.getEdges(i, targets, weights);
+        for (unsigned int j = 0; j < degree; ++j)
+        {
+            // Add an edge once, from its smaller endpoint if it is stored in both directions
+            const unsigned int k = targets[j];
+            if (k == i || (k < i && data.edgeExists(k, i)))
+                continue;
+            totalConnectionAttemptsProperty_[i]++;
+            totalConnectionAttemptsProperty_[k]++;
+            successfulConnectionAttemptsProperty_[i]++;
+            successfulConnectionAttemptsProperty_[k]++;
+            const Graph::edge_property_type properties(base::Cost(weights[j]));
+            boost::add_edge(i, k, properties, g_);
+            uniteComponents(i, k);
+        }
+    }
+
+    nn_->add(milestones);
+    return true;
+}
+
 ompl::base::Cost ompl::geometric::PRM::costHeuristic(Vertex u, Vertex v) const
 {
     return opt_->motionCostHeuristic(stateProperty_[u], stateProperty_[v]);
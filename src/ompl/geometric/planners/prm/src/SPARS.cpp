@@ -40,6 +40,7 @@
 #include "ompl/base/objectives/PathLengthOptimizationObjective.h"
 #include "ompl/tools/config/SelfConfig.h"
 #include "ompl/tools/config/MagicConstants.h"
+#include <atomic>
 #include <thread>
 #include <boost/graph/astar_search.hpp>
 #include <boost/graph/incremental_components.hpp>
@@ -79,6 +80,7 @@ ompl::geometric::SPARS::SPARS(const base::SpaceInformationPtr &si)
                                   &SPARS::getDenseDeltaFraction, "0.0:0.0001:0.1");
     Planner::declareParam<unsigned int>("max_failures", this, &SPARS::setMaxFailures, &SPARS::getMaxFailures, "100:10:"
                                                                                                               "3000");
+    Planner::declareParam<unsigned int>("num_threads", this, &SPARS::setNumThreads, &SPARS::getNumThreads, "1:1:64");
 
     addPlannerProgressProperty("iterations INTEGER", [this]
                                {
@@ -421,6 +423,13 @@ void ompl::geometric::SPARS::constructRoadmap(const base::PlannerTerminationCond
     if (!sampler_)
         sampler_ = si_->allocValidStateSampler();
 
+    bestCost_ = opt_->infiniteCost();
+    if (numThreads_ > 1)
+    {
+        constructRoadmapParallel(ptc);
+        return;
+    }
+
     base::State *workState = si_->allocState();
 
     /* The whole neighborhood set which has been most recently computed */
@@ -432,7 +441,6 @@ void ompl::geometric::SPARS::constructRoadmap(const base::PlannerTerminationCond
     /* Storage for the interface neighborhood, populated by getInterfaceNeighborhood() */
     std::vector<DenseVertex> interfaceNeighborhood;
 
-    bestCost_ = opt_->infiniteCost();
     while (!ptc)
     {
         iterations_++;
@@ -442,33 +450,171 @@ void ompl::geometric::SPARS::constructRoadmap(const base::PlannerTerminationCond
         if (q == boost::graph_traits<DenseGraph>::null_vertex())
             continue;
 
-        // Now that we've added to D, try adding to S
-        // Start by figuring out who our neighbors are
-        getSparseNeighbors(workState, graphNeighborhood);
-        filterVisibleNeighbors(workState, graphNeighborhood, visibleNeighborhood);
-        // Check for addition for Coverage
-        if (!checkAddCoverage(workState, graphNeighborhood))
-            // If not for Coverage, then Connectivity
-            if (!checkAddConnectivity(workState, graphNeighborhood))
-                // Check for the existence of an interface
-                if (!checkAddInterface(graphNeighborhood, visibleNeighborhood, q))
+        checkAddSample(q, workState, graphNeighborhood, visibleNeighborhood, interfaceNeighborhood);
+    }
+
+    si_->freeState(workState);
+}
+
+void ompl::geometric::SPARS::constructRoadmapParallel(const base::PlannerTerminationCondition &ptc)
+{
+    // Each thread has its own sampler
+    std::vector<base::ValidStateSamplerPtr> samplers(numThreads_);
+    samplers[0] = sampler_;
+    for (unsigned int t = 1; t < numThreads_; ++t)
+        samplers[t] = si_->allocValidStateSampler();
+
+    // A few samples per thread, so the threads stay busy while the batch is small enough that few milestones become
+    // neighbors of others in the same batch
+    std::vector<BatchSample> batch(8 * numThreads_);
+    auto parallelForEach = [this, &batch](const std::function<void(unsigned int, BatchSample &)> &work)
+    {
+        std::atomic<std::size_t> next(0);
+        auto run = [&batch, &work, &next](unsigned int t)
+        {
+            for (std::size_t i = next++; i < batch.size(); i = next++)
+                work(t, batch[i]);
+        };
+        std::vector<std::thread> threads;
+        for (unsigned int t = 1; t < numThreads_; ++t)
+            threads.emplace_back(run, t);
+        run(0);
+        for (auto &thread : threads)
+            thread.join();
+    };
+
+    std::vector<SparseVertex> graphNeighborhood;
+    std::vector<SparseVertex> visibleNeighborhood;
+    std::vector<DenseVertex> interfaceNeighborhood;
+
+    while (!ptc)
+    {
+        parallelForEach([this, &samplers, &ptc](unsigned int t, BatchSample &sample)
+                        {
+                            sample.state = si_->allocState();
+                            bool found = false;
+                            while (!found && !ptc)
+                            {
+                                unsigned int attempts = 0;
+                                do
+                                {
+                                    found = samplers[t]->sample(sample.state);
+                                    attempts++;
+                                } while (attempts < magic::FIND_VALID_STATE_ATTEMPTS_WITHOUT_TERMINATION_CHECK &&
+                                         !found);
+                            }
+                            if (!found)
+                            {
+                                si_->freeState(sample.state);
+                                sample.state = nullptr;
+                            }
+                        });
+
+        // The neighbors are found through the query vertices, so not in parallel. The threads get the states of the
+        // neighbors, so they do not read the graphs while milestones are added to them.
+        for (auto &sample : batch)
+            if (sample.state != nullptr)
+            {
+                stateProperty_[queryVertex_] = sample.state;
+                for (DenseVertex n : connectionStrategy_(queryVertex_))
+                    if (n != queryVertex_)
+                        sample.denseNeighbors.emplace_back(n, stateProperty_[n]);
+                stateProperty_[queryVertex_] = nullptr;
+
+                getSparseNeighbors(sample.state, graphNeighborhood);
+                for (SparseVertex n : graphNeighborhood)
+                    sample.sparseNeighbors.emplace_back(n, sparseStateProperty_[n]);
+            }
+
+        parallelForEach([this](unsigned int, BatchSample &sample)
+                        {
+                            if (sample.state == nullptr)
+                                return;
+                            for (const auto &n : sample.denseNeighbors)
+                                sample.denseMotions[n.first] = si_->checkMotion(sample.state, n.second);
+                            for (const auto &n : sample.sparseNeighbors)
+                                sample.sparseMotions[n.first] = si_->checkMotion(sample.state, n.second);
+                        });
+
+        // Add the samples one at a time, as with a single thread
+        for (auto &sample : batch)
+        {
+            if (!ptc)
+            {
+                iterations_++;
+                if (sample.state != nullptr)
                 {
-                    // Then check to see if it's on an interface
-                    getInterfaceNeighborhood(q, interfaceNeighborhood);
-                    if (!interfaceNeighborhood.empty())
-                    {
-                        // Check for addition for spanner prop
-                        if (!checkAddPath(q, interfaceNeighborhood))
-                            // All of the tests have failed.  Report failure for the sample
-                            ++consecutiveFailures_;
-                    }
-                    else
-                        // There's no interface here, so drop it
+                    batchSample_ = &sample;
+                    DenseVertex q = addMilestone(sample.state);
+                    checkAddSample(q, sample.state, graphNeighborhood, visibleNeighborhood, interfaceNeighborhood);
+                    batchSample_ = nullptr;
+                    // the state now belongs to the dense graph
+                    sample.state = nullptr;
+                }
+            }
+
+            if (sample.state != nullptr)
+                si_->freeState(sample.state);
+            sample.state = nullptr;
+            sample.denseNeighbors.clear();
+            sample.sparseNeighbors.clear();
+            sample.denseMotions.clear();
+            sample.sparseMotions.clear();
+        }
+    }
+}
+
+void ompl::geometric::SPARS::checkAddSample(DenseVertex q, base::State *workState,
+                                            std::vector<SparseVertex> &graphNeighborhood,
+                                            std::vector<SparseVertex> &visibleNeighborhood,
+                                            std::vector<DenseVertex> &interfaceNeighborhood)
+{
+    // Now that we've added to D, try adding to S
+    // Start by figuring out who our neighbors are
+    getSparseNeighbors(workState, graphNeighborhood);
+    filterVisibleNeighbors(workState, graphNeighborhood, visibleNeighborhood);
+    // Check for addition for Coverage
+    if (!checkAddCoverage(workState, graphNeighborhood))
+        // If not for Coverage, then Connectivity
+        if (!checkAddConnectivity(workState, graphNeighborhood))
+            // Check for the existence of an interface
+            if (!checkAddInterface(graphNeighborhood, visibleNeighborhood, q))
+            {
+                // Then check to see if it's on an interface
+                getInterfaceNeighborhood(q, interfaceNeighborhood);
+                if (!interfaceNeighborhood.empty())
+                {
+                    // Check for addition for spanner prop
+                    if (!checkAddPath(q, interfaceNeighborhood))
+                        // All of the tests have failed.  Report failure for the sample
                         ++consecutiveFailures_;
                 }
+                else
+                    // There's no interface here, so drop it
+                    ++consecutiveFailures_;
+            }
+}
+
+bool ompl::geometric::SPARS::checkDenseMotion(const base::State *st, DenseVertex v) const
+{
+    if (batchSample_ != nullptr && batchSample_->state == st)
+    {
+        auto it = batchSample_->denseMotions.find(v);
+        if (it != batchSample_->denseMotions.end())
+            return it->second;
     }
+    return si_->checkMotion(st, stateProperty_[v]);
+}
 
-    si_->freeState(workState);
+bool ompl::geometric::SPARS::checkSparseMotion(const base::State *st, SparseVertex v) const
+{
+    if (batchSample_ != nullptr && batchSample_->state == st)
+    {
+        auto it = batchSample_->sparseMotions.find(v);
+        if (it != batchSample_->sparseMotions.end())
+            return it->second;
+    }
+    return si_->checkMotion(st, sparseStateProperty_[v]);
 }
 
 ompl::geometric::SPARS::DenseVertex ompl::geometric::SPARS::addMilestone(base::State *state)
@@ -482,7 +628,7 @@ ompl::geometric::SPARS::DenseVertex ompl::geometric::SPARS::addMilestone(base::S
     const std::vector<DenseVertex> &neighbors = connectionStrategy_(m);
 
     foreach (DenseVertex n, neighbors)
-        if (si_->checkMotion(stateProperty_[m], stateProperty_[n]))
+        if (checkDenseMotion(stateProperty_[m], n))
         {
             const double weight = distanceFunction(m, n);
             const DenseGraph::edge_property_type properties(weight);
@@ -550,7 +696,7 @@ bool ompl::geometric::SPARS::checkAddCoverage(const base::State *lastState, cons
     // For each of these neighbors,
     foreach (SparseVertex n, neigh)
         // If path between is free
-        if (si_->checkMotion(lastState, sparseStateProperty_[n]))
+        if (checkSparseMotion(lastState, n))
             // Abort out and return false
             return false;
     // No free paths means we add for coverage
@@ -568,8 +714,7 @@ bool ompl::geometric::SPARS::checkAddConnectivity(const base::State *lastState,
             // If they are in different components
             if (!sameComponent(neigh[i], neigh[j]))
                 // If the paths between are collision free
-                if (si_->checkMotion(lastState, sparseStateProperty_[neigh[i]]) &&
-                    si_->checkMotion(lastState, sparseStateProperty_[neigh[j]]))
+                if (checkSparseMotion(lastState, neigh[i]) && checkSparseMotion(lastState, neigh[j]))
                 {
                     links.push_back(neigh[i]);
                     links.push_back(neigh[j]);
@@ -774,7 +919,7 @@ void ompl::geometric::SPARS::filterVisibleNeighbors(base::State *inState,
     visibleNeighborhood.clear();
     // Now that we got the neighbors from the NN, we must remove any we can't see
     for (unsigned long i : graphNeighborhood)
-        if (si_->checkMotion(inState, sparseStateProperty_[i]))
+        if (checkSparseMotion(inState, i))
             visibleNeighborhood.push_back(i);
 }
 
@@ -871,7 +1016,7 @@ void ompl::geometric::SPARS::calculateRepresentative(DenseVertex q)
 
     // For each neighbor
     for (unsigned long i : graphNeighborhood)
-        if (si_->checkMotion(stateProperty_[q], sparseStateProperty_[i]))
+        if (checkSparseMotion(stateProperty_[q], i))
         {
             // update the representative
             representativesProperty_[q] = i;
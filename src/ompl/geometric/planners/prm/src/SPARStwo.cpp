@@ -43,6 +43,7 @@
 #include <boost/graph/incremental_components.hpp>
 #include <boost/property_map/vector_property_map.hpp>
 #include <boost/foreach.hpp>
+#include <atomic>
 #include <thread>
 
 #include "GoalVisitor.hpp"
@@ -74,6 +75,8 @@ ompl::geometric::SPARStwo::SPARStwo(const base::SpaceInformationPtr &si)
                                   &SPARStwo::getDenseDeltaFraction, "0.0:0.0001:0.1");
     Planner::declareParam<unsigned int>("max_failures", this, &SPARStwo::setMaxFailures, &SPARStwo::getMaxFailures,
                                         "100:10:3000");
+    Planner::declareParam<unsigned int>("num_threads", this, &SPARStwo::setNumThreads, &SPARStwo::getNumThreads,
+                                        "1:1:64");
 
     addPlannerProgressProperty("iterations INTEGER", [this]
                                {
@@ -249,6 +252,13 @@ void ompl::geometric::SPARStwo::constructRoadmap(const base::PlannerTerminationC
     if (!sampler_)
         sampler_ = si_->allocValidStateSampler();
 
+    bestCost_ = opt_->infiniteCost();
+    if (numThreads_ > 1)
+    {
+        constructRoadmapParallel(ptc);
+        return;
+    }
+
     base::State *qNew = si_->allocState();
     base::State *workState = si_->allocState();
 
@@ -257,7 +267,6 @@ void ompl::geometric::SPARStwo::constructRoadmap(const base::PlannerTerminationC
     /* The visible neighborhood set which has been most recently computed */
     std::vector<Vertex> visibleNeighborhood;
 
-    bestCost_ = opt_->infiniteCost();
     while (!ptc)
     {
         ++iterations_;
@@ -267,34 +276,187 @@ void ompl::geometric::SPARStwo::constructRoadmap(const base::PlannerTerminationC
         if (!sampler_->sample(qNew))
             continue;
 
-        findGraphNeighbors(qNew, graphNeighborhood, visibleNeighborhood);
+        checkAddSample(qNew, workState, graphNeighborhood, visibleNeighborhood, ptc);
+    }
+    si_->freeState(workState);
+    si_->freeState(qNew);
+}
 
-        if (!checkAddCoverage(qNew, visibleNeighborhood))
-            if (!checkAddConnectivity(qNew, visibleNeighborhood))
-                if (!checkAddInterface(qNew, graphNeighborhood, visibleNeighborhood))
-                {
-                    if (!visibleNeighborhood.empty())
-                    {
-                        std::map<Vertex, base::State *> closeRepresentatives;
-                        findCloseRepresentatives(workState, qNew, visibleNeighborhood[0], closeRepresentatives, ptc);
-                        for (auto &closeRepresentative : closeRepresentatives)
+void ompl::geometric::SPARStwo::constructRoadmapParallel(const base::PlannerTerminationCondition &ptc)
+{
+    // Each thread has its own sampler
+    std::vector<base::ValidStateSamplerPtr> samplers(numThreads_);
+    samplers[0] = sampler_;
+    for (unsigned int t = 1; t < numThreads_; ++t)
+        samplers[t] = si_->allocValidStateSampler();
+
+    // A few samples per thread, so the threads stay busy while the batch is small enough that few guards are added
+    // during it
+    std::vector<BatchSample> batch(8 * numThreads_);
+    auto parallelForEach = [this, &batch](const std::function<void(unsigned int, BatchSample &)> &work)
+    {
+        std::atomic<std::size_t> next(0);
+        auto run = [&batch, &work, &next](unsigned int t)
+        {
+            for (std::size_t i = next++; i < batch.size(); i = next++)
+                work(t, batch[i]);
+        };
+        std::vector<std::thread> threads;
+        for (unsigned int t = 1; t < numThreads_; ++t)
+            threads.emplace_back(run, t);
+        run(0);
+        for (auto &thread : threads)
+            thread.join();
+    };
+
+    // The guards near a state, with their states, so the threads do not read the graph while guards are added to it
+    std::vector<Vertex> nbh;
+    auto findGuards = [this, &nbh](base::State *st, std::vector<std::pair<Vertex, base::State *>> &guards)
+    {
+        stateProperty_[queryVertex_] = st;
+        nn_->nearestR(queryVertex_, sparseDelta_, nbh);
+        stateProperty_[queryVertex_] = nullptr;
+        guards.clear();
+        for (Vertex v : nbh)
+            guards.emplace_back(v, stateProperty_[v]);
+    };
+
+    base::State *workState = si_->allocState();
+    std::vector<Vertex> graphNeighborhood;
+    std::vector<Vertex> visibleNeighborhood;
+
+    while (!ptc)
+    {
+        parallelForEach([this, &samplers](unsigned int t, BatchSample &sample)
                         {
-                            updatePairPoints(visibleNeighborhood[0], qNew, closeRepresentative.first,
-                                             closeRepresentative.second);
-                            updatePairPoints(closeRepresentative.first, closeRepresentative.second,
-                                             visibleNeighborhood[0], qNew);
-                        }
-                        checkAddPath(visibleNeighborhood[0]);
-                        for (auto &closeRepresentative : closeRepresentatives)
+                            sample.state = si_->allocState();
+                            if (!samplers[t]->sample(sample.state))
+                            {
+                                si_->freeState(sample.state);
+                                sample.state = nullptr;
+                            }
+                        });
+
+        // The nearest neighbors queries share queryVertex_, so they are not run in parallel
+        for (auto &sample : batch)
+            if (sample.state != nullptr)
+                findGuards(sample.state, sample.neighbors);
+
+        // Check the motions to the guards, and if the sample sees any of them it may be checked for an interface,
+        // which needs states near it
+        parallelForEach([this, &samplers, &ptc](unsigned int t, BatchSample &sample)
                         {
-                            checkAddPath(closeRepresentative.first);
-                            si_->freeState(closeRepresentative.second);
-                        }
-                    }
+                            if (sample.state == nullptr)
+                                return;
+                            bool visible = false;
+                            for (const auto &guard : sample.neighbors)
+                                visible |= (sample.motions[std::make_pair(sample.state, guard.first)] =
+                                                si_->checkMotion(sample.state, guard.second));
+                            if (!visible)
+                                return;
+                            for (unsigned int i = 0; i < nearSamplePoints_ && !ptc; ++i)
+                            {
+                                base::State *st = si_->allocState();
+                                do
+                                {
+                                    samplers[t]->sampleNear(st, sample.state, denseDelta_);
+                                } while ((!si_->isValid(st) || si_->distance(sample.state, st) > denseDelta_ ||
+                                          !si_->checkMotion(sample.state, st)) &&
+                                         !ptc);
+                                if (ptc)
+                                    si_->freeState(st);
+                                else
+                                    sample.nearStates.push_back(st);
+                            }
+                        });
+
+        for (auto &sample : batch)
+        {
+            sample.nearNeighbors.resize(sample.nearStates.size());
+            for (std::size_t i = 0; i < sample.nearStates.size(); ++i)
+                findGuards(sample.nearStates[i], sample.nearNeighbors[i]);
+        }
+
+        // The representative of a near state is the closest guard it sees
+        parallelForEach([this](unsigned int, BatchSample &sample)
+                        {
+                            for (std::size_t i = 0; i < sample.nearStates.size(); ++i)
+                                for (const auto &guard : sample.nearNeighbors[i])
+                                    if ((sample.motions[std::make_pair(sample.nearStates[i], guard.first)] =
+                                             si_->checkMotion(sample.nearStates[i], guard.second)))
+                                        break;
+                        });
+
+        // Add the samples one at a time, as with a single thread
+        for (auto &sample : batch)
+        {
+            if (!ptc)
+            {
+                ++iterations_;
+                ++consecutiveFailures_;
+                if (sample.state != nullptr)
+                {
+                    batchSample_ = &sample;
+                    checkAddSample(sample.state, workState, graphNeighborhood, visibleNeighborhood, ptc);
+                    batchSample_ = nullptr;
                 }
+            }
+
+            if (sample.state != nullptr)
+                si_->freeState(sample.state);
+            sample.state = nullptr;
+            for (auto &st : sample.nearStates)
+                si_->freeState(st);
+            sample.nearStates.clear();
+            sample.neighbors.clear();
+            sample.nearNeighbors.clear();
+            sample.motions.clear();
+        }
     }
     si_->freeState(workState);
-    si_->freeState(qNew);
+}
+
+void ompl::geometric::SPARStwo::checkAddSample(base::State *qNew, base::State *workState,
+                                               std::vector<Vertex> &graphNeighborhood,
+                                               std::vector<Vertex> &visibleNeighborhood,
+                                               const base::PlannerTerminationCondition &ptc)
+{
+    findGraphNeighbors(qNew, graphNeighborhood, visibleNeighborhood);
+
+    if (!checkAddCoverage(qNew, visibleNeighborhood))
+        if (!checkAddConnectivity(qNew, visibleNeighborhood))
+            if (!checkAddInterface(qNew, graphNeighborhood, visibleNeighborhood))
+            {
+                if (!visibleNeighborhood.empty())
+                {
+                    std::map<Vertex, base::State *> closeRepresentatives;
+                    findCloseRepresentatives(workState, qNew, visibleNeighborhood[0], closeRepresentatives, ptc);
+                    for (auto &closeRepresentative : closeRepresentatives)
+                    {
+                        updatePairPoints(visibleNeighborhood[0], qNew, closeRepresentative.first,
+                                         closeRepresentative.second);
+                        updatePairPoints(closeRepresentative.first, closeRepresentative.second,
+                                         visibleNeighborhood[0], qNew);
+                    }
+                    checkAddPath(visibleNeighborhood[0]);
+                    for (auto &closeRepresentative : closeRepresentatives)
+                    {
+                        checkAddPath(closeRepresentative.first);
+                        si_->freeState(closeRepresentative.second);
+                    }
+                }
+            }
+}
+
+bool ompl::geometric::SPARStwo::checkMotion(const base::State *st, Vertex v) const
+{
+    if (batchSample_ != nullptr)
+    {
+        auto it = batchSample_->motions.find(std::make_pair(st, v));
+        if (it != batchSample_->motions.end())
+            return it->second;
+    }
+    return si_->checkMotion(st, stateProperty_[v]);
 }
 
 void ompl::geometric::SPARStwo::checkQueryStateInitialization()
@@ -576,7 +738,7 @@ void ompl::geometric::SPARStwo::findGraphNeighbors(base::State *st, std::vector<
 
     // Now that we got the neighbors from the NN, we must remove any we can't see
     for (unsigned long i : graphNeighborhood)
-        if (si_->checkMotion(st, stateProperty_[i]))
+        if (checkMotion(st, i))
             visibleNeighborhood.push_back(i);
 }
 
@@ -604,7 +766,7 @@ ompl::geometric::SPARStwo::Vertex ompl::geometric::SPARStwo::findGraphRepresenta
     Vertex result = boost::graph_traits<Graph>::null_vertex();
 
     for (unsigned long i : nbh)
-        if (si_->checkMotion(st, stateProperty_[i]))
+        if (checkMotion(st, i))
         {
             result = i;
             break;
@@ -621,22 +783,38 @@ void ompl::geometric::SPARStwo::findCloseRepresentatives(base::State *workArea,
         si_->freeState(closeRepresentative.second);
     closeRepresentatives.clear();
 
+    // States near a sample added by constructRoadmapParallel() may have been sampled already
+    const std::vector<base::State *> *nearStates = nullptr;
+    if (batchSample_ != nullptr && batchSample_->state == qNew && !batchSample_->nearStates.empty())
+        nearStates = &batchSample_->nearStates;
+
     // Then, begin searching the space around him
     for (unsigned int i = 0; i < nearSamplePoints_; ++i)
     {
-        do
+        base::State *nearState = workArea;
+        if (nearStates != nullptr)
         {
-            sampler_->sampleNear(workArea, qNew, denseDelta_);
-        } while ((!si_->isValid(workArea) || si_->distance(qNew, workArea) > denseDelta_ ||
-                  !si_->checkMotion(qNew, workArea)) &&
-                 !ptc);
-
-        // if we were not successful at sampling a desirable state, we are out of time
-        if (ptc)
-            break;
+            // fewer states were sampled if we ran out of time
+            if (i >= nearStates->size())
+                break;
+            nearState = (*nearStates)[i];
+        }
+        else
+        {
+            do
+            {
+                sampler_->sampleNear(workArea, qNew, denseDelta_);
+            } while ((!si_->isValid(workArea) || si_->distance(qNew, workArea) > denseDelta_ ||
+                      !si_->checkMotion(qNew, workArea)) &&
+                     !ptc);
+
+            // if we were not successful at sampling a desirable state, we are out of time
+            if (ptc)
+                break;
+        }
 
         // Compute who his graph neighbors are
-        Vertex representative = findGraphRepresentative(workArea);
+        Vertex representative = findGraphRepresentative(nearState);
 
         // Assuming this sample is actually seen by somebody (which he should be in all likelihood)
         if (representative != boost::graph_traits<Graph>::null_vertex())
@@ -646,12 +824,12 @@ void ompl::geometric::SPARStwo::findCloseRepresentatives(base::State *workArea,
                 // And we haven't already tracked this representative
                 if (closeRepresentatives.find(representative) == closeRepresentatives.end())
                     // Track the representative
-                    closeRepresentatives[representative] = si_->cloneState(workArea);
+                    closeRepresentatives[representative] = si_->cloneState(nearState);
         }
         else
         {
             // This guy can't be seen by anybody, so we should take this opportunity to add him
-            addGuard(si_->cloneState(workArea), COVERAGE);
+            addGuard(si_->cloneState(nearState), COVERAGE);
 
             // We should also stop our efforts to add a dense path
             for (auto &closeRepresentative : closeRepresentatives)
@@ -68,7 +68,9 @@ ompl::geometric::PathGeometric &ompl::geometric::PathGeometric::operator=(const
 {
     if (this != &other)
     {
-        freeMemory();
+        // States can only be reused if they belong to the same space
+        if (si_->getStateSpace() != other.si_->getStateSpace())
+            clear();
         si_ = other.si_;
         copyFrom(other);
     }
@@ -77,9 +79,19 @@ ompl::geometric::PathGeometric &ompl::geometric::PathGeometric::operator=(const
 
 void ompl::geometric::PathGeometric::copyFrom(const PathGeometric &other)
 {
-    states_.resize(other.states_.size());
+    resizeStates(other.states_.size());
     for (unsigned int i = 0; i < states_.size(); ++i)
-        states_[i] = si_->cloneState(other.states_[i]);
+        si_->copyState(states_[i], other.states_[i]);
+}
+
+void ompl::geometric::PathGeometric::resizeStates(std::size_t count)
+{
+    for (std::size_t i = count; i < states_.size(); ++i)
+        si_->freeState(states_[i]);
+    std::size_t oldCount = states_.size();
+    states_.resize(count);
+    for (std::size_t i = oldCount; i < count; ++i)
+        states_[i] = si_->allocState();
 }
 
 void ompl::geometric::PathGeometric::freeMemory()
@@ -188,17 +200,48 @@ void ompl::geometric::PathGeometric::print(std::ostream &out) const
 }
 void ompl::geometric::PathGeometric::printAsMatrix(std::ostream &out) const
 {
-    const base::StateSpace *space(si_->getStateSpace().get());
     std::vector<double> reals;
-    for (auto state : states_)
+    copyToReals(reals);
+    const std::size_t dim = si_->getStateSpace()->getValueLocations().size();
+    for (std::size_t i = 0; i < states_.size(); ++i)
     {
-        space->copyToReals(reals, state);
-        std::copy(reals.begin(), reals.end(), std::ostream_iterator<double>(out, " "));
+        std::copy(reals.begin() + i * dim, reals.begin() + (i + 1) * dim, std::ostream_iterator<double>(out, " "));
         out << std::endl;
     }
     out << std::endl;
 }
 
+void ompl::geometric::PathGeometric::copyToReals(std::vector<double> &reals) const
+{
+    const base::StateSpace *space(si_->getStateSpace().get());
+    const std::vector<base::StateSpace::ValueLocation> &locations = space->getValueLocations();
+    reals.resize(states_.size() * locations.size());
+    auto out = reals.begin();
+    for (auto state : states_)
+        for (const auto &location : locations)
+            *out++ = *space->getValueAddressAtLocation(state, location);
+}
+
+void ompl::geometric::PathGeometric::serialize(std::vector<unsigned char> &buffer) const
+{
+    const base::StateSpace *space(si_->getStateSpace().get());
+    const std::size_t length = space->getSerializationLength();
+    buffer.resize(states_.size() * length);
+    for (std::size_t i = 0; i < states_.size(); ++i)
+        space->serialize(&buffer[i * length], states_[i]);
+}
+
+void ompl::geometric::PathGeometric::deserialize(const std::vector<unsigned char> &buffer)
+{
+    const base::StateSpace *space(si_->getStateSpace().get());
+    const std::size_t length = space->getSerializationLength();
+    if (length == 0 || buffer.size() % length != 0)
+        throw Exception("PathGeometric", "Serialized path does not match the state space");
+    resizeStates(buffer.size() / length);
+    for (std::size_t i = 0; i < states_.size(); ++i)
+        space->deserialize(states_[i], &buffer[i * length]);
+}
+
 std::pair<bool, bool> ompl::geometric::PathGeometric::checkAndRepair(unsigned int attempts)
 {
     if (states_.empty())
@@ -294,6 +337,7 @@ void ompl::geometric::PathGeometric::subdivide()
     if (states_.size() < 2)
         return;
     std::vector<base::State *> newStates(1, states_[0]);
+    newStates.reserve(2 * states_.size() - 1);
     for (unsigned int i = 1; i < states_.size(); ++i)
     {
         base::State *temp = si_->allocState();
@@ -309,15 +353,25 @@ void ompl::geometric::PathGeometric::interpolate()
     std::vector<base::State *> newStates;
     const int segments = states_.size() - 1;
 
+    // Count the states first, so the new array is allocated only once
+    std::vector<unsigned int> segmentCounts(std::max(segments, 0));
+    std::size_t total = 1;
+    for (int i = 0; i < segments; ++i)
+    {
+        segmentCounts[i] = si_->getStateSpace()->validSegmentCount(states_[i], states_[i + 1]);
+        total += std::max(segmentCounts[i], 1u);
+    }
+    newStates.reserve(total);
+
+    std::vector<base::State *> block;
     for (int i = 0; i < segments; ++i)
     {
         base::State *s1 = states_[i];
         base::State *s2 = states_[i + 1];
 
         newStates.push_back(s1);
-        unsigned int n = si_->getStateSpace()->validSegmentCount(s1, s2);
+        unsigned int n = segmentCounts[i];
 
-        std::vector<base::State *> block;
         si_->getMotionStates(s1, s2, block, n - 1, false, true);
         newStates.insert(newStates.end(), block.begin(), block.end());
     }
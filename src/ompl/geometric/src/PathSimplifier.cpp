@@ -42,7 +42,10 @@
 #include <limits>
 #include <cstdlib>
 #include <cmath>
+#include <condition_variable>
 #include <map>
+#include <mutex>
+#include <thread>
 #include <utility>
 
 ompl::geometric::PathSimplifier::PathSimplifier(base::SpaceInformationPtr si, const base::GoalPtr &goal,
@@ -184,6 +187,160 @@ bool ompl::geometric::PathSimplifier::reduceVertices(PathGeometric &path, unsign
     return result;
 }
 
+bool ompl::geometric::PathSimplifier::reduceVerticesParallel(PathGeometric &path, unsigned int maxSteps,
+                                                             unsigned int maxEmptySteps, double rangeRatio)
+{
+    if (numThreads_ < 2)
+        return reduceVertices(path, maxSteps, maxEmptySteps, rangeRatio);
+
+    if (path.getStateCount() < 3)
+        return false;
+
+    if (maxSteps == 0)
+        maxSteps = path.getStateCount();
+
+    if (maxEmptySteps == 0)
+        maxEmptySteps = path.getStateCount();
+
+    bool result = false;
+    unsigned int nochange = 0;
+    const base::SpaceInformationPtr &si = path.getSpaceInformation();
+    std::vector<base::State *> &states = path.getStates();
+
+    if (si->checkMotion(states.front(), states.back()))
+    {
+        if (freeStates_)
+            for (std::size_t i = 2; i < states.size(); ++i)
+                si->freeState(states[i - 1]);
+        std::vector<base::State *> newStates(2);
+        newStates[0] = states.front();
+        newStates[1] = states.back();
+        states.swap(newStates);
+        return true;
+    }
+
+    std::vector<std::pair<int, int>> candidates;
+    std::vector<char> valid;
+
+    // The workers live as long as this call; for each batch, worker k checks connection k, if there is one
+    std::mutex batchLock;
+    std::condition_variable batchReady, batchDone;
+    unsigned long batch = 0;
+    unsigned int busyWorkers = 0;
+    bool finished = false;
+    std::vector<std::thread> workers;
+    for (unsigned int k = 1; k < numThreads_; ++k)
+        workers.emplace_back([&, k]
+                             {
+                                 unsigned long lastBatch = 0;
+                                 while (true)
+                                 {
+                                     {
+                                         std::unique_lock<std::mutex> lock(batchLock);
+                                         batchReady.wait(lock, [&] { return finished || batch != lastBatch; });
+                                         if (finished)
+                                             return;
+                                         lastBatch = batch;
+                                     }
+                                     if (k < candidates.size())
+                                         valid[k] = si->checkMotion(states[candidates[k].first],
+                                                                    states[candidates[k].second]);
+                                     std::lock_guard<std::mutex> lock(batchLock);
+                                     if (--busyWorkers == 0)
+                                         batchDone.notify_one();
+                                 }
+                             });
+
+    unsigned int steps = 0;
+    while (steps < maxSteps && nochange < maxEmptySteps && states.size() > 2)
+    {
+        int count = states.size();
+        int maxN = count - 1;
+        int range = 1 + (int)(floor(0.5 + (double)count * rangeRatio));
+
+        // Draw a batch of connections between parts of the path that do not overlap
+        candidates.clear();
+        for (unsigned int draws = 0;
+             draws < 2 * numThreads_ && candidates.size() < numThreads_ && steps + candidates.size() < maxSteps;
+             ++draws)
+        {
+            int p1 = rng_.uniformInt(0, maxN);
+            int p2 = rng_.uniformInt(std::max(p1 - range, 0), std::min(maxN, p1 + range));
+            if (abs(p1 - p2) < 2)
+            {
+                if (p1 < maxN - 1)
+                    p2 = p1 + 2;
+                else if (p1 > 1)
+                    p2 = p1 - 2;
+                else
+                    continue;
+            }
+
+            if (p1 > p2)
+                std::swap(p1, p2);
+
+            bool overlaps = false;
+            for (const auto &c : candidates)
+                if (p1 < c.second && c.first < p2)
+                {
+                    overlaps = true;
+                    break;
+                }
+            if (!overlaps)
+                candidates.emplace_back(p1, p2);
+        }
+
+        if (candidates.empty())
+        {
+            ++steps;
+            ++nochange;
+            continue;
+        }
+        std::sort(candidates.begin(), candidates.end());
+
+        // Check all connections of the batch concurrently
+        valid.assign(candidates.size(), 0);
+        {
+            std::lock_guard<std::mutex> lock(batchLock);
+            busyWorkers = workers.size();
+            ++batch;
+        }
+        batchReady.notify_all();
+        valid[0] = si->checkMotion(states[candidates[0].first], states[candidates[0].second]);
+        {
+            std::unique_lock<std::mutex> lock(batchLock);
+            batchDone.wait(lock, [&] { return busyWorkers == 0; });
+        }
+
+        // Apply the valid connections starting from the end of the path, so indices remain correct
+        for (std::size_t k = candidates.size(); k > 0; --k)
+        {
+            ++steps;
+            ++nochange;
+            if (valid[k - 1])
+            {
+                int p1 = candidates[k - 1].first;
+                int p2 = candidates[k - 1].second;
+                if (freeStates_)
+                    for (int j = p1 + 1; j < p2; ++j)
+                        si->freeState(states[j]);
+                states.erase(states.begin() + p1 + 1, states.begin() + p2);
+                nochange = 0;
+                result = true;
+            }
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(batchLock);
+        finished = true;
+    }
+    batchReady.notify_all();
+    for (auto &worker : workers)
+        worker.join();
+    return result;
+}
+
 bool ompl::geometric::PathSimplifier::shortcutPath(PathGeometric &path, unsigned int maxSteps,
                                                    unsigned int maxEmptySteps, double rangeRatio, double snapToVertex)
 {
@@ -719,7 +876,7 @@ bool ompl::geometric::PathSimplifier::simplify(PathGeometric &path, const base::
 
         // try a randomized step of connecting vertices
         if (ptc == false || atLeastOnce)
-            tryMore = reduceVertices(path);
+            tryMore = reduceVerticesParallel(path);
 
         // try to collapse close-by vertices
         if (ptc == false || atLeastOnce)
@@ -728,7 +885,7 @@ bool ompl::geometric::PathSimplifier::simplify(PathGeometric &path, const base::
         // try to reduce verices some more, if there is any point in doing so
         unsigned int times = 0;
         while ((ptc == false || atLeastOnce) && tryMore && ++times <= 5)
-            tryMore = reduceVertices(path);
+            tryMore = reduceVerticesParallel(path);
 
         if ((ptc == false || atLeastOnce) && si_->getStateSpace()->isMetricSpace())
         {
@@ -750,6 +907,57 @@ bool ompl::geometric::PathSimplifier::simplify(PathGeometric &path, const base::
     return valid || path.check();
 }
 
+bool ompl::geometric::PathSimplifier::simplifyMultiStart(PathGeometric &path, unsigned int numStarts,
+                                                         const base::PlannerTerminationCondition &ptc,
+                                                         bool atLeastOnce)
+{
+    if (numStarts < 2 || path.getStateCount() < 3)
+        return simplify(path, ptc, atLeastOnce);
+
+    // Create the simplifiers here, so the seeds they get do not depend on thread scheduling. Sampling goals is not
+    // thread safe, so only the first copy tries to find a better goal.
+    std::vector<PathSimplifierPtr> simplifiers(numStarts);
+    for (unsigned int i = 0; i < numStarts; ++i)
+    {
+        simplifiers[i] = std::make_shared<PathSimplifier>(si_, i == 0 ? base::GoalPtr(gsr_) : base::GoalPtr(), obj_);
+        simplifiers[i]->setNumThreads(numThreads_);
+    }
+
+    std::vector<PathGeometric> copies(numStarts, path);
+    std::vector<char> valid(numStarts, 0);
+    std::vector<std::thread> threads;
+    for (unsigned int i = 1; i < numStarts; ++i)
+        threads.emplace_back([&, i]
+                             {
+                                 valid[i] = simplifiers[i]->simplify(copies[i], ptc, atLeastOnce);
+                             });
+    valid[0] = simplifiers[0]->simplify(copies[0], ptc, atLeastOnce);
+    for (auto &thread : threads)
+        thread.join();
+
+    // Prefer valid paths, then lower cost
+    unsigned int best = 0;
+    base::Cost bestCost = copies[0].cost(obj_);
+    for (unsigned int i = 1; i < numStarts; ++i)
+    {
+        base::Cost cost = copies[i].cost(obj_);
+        if ((valid[i] && !valid[best]) || (valid[i] == valid[best] && obj_->isCostBetterThan(cost, bestCost)))
+        {
+            best = i;
+            bestCost = cost;
+        }
+    }
+
+    std::vector<base::State *> &states = path.getStates();
+    if (freeStates_)
+        for (auto &state : states)
+            si_->freeState(state);
+    states.swap(copies[best].getStates());
+    copies[best].getStates().clear();
+
+    return valid[best];
+}
+
 bool ompl::geometric::PathSimplifier::findBetterGoal(PathGeometric &path, double maxTime, unsigned int samplingAttempts,
                                                      double rangeRatio, double snapToVertex)
 {
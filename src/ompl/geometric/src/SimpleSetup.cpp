@@ -35,7 +35,11 @@
 /* Author: Ioan Sucan */
 
 #include "ompl/geometric/SimpleSetup.h"
+#include "ompl/base/CompactPlannerDataStorage.h"
 #include "ompl/tools/config/SelfConfig.h"
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <sstream>
 
 ompl::geometric::SimpleSetup::SimpleSetup(const base::SpaceInformationPtr &si)
   : configured_(false), planTime_(0.0), simplifyTime_(0.0), lastStatus_(base::PlannerStatus::UNKNOWN)
@@ -51,6 +55,11 @@ ompl::geometric::SimpleSetup::SimpleSetup(const base::StateSpacePtr &space)
     pdef_ = std::make_shared<base::ProblemDefinition>(si_);
 }
 
+ompl::geometric::SimpleSetup::~SimpleSetup()
+{
+    waitForRoadmapCache();
+}
+
 void ompl::geometric::SimpleSetup::setup()
 {
     if (!configured_ || !si_->isSetup() || !planner_->isSetup())
@@ -73,14 +82,117 @@ void ompl::geometric::SimpleSetup::setup()
         psk_ = std::make_shared<PathSimplifier>(si_, pdef_->getGoal(), pdef_->getOptimizationObjective());
         configured_ = true;
     }
+    if (!roadmapCache_.empty() && roadmapCachePlanner_ != planner_)
+        loadRoadmapCache();
 }
 
 void ompl::geometric::SimpleSetup::clear()
 {
+    waitForRoadmapCache();
     if (planner_)
         planner_->clear();
     if (pdef_)
         pdef_->clearSolutionPaths();
+    roadmapCachePlanner_.reset();
+}
+
+void ompl::geometric::SimpleSetup::setRoadmapCache(const std::string &filename)
+{
+    waitForRoadmapCache();
+    roadmapCache_ = filename;
+    roadmapCachePlanner_.reset();
+}
+
+void ompl::geometric::SimpleSetup::waitForRoadmapCache()
+{
+    if (roadmapCacheWriter_.joinable())
+        roadmapCacheWriter_.join();
+}
+
+void ompl::geometric::SimpleSetup::loadRoadmapCache()
+{
+    waitForRoadmapCache();
+    roadmapCachePlanner_ = planner_;
+    roadmapCacheVertices_ = 0;
+    roadmapCacheWritable_ = false;
+    if (!planner_->getSpecs().canLoadCompactPlannerData)
+    {
+        // A roadmap written by this planner could never be loaded again
+        OMPL_WARN("SimpleSetup: Planner %s cannot use the roadmap cache '%s'", planner_->getName().c_str(),
+                  roadmapCache_.c_str());
+        return;
+    }
+    roadmapCacheWritable_ = true;
+    if (!std::ifstream(roadmapCache_).good())
+        return;
+
+    time::point start = time::now();
+    base::CompactPlannerData data(si_);
+    std::size_t completeBytes;
+    if (!base::CompactPlannerDataStorage().load(roadmapCache_.c_str(), data, completeBytes))
+    {
+        OMPL_WARN("SimpleSetup: The roadmap cache '%s' will be overwritten", roadmapCache_.c_str());
+        return;
+    }
+    if (!planner_->setCompactPlannerData(data))
+    {
+        // Writing the roadmap of this planner to the cache would not match what is already there
+        OMPL_WARN("SimpleSetup: Planner %s cannot use the roadmap cache '%s'", planner_->getName().c_str(),
+                  roadmapCache_.c_str());
+        roadmapCacheWritable_ = false;
+        return;
+    }
+    roadmapCacheVertices_ = data.numVertices();
+
+    // Segments are appended at the end of the file, so an incomplete one left by an interrupted write is cut off;
+    // if that fails, the whole roadmap is written again
+    boost::system::error_code ec;
+    if (completeBytes < boost::filesystem::file_size(roadmapCache_, ec) && !ec)
+    {
+        OMPL_WARN("SimpleSetup: Removing an incomplete segment from the roadmap cache '%s'", roadmapCache_.c_str());
+        boost::filesystem::resize_file(roadmapCache_, completeBytes, ec);
+    }
+    if (ec)
+        roadmapCacheVertices_ = 0;
+
+    OMPL_INFORM("SimpleSetup: Loaded a roadmap with %u vertices and %u edges from '%s' in %f seconds",
+                data.numVertices(), data.numEdges(), roadmapCache_.c_str(), time::seconds(time::now() - start));
+}
+
+void ompl::geometric::SimpleSetup::appendRoadmapCache()
+{
+    if (roadmapCache_.empty() || !roadmapCacheWritable_)
+        return;
+    waitForRoadmapCache();
+
+    base::CompactPlannerData data(si_);
+    planner_->getCompactPlannerData(data);
+    if (data.numVertices() == roadmapCacheVertices_)
+        return;
+
+    // Fewer vertices than were written means the roadmap was cleared, so the file is rewritten
+    const unsigned int fromVertex = data.numVertices() > roadmapCacheVertices_ ? roadmapCacheVertices_ : 0;
+    roadmapCacheVertices_ = data.numVertices();
+
+    // The planner may be cleared while the writer runs, e.g. by a direct call to Planner::clear(), so the states
+    // are serialized here; only the new vertices are, unless the file is rewritten
+    auto segment = std::make_shared<std::ostringstream>(std::ios::binary);
+    base::CompactPlannerDataStorage storage;
+    if (!(fromVertex == 0 ? storage.store(data, *segment) : storage.append(data, fromVertex, *segment)))
+        return;
+    roadmapCacheWriter_ = std::thread(
+        [segment, fromVertex, filename = roadmapCache_]
+        {
+            // Appending opens the file for reading as well, which fails instead of creating a file without a header
+            std::fstream out(filename.c_str(), fromVertex == 0 ? std::ios::binary | std::ios::out | std::ios::trunc :
+                                                                 std::ios::binary | std::ios::in | std::ios::out);
+            out.seekp(0, std::ios::end);
+            const std::string bytes = segment->str();
+            out.write(bytes.data(), bytes.size());
+            out.flush();
+            if (!out.good())
+                OMPL_ERROR("SimpleSetup: Failed to write the roadmap cache '%s'", filename.c_str());
+        });
 }
 
 void ompl::geometric::SimpleSetup::setStartAndGoalStates(const base::ScopedState<> &start,
@@ -122,6 +234,7 @@ void ompl::geometric::SimpleSetup::setGoal(const base::GoalPtr &goal)
 // termination condition
 ompl::base::PlannerStatus ompl::geometric::SimpleSetup::solve(double time)
 {
+    waitForRoadmapCache();
     setup();
     lastStatus_ = base::PlannerStatus::UNKNOWN;
     time::point start = time::now();
@@ -131,11 +244,13 @@ ompl::base::PlannerStatus ompl::geometric::SimpleSetup::solve(double time)
         OMPL_INFORM("Solution found in %f seconds", planTime_);
     else
         OMPL_INFORM("No solution found after %f seconds", planTime_);
+    appendRoadmapCache();
     return lastStatus_;
 }
 
 ompl::base::PlannerStatus ompl::geometric::SimpleSetup::solve(const base::PlannerTerminationCondition &ptc)
 {
+    waitForRoadmapCache();
     setup();
     lastStatus_ = base::PlannerStatus::UNKNOWN;
     time::point start = time::now();
@@ -145,6 +260,7 @@ ompl::base::PlannerStatus ompl::geometric::SimpleSetup::solve(const base::Planne
         OMPL_INFORM("Solution found in %f seconds", planTime_);
     else
         OMPL_INFORM("No solution found after %f seconds", planTime_);
+    appendRoadmapCache();
     return lastStatus_;
 }
 
@@ -94,6 +94,15 @@ namespace ompl
             should not really be changed. */
         static const unsigned int FIND_VALID_STATE_ATTEMPTS_WITHOUT_TERMINATION_CHECK = 2;
 
+        /** \brief The number of states planners draw from a sampler
+            at once when they need many samples (e.g., FMT*, PRM) */
+        static const unsigned int SAMPLE_BATCH_SIZE = 32;
+
+        /** \brief Below this number of goal states, GoalStates finds the
+            nearest one by scanning all of them rather than by querying
+            a nearest neighbors structure */
+        static const unsigned int GOAL_STATES_LINEAR_SCAN_LIMIT = 256;
+
         /** \brief When multiple states need to be generated as part
             of the computation of various information (usually through
             stochastic processes), this parameter controls how many
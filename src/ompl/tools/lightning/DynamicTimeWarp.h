@@ -42,7 +42,8 @@
 #include <ompl/geometric/PathGeometric.h>
 #include <ompl/base/SpaceInformation.h>
 
-#include <Eigen/Core>
+#include <limits>
+#include <vector>
 
 namespace ompl
 {
@@ -66,9 +67,19 @@ namespace ompl
              * \brief Use Dynamic Timewarping to score two paths
              * \param path1
              * \param path2
+             * \param bound - if every alignment of the paths costs more than this value, the computation is
+             *        abandoned early and infinity is returned
              * \return score
              */
-            double calcDTWDistance(const og::PathGeometric &path1, const og::PathGeometric &path2) const;
+            double calcDTWDistance(const og::PathGeometric &path1, const og::PathGeometric &path2,
+                                   double bound = std::numeric_limits<double>::infinity()) const;
+
+            /**
+             * \brief Compute a cheap lower bound of calcDTWDistance(). Every warping path aligns the first states
+             *        and the last states of both paths, so the sum of these two distances never exceeds the DTW
+             *        distance.
+             */
+            double calcDTWLowerBound(const og::PathGeometric &path1, const og::PathGeometric &path2) const;
 
             /**
              * \brief Use dynamic time warping to compare the similarity of two paths
@@ -81,15 +92,68 @@ namespace ompl
              */
             double getPathsScore(const og::PathGeometric &path1, const og::PathGeometric &path2) const;
 
+            /**
+             * \brief Find the candidate with the smallest DTW distance to \e path. Candidates are visited in order
+             *        of their lower bound, so that most of them are pruned without filling any table entries.
+             * \param path - the query path
+             * \param candidates - the paths to compare against
+             * \param distance - the DTW distance of the returned candidate
+             * \param numThreads - number of threads the candidates are split across
+             * \return index of the closest candidate, or candidates.size() if there are none
+             */
+            std::size_t findNearestPath(const og::PathGeometric &path, const std::vector<og::PathGeometric> &candidates,
+                                        double &distance, unsigned int numThreads = 1) const;
+
+            /**
+             * \brief Find the candidate with the smallest score, where the score is the DTW distance divided by
+             *        the number of states of the longer of the two paths, as in getPathsScore(). Unlike
+             *        getPathsScore(), the paths are not interpolated. The search is pruned like that of
+             *        findNearestPath().
+             * \param path - the query path
+             * \param candidates - the paths to compare against
+             * \param score - the score of the returned candidate
+             * \param numThreads - number of threads the candidates are split across
+             * \return index of the best scoring candidate, or candidates.size() if there are none
+             */
+            std::size_t findBestScoringPath(const og::PathGeometric &path,
+                                            const std::vector<og::PathGeometric> &candidates, double &score,
+                                            unsigned int numThreads = 1) const;
+
+            /**
+             * \brief Restrict the warping path to a Sakoe-Chiba band of \e width states around the diagonal. The
+             *        band is widened to the difference in path lengths when needed, so that an alignment always
+             *        exists. A width of 0 (default) disables the constraint.
+             */
+            void setBandWidth(std::size_t width)
+            {
+                bandWidth_ = width;
+            }
+
+            /** \brief Get the width of the Sakoe-Chiba band (0 if unconstrained) */
+            std::size_t getBandWidth() const
+            {
+                return bandWidth_;
+            }
+
         private:
+            /** \brief Find the candidate that minimizes its DTW distance to \e path multiplied by its entry of
+                \e scales, and store that value in \e value */
+            std::size_t findMinimum(const og::PathGeometric &path, const std::vector<og::PathGeometric> &candidates,
+                                    const std::vector<double> &scales, double &value, unsigned int numThreads) const;
+
+            /** \brief Compute the DTW distance using two rows of the cost table, provided by the caller */
+            double computeDistance(const og::PathGeometric &path1, const og::PathGeometric &path2, double bound,
+                                   std::vector<double> &prevRow, std::vector<double> &currRow) const;
+
             /** \brief The created space information */
             base::SpaceInformationPtr si_;
 
-            /** \brief Distance matrix */
-            mutable Eigen::MatrixXd table_;
+            /** \brief Width of the Sakoe-Chiba band */
+            std::size_t bandWidth_{0u};
 
-        public:
-            EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+            /** \brief Rows of the distance table, reused across calls */
+            mutable std::vector<double> prevRow_;
+            mutable std::vector<double> currRow_;
         };  // end of class
 
     }  // namespace tools
@@ -51,6 +51,9 @@
 #include "ompl/base/SpaceInformation.h"
 #include "ompl/datastructures/NearestNeighbors.h"
 
+#include <atomic>
+#include <shared_mutex>
+
 namespace ompl
 {
     namespace tools
@@ -68,7 +71,15 @@ namespace ompl
         /** \class ompl::geometric::LightningDBPtr
             \brief A shared pointer wrapper for ompl::tools::LightningDB */
 
-        /** \brief Save and load entire paths from file */
+        /** \brief Save and load entire paths from file
+
+            The database is persisted as a sequence of shards: the file passed to save() holds the first shard and
+            every call to saveIfChanged() appends the paths added since the last save to a new shard file
+            (fileName.shard1, fileName.shard2, ...), so existing experience is never rewritten. Shards are only
+            read from disk when the paths are first needed.
+
+            Queries may be issued concurrently from several threads; adding paths, loading and saving take
+            exclusive access to the database. */
         class LightningDB
         {
         public:
@@ -83,7 +94,11 @@ namespace ompl
             virtual ~LightningDB();
 
             /**
-             * \brief Load database from file
+             * \brief Load database from file. Only the number of paths in each shard is read; the paths themselves
+             *        are loaded on first use. The loaded paths replace those of a previously loaded or saved
+             *        database; paths added since the last save are kept. If the file cannot be read, the database
+             *        is left unchanged. A shard whose paths turn out to be unreadable when they are first used is
+             *        skipped with an error; getAllPlannerDatas() and save() then return false.
              * \param fileName - name of database file
              * \return true if file loaded successfully
              */
@@ -100,14 +115,17 @@ namespace ompl
             void addPathHelper(geometric::PathGeometric &solutionPath);
 
             /**
-             * \brief Save loaded database to file, except skips saving if no paths have been added
+             * \brief Save loaded database to file, except skips saving if no paths have been added. If the database
+             *        was loaded from or saved to \e fileName before, only the new paths are written, to a new shard.
              * \param fileName - name of database file
              * \return true if file saved successfully
              */
             bool saveIfChanged(const std::string &fileName);
 
             /**
-             * \brief Save loaded database to file
+             * \brief Save loaded database to file, merging all shards into a single one. The file is written
+             *        under a temporary name first and then renamed, so a failed save leaves the previous database
+             *        intact. Nothing is saved if a shard could not be loaded, since its paths would be lost.
              * \param fileName - name of database file
              * \return true if file saved successfully
              */
@@ -115,8 +133,9 @@ namespace ompl
 
             /**
              * \brief Get a vector of all the paths in the nearest neighbor tree
+             * \return false if the paths of a shard could not be loaded
              */
-            void getAllPlannerDatas(std::vector<ompl::base::PlannerDataPtr> &plannerDatas) const;
+            bool getAllPlannerDatas(std::vector<ompl::base::PlannerDataPtr> &plannerDatas) const;
 
             /**
              * \brief Find the k nearest paths to our queries one
@@ -131,21 +150,50 @@ namespace ompl
             std::size_t getStatesCount() const;
 
             /** \brief Get number of unsaved paths */
-            int getNumUnsavedPaths() const
-            {
-                return numUnsavedPaths_;
-            }
+            int getNumUnsavedPaths() const;
+
+            /** \brief Get the number of shards the database is persisted in */
+            std::size_t getShardsCount() const;
 
             /**
              * \brief Check if anything has been loaded into DB
              * \return true if has no nodes
              */
-            bool isEmpty()
+            bool isEmpty() const
             {
                 return getExperiencesCount() == 0;
             }
 
         private:
+            /** \brief A part of the database stored in its own file */
+            struct Shard
+            {
+                /** \brief The file the shard is stored in */
+                std::string fileName;
+
+                /** \brief The number of paths in the shard, known before the shard is loaded */
+                std::size_t numPaths;
+
+                /** \brief Flag indicating whether the paths of the shard have been added to nn_ */
+                bool loaded;
+
+                /** \brief Flag indicating whether reading the paths of the shard failed */
+                bool failed;
+            };
+
+            /** \brief Get the name of the file shard \e index of database \e fileName is stored in */
+            static std::string shardFileName(const std::string &fileName, std::size_t index);
+
+            /** \brief Read the number of paths stored in a shard file. Returns false if the file cannot be read. */
+            static bool readShardHeader(const std::string &fileName, std::size_t &numPaths);
+
+            /** \brief Write \e plannerDatas as a single shard to \e fileName */
+            bool writeShard(const std::string &fileName, const std::vector<ompl::base::PlannerDataPtr> &plannerDatas);
+
+            /** \brief Load the shards that have not been read from disk yet. Takes exclusive access if needed.
+                Returns false if the paths of any shard could not be read. */
+            bool loadPendingShards() const;
+
             /**
              * \brief Add the distance between both path's starts and the distance between both path's ends together
              */
@@ -161,11 +209,18 @@ namespace ompl
             // A nearest-neighbors datastructure containing the tree of start/goal states combined
             std::shared_ptr<NearestNeighbors<ompl::base::PlannerDataPtr>> nn_;
 
-            // Reusable plannerData instance for filling in start and goal and performing searches on the tree
-            ompl::base::PlannerDataPtr nnSearchKey_;
+            // Paths added since the database was last saved; these make up the next shard
+            std::vector<ompl::base::PlannerDataPtr> unsavedPaths_;
+
+            // The shards the database is persisted in, and the file holding the first one
+            mutable std::vector<Shard> shards_;
+            std::string databaseFile_;
+
+            // Number of shards that still need to be read from disk
+            mutable std::atomic<std::size_t> numPendingShards_{0u};
 
-            // Track unsaved paths to determine if a save is required
-            int numUnsavedPaths_{0};
+            // Allows concurrent queries while a single writer modifies the database
+            mutable std::shared_timed_mutex mutex_;
 
         };  // end of class LightningDB
 
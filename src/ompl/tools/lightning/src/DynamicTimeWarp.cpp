@@ -37,6 +37,10 @@
 
 #include <ompl/tools/lightning/DynamicTimeWarp.h>
 
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <thread>
 #include <utility>
 
 namespace  // anonymous
@@ -50,41 +54,88 @@ namespace  // anonymous
     }
 }  // namespace
 
-ompl::tools::DynamicTimeWarp::DynamicTimeWarp(base::SpaceInformationPtr si) : si_(std::move(si)), table_(1, 1)
+ompl::tools::DynamicTimeWarp::DynamicTimeWarp(base::SpaceInformationPtr si) : si_(std::move(si))
 {
-    table_(0, 0) = 0.;
 }
 
 double ompl::tools::DynamicTimeWarp::calcDTWDistance(const og::PathGeometric &path1,
-                                                     const og::PathGeometric &path2) const
+                                                     const og::PathGeometric &path2, double bound) const
 {
+    return computeDistance(path1, path2, bound, prevRow_, currRow_);
+}
+
+double ompl::tools::DynamicTimeWarp::computeDistance(const og::PathGeometric &path1, const og::PathGeometric &path2,
+                                                     double bound, std::vector<double> &prevRow,
+                                                     std::vector<double> &currRow) const
+{
+    const double inf = std::numeric_limits<double>::infinity();
+
     // Get lengths
     std::size_t n = path1.getStateCount();
     std::size_t m = path2.getStateCount();
-    std::size_t nrows = table_.rows(), ncols = table_.cols();
+    if (n == 0 || m == 0)
+        return n == m ? 0. : inf;
+
+    // Only cells within the band around the diagonal are computed
+    std::size_t width = std::max(n, m);
+    if (bandWidth_ > 0)
+        width = std::max(bandWidth_, n > m ? n - m : m - n);
 
-    // Intialize table
-    if (nrows <= n || ncols <= m)
+    // Only two rows of the table are kept; grow them if needed
+    if (prevRow.size() <= m)
     {
-        table_.resize(n + 1, m + 1);
-        for (std::size_t i = nrows; i <= n; ++i)
-            table_(i, 0) = std::numeric_limits<double>::infinity();
-        for (std::size_t i = ncols; i <= m; ++i)
-            table_(0, i) = std::numeric_limits<double>::infinity();
+        prevRow.resize(m + 1);
+        currRow.resize(m + 1);
     }
+    double *prev = prevRow.data();
+    double *curr = currRow.data();
+    std::fill(prev, prev + m + 1, inf);
+    prev[0] = 0.;
+    curr[0] = inf;
 
     // Do calculations
-    double cost;
     for (std::size_t i = 1; i <= n; ++i)
-        for (std::size_t j = 1; j <= m; ++j)
+    {
+        std::size_t lo = i > width ? i - width : 1;
+        std::size_t hi = std::min(m, i + width);
+        const base::State *s1 = path1.getState(i - 1);
+
+        // Cells just outside the band are read by the next row
+        curr[lo - 1] = inf;
+        if (hi < m)
+            curr[hi + 1] = inf;
+
+        double rowMin = inf;
+        for (std::size_t j = lo; j <= hi; ++j)
         {
-            cost = si_->distance(path1.getState(i - 1), path2.getState(j - 1));
-            table_(i, j) = cost + min3(table_(i - 1, j), table_(i, j - 1), table_(i - 1, j - 1));
+            curr[j] = si_->distance(s1, path2.getState(j - 1)) + min3(prev[j], curr[j - 1], prev[j - 1]);
+            rowMin = std::min(rowMin, curr[j]);
         }
 
-    return table_(n, m);
+        // Costs only grow along the warping path, so no alignment can beat the bound anymore
+        if (rowMin > bound)
+            return inf;
+
+        std::swap(prev, curr);
+    }
+
+    return prev[m];
 }
 
+double ompl::tools::DynamicTimeWarp::calcDTWLowerBound(const og::PathGeometric &path1,
+                                                       const og::PathGeometric &path2) const
+{
+    std::size_t n = path1.getStateCount();
+    std::size_t m = path2.getStateCount();
+    if (n == 0 || m == 0)
+        return n == m ? 0. : std::numeric_limits<double>::infinity();
+
+    double result = si_->distance(path1.getState(0), path2.getState(0));
+    // If both paths are a single state, the first and last cells are the same
+    if (n > 1 || m > 1)
+        result += si_->distance(path1.getState(n - 1), path2.getState(m - 1));
+    return result;
+}
 double ompl::tools::DynamicTimeWarp::getPathsScore(const og::PathGeometric &path1, const og::PathGeometric &path2) const
 {
     // Copy the path but not the states
@@ -104,3 +155,88 @@ double ompl::tools::DynamicTimeWarp::getPathsScore(const og::PathGeometric &path
 
     return calcDTWDistance(newPath1, newPath2) / max_states;
 }
+
+std::size_t ompl::tools::DynamicTimeWarp::findNearestPath(const og::PathGeometric &path,
+                                                          const std::vector<og::PathGeometric> &candidates,
+                                                          double &distance, unsigned int numThreads) const
+{
+    return findMinimum(path, candidates, std::vector<double>(candidates.size(), 1.), distance, numThreads);
+}
+
+std::size_t ompl::tools::DynamicTimeWarp::findBestScoringPath(const og::PathGeometric &path,
+                                                              const std::vector<og::PathGeometric> &candidates,
+                                                              double &score, unsigned int numThreads) const
+{
+    // The score of getPathsScore(): the distance divided by the number of states of the longer path
+    std::vector<double> scales(candidates.size());
+    for (std::size_t i = 0; i < candidates.size(); ++i)
+        scales[i] = 1. / std::max<std::size_t>(1u, std::max(path.getStateCount(), candidates[i].getStateCount()));
+    return findMinimum(path, candidates, scales, score, numThreads);
+}
+
+std::size_t ompl::tools::DynamicTimeWarp::findMinimum(const og::PathGeometric &path,
+                                                      const std::vector<og::PathGeometric> &candidates,
+                                                      const std::vector<double> &scales, double &value,
+                                                      unsigned int numThreads) const
+{
+    value = std::numeric_limits<double>::infinity();
+    if (candidates.empty())
+        return candidates.size();
+
+    // Visit the candidates in increasing order of their scaled lower bound
+    std::vector<double> lowerBounds(candidates.size());
+    for (std::size_t i = 0; i < candidates.size(); ++i)
+        lowerBounds[i] = scales[i] * calcDTWLowerBound(path, candidates[i]);
+    std::vector<std::size_t> order(candidates.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::sort(order.begin(), order.end(),
+              [&lowerBounds](std::size_t a, std::size_t b) { return lowerBounds[a] < lowerBounds[b]; });
+
+    numThreads = std::max(1u, std::min<unsigned int>(numThreads, candidates.size()));
+    std::vector<double> bestValue(numThreads, std::numeric_limits<double>::infinity());
+    std::vector<std::size_t> bestIndex(numThreads, candidates.size());
+    // The best value found by any thread, used as a shared bound for early abandoning
+    std::atomic<double> sharedBound(std::numeric_limits<double>::infinity());
+
+    auto worker = [&](unsigned int t, std::vector<double> &prevRow, std::vector<double> &currRow)
+    {
+        for (std::size_t k = t; k < order.size(); k += numThreads)
+        {
+            std::size_t c = order[k];
+            double bound = sharedBound.load();
+            // All remaining candidates have an even larger lower bound
+            if (lowerBounds[c] >= bound)
+                break;
+            double v = scales[c] * computeDistance(path, candidates[c], bound / scales[c], prevRow, currRow);
+            if (v < bestValue[t])
+            {
+                bestValue[t] = v;
+                bestIndex[t] = c;
+                while (v < bound && !sharedBound.compare_exchange_weak(bound, v))
+                    ;
+            }
+        }
+    };
+
+    if (numThreads == 1)
+        worker(0, prevRow_, currRow_);
+    else
+    {
+        std::vector<std::thread> threads;
+        std::vector<std::vector<double>> rows(2 * numThreads);
+        threads.reserve(numThreads);
+        for (unsigned int t = 0; t < numThreads; ++t)
+            threads.emplace_back(worker, t, std::ref(rows[2 * t]), std::ref(rows[2 * t + 1]));
+        for (auto &thread : threads)
+            thread.join();
+    }
+
+    std::size_t result = candidates.size();
+    for (unsigned int t = 0; t < numThreads; ++t)
+        if (bestValue[t] < value)
+        {
+            value = bestValue[t];
+            result = bestIndex[t];
+        }
+    return result;
+}
@@ -37,6 +37,9 @@
 #include "ompl/tools/lightning/Lightning.h"
 #include "ompl/tools/lightning/LightningDB.h"
 
+#include <limits>
+#include <vector>
+
 namespace og = ompl::geometric;
 namespace ob = ompl::base;
 namespace ot = ompl::tools;
@@ -254,15 +257,26 @@ ompl::base::PlannerStatus ompl::tools::Lightning::solve(const base::PlannerTermi
                 // Benchmark runtime
                 time::point startTime = time::now();
 
-                // Convert the original recalled path to PathGeometric
-                ob::PlannerDataPtr chosenRecallPathData = getLightningRetrieveRepairPlanner().getChosenRecallPath();
-                og::PathGeometric chosenRecallPath(si_);
-                convertPlannerData(chosenRecallPathData, chosenRecallPath);
+                // Compare with all the recalled paths, not only the one that was repaired, so the solution is not
+                // stored if it is close to any path near this query. The scores are those of getPathsScore(): the
+                // paths are interpolated and the DTW distance is divided by the number of states.
+                og::PathGeometric interpolatedSolution(solutionPath);
+                interpolatedSolution.interpolate();
+                std::vector<og::PathGeometric> recalledPaths;
+                for (const auto &recalledPathData : getLightningRetrieveRepairPlanner().getLastRecalledNearestPaths())
+                {
+                    recalledPaths.emplace_back(si_);
+                    convertPlannerData(recalledPathData, recalledPaths.back());
 
-                // Reverse path2 if necessary so that it matches path1 better
-                reversePathIfNecessary(solutionPath, chosenRecallPath);
+                    // Reverse the recalled path if necessary so that it matches the solution better
+                    reversePathIfNecessary(interpolatedSolution, recalledPaths.back());
+                    recalledPaths.back().interpolate();
+                }
 
-                double score = dtw_->getPathsScore(solutionPath, chosenRecallPath);
+                // The best scoring recalled path is found with early abandoning, which skips most of the others
+                double score;
+                if (dtw_->findBestScoringPath(interpolatedSolution, recalledPaths, score) == recalledPaths.size())
+                    score = std::numeric_limits<double>::max();  // the worst score possible
                 log.score = score;
 
                 if (score < 4)
@@ -44,6 +44,9 @@
 // Boost
 #include <boost/filesystem.hpp>
 
+#include <algorithm>
+#include <mutex>
+
 ompl::tools::LightningDB::LightningDB(const base::StateSpacePtr &space)
 {
     si_ = std::make_shared<base::SpaceInformation>(space);
@@ -56,17 +59,38 @@ ompl::tools::LightningDB::LightningDB(const base::StateSpacePtr &space)
                              {
                                  return distanceFunction(a, b);
                              });
-
-    // Load the PlannerData instance to be used for searching
-    nnSearchKey_ = std::make_shared<ompl::base::PlannerData>(si_);
 }
 
 ompl::tools::LightningDB::~LightningDB()
 {
-    if (numUnsavedPaths_)
+    if (!unsavedPaths_.empty())
         OMPL_WARN("The database is being unloaded with unsaved experiences");
 }
 
+std::string ompl::tools::LightningDB::shardFileName(const std::string &fileName, std::size_t index)
+{
+    // The first shard uses the original file name, so single-shard databases keep their format
+    return index == 0 ? fileName : fileName + ".shard" + std::to_string(index);
+}
+
+bool ompl::tools::LightningDB::readShardHeader(const std::string &fileName, std::size_t &numPaths)
+{
+    std::ifstream iStream(fileName.c_str(), std::ios::binary);
+
+    // Get the total number of paths saved
+    double num = -1;
+    iStream >> num;
+
+    // Check that the number of paths makes sense
+    if (!iStream || num < 0 || num > std::numeric_limits<double>::max())
+    {
+        OMPL_WARN("Number of paths to load %f is a bad value", num);
+        return false;
+    }
+    numPaths = num;
+    return true;
+}
+
 bool ompl::tools::LightningDB::load(const std::string &fileName)
 {
     // Error checking
@@ -81,44 +105,108 @@ bool ompl::tools::LightningDB::load(const std::string &fileName)
         return false;
     }
 
-    // Load database from file, track loading time
-    time::point start = time::now();
+    std::unique_lock<std::shared_timed_mutex> lock(mutex_);
 
     OMPL_INFORM("Loading database from file: %s", fileName.c_str());
 
-    // Open a binary input stream
-    std::ifstream iStream(fileName.c_str(), std::ios::binary);
+    // Register all shards; their paths are read on first use. Nothing is changed until every header was read.
+    std::vector<Shard> shards;
+    std::size_t numPaths = 0;
+    for (std::size_t index = 0; boost::filesystem::exists(shardFileName(fileName, index)); ++index)
+    {
+        Shard shard{shardFileName(fileName, index), 0u, false, false};
+        if (!readShardHeader(shard.fileName, shard.numPaths))
+            return false;
+        numPaths += shard.numPaths;
+        shards.push_back(shard);
+    }
 
-    // Get the total number of paths saved
-    double numPaths = 0;
-    iStream >> numPaths;
+    // The loaded database replaces the paths of the previous one, except for the ones that were not saved yet; they
+    // are kept so that they can be saved to the loaded database
+    nn_->clear();
+    nn_->add(unsavedPaths_);
+    shards_.swap(shards);
+    numPendingShards_ = shards_.size();
+    databaseFile_ = fileName;
 
-    // Check that the number of paths makes sense
-    if (numPaths < 0 || numPaths > std::numeric_limits<double>::max())
+    OMPL_INFORM("Found %d paths in %d shards", numPaths, shards_.size());
+    return true;
+}
+
+bool ompl::tools::LightningDB::loadPendingShards() const
+{
+    if (numPendingShards_ == 0u)
     {
-        OMPL_WARN("Number of paths to load %d is a bad value", numPaths);
-        return false;
+        std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+        return std::none_of(shards_.begin(), shards_.end(), [](const Shard &shard) { return shard.failed; });
     }
 
-    // Start loading all the PlannerDatas
-    for (std::size_t i = 0; i < numPaths; ++i)
-    {
-        // Create a new planner data instance
-        auto plannerData(std::make_shared<ompl::base::PlannerData>(si_));
+    std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+    ompl::base::PlannerDataStorage plannerDataStorage;
+    bool result = true;
 
-        // Note: the StateStorage class checks if the states match for us
-        plannerDataStorage_.load(iStream, *plannerData.get());
+    // Another thread may have loaded the shards while we were waiting for the lock
+    for (auto &shard : shards_)
+    {
+        if (shard.failed)
+            result = false;
+        if (shard.loaded || shard.failed)
+            continue;
+
+        // Load shard from file, track loading time
+        time::point start = time::now();
+
+        // Open a binary input stream
+        std::ifstream iStream(shard.fileName.c_str(), std::ios::binary);
+
+        // Skip the number of paths, which is already known
+        double numPaths = 0;
+        iStream >> numPaths;
+
+        // Start loading all the PlannerDatas; they are only added if the whole shard can be read
+        std::vector<ompl::base::PlannerDataPtr> plannerDatas;
+        for (std::size_t i = 0; i < shard.numPaths && iStream; ++i)
+        {
+            // Create a new planner data instance
+            auto plannerData(std::make_shared<ompl::base::PlannerData>(si_));
+
+            // Note: the StateStorage class checks if the states match for us. A path that cannot be read is
+            // left empty, or corrupt data makes the archive throw.
+            try
+            {
+                plannerDataStorage.load(iStream, *plannerData.get());
+            }
+            catch (std::exception &e)
+            {
+                OMPL_ERROR("Failed to load a path: %s", e.what());
+                break;
+            }
+            if (plannerData->numVertices() == 0)
+                break;
+            plannerDatas.push_back(plannerData);
+        }
+
+        // Close file
+        iStream.close();
+
+        --numPendingShards_;
+        if (plannerDatas.size() < shard.numPaths)
+        {
+            OMPL_ERROR("Unable to read path %d of database shard %s", plannerDatas.size(), shard.fileName.c_str());
+            shard.failed = true;
+            result = false;
+            continue;
+        }
 
         // Add to nearest neighbor tree
-        nn_->add(plannerData);
-    }
-
-    // Close file
-    iStream.close();
+        nn_->add(plannerDatas);
+        shard.loaded = true;
 
-    double loadTime = time::seconds(time::now() - start);
-    OMPL_INFORM("Loaded database from file in %f sec with %d paths", loadTime, nn_->size());
-    return true;
+        double loadTime = time::seconds(time::now() - start);
+        OMPL_INFORM("Loaded database shard %s in %f sec with %d paths", shard.fileName.c_str(), loadTime,
+                    shard.numPaths);
+    }
+    return result;
 }
 
 void ompl::tools::LightningDB::addPath(ompl::geometric::PathGeometric &solutionPath, double &insertionTime)
@@ -147,18 +235,41 @@ void ompl::tools::LightningDB::addPathHelper(ompl::geometric::PathGeometric &sol
     // Deep copy the states in the vertices so that when the planner goes out of scope, all data remains intact
     plannerData->decoupleFromPlanner();
 
+    std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+
     // Add to nearest neighbor tree
     nn_->add(plannerData);
 
-    numUnsavedPaths_++;
+    unsavedPaths_.push_back(plannerData);
 }
 
 bool ompl::tools::LightningDB::saveIfChanged(const std::string &fileName)
 {
-    if (numUnsavedPaths_)
-        return save(fileName);
-    else
+    std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+
+    if (unsavedPaths_.empty())
+    {
         OMPL_INFORM("Not saving because database has not changed");
+        return true;
+    }
+
+    // Appending is only possible to the database we loaded from or saved to
+    if (fileName.empty() || fileName != databaseFile_ || !boost::filesystem::exists(fileName))
+    {
+        lock.unlock();
+        return save(fileName);
+    }
+
+    // Write the new paths to a new shard; existing shards are left untouched
+    std::size_t index = 1;
+    while (boost::filesystem::exists(shardFileName(fileName, index)))
+        ++index;
+    Shard shard{shardFileName(fileName, index), unsavedPaths_.size(), true, false};
+    if (!writeShard(shard.fileName, unsavedPaths_))
+        return false;
+    shards_.push_back(shard);
+    unsavedPaths_.clear();
+
     return true;
 }
 
@@ -171,6 +282,49 @@ bool ompl::tools::LightningDB::save(const std::string &fileName)
         return false;
     }
 
+    // All paths need to be in memory before they can be written to a single file
+    if (!loadPendingShards())
+    {
+        OMPL_ERROR("Not saving the database to %s: some of its paths could not be loaded", fileName.c_str());
+        return false;
+    }
+
+    std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+
+    // Convert the NN tree to a vector
+    std::vector<ompl::base::PlannerDataPtr> plannerDatas;
+    nn_->list(plannerDatas);
+
+    // Write to a temporary file first, so that the previous database survives a failed save
+    const std::string tempFileName = fileName + ".tmp";
+    if (!writeShard(tempFileName, plannerDatas))
+    {
+        boost::filesystem::remove(tempFileName);
+        return false;
+    }
+    boost::system::error_code ec;
+    boost::filesystem::rename(tempFileName, fileName, ec);
+    if (ec)
+    {
+        OMPL_ERROR("Unable to rename %s to %s: %s", tempFileName.c_str(), fileName.c_str(), ec.message().c_str());
+        boost::filesystem::remove(tempFileName);
+        return false;
+    }
+
+    // Remove left-over shards of a previous database stored under the same name
+    for (std::size_t index = 1; boost::filesystem::exists(shardFileName(fileName, index)); ++index)
+        boost::filesystem::remove(shardFileName(fileName, index));
+
+    shards_.assign(1, Shard{fileName, plannerDatas.size(), true, false});
+    databaseFile_ = fileName;
+    unsavedPaths_.clear();
+
+    return true;
+}
+
+bool ompl::tools::LightningDB::writeShard(const std::string &fileName,
+                                          const std::vector<ompl::base::PlannerDataPtr> &plannerDatas)
+{
     // Save database from file, track saving time
     time::point start = time::now();
 
@@ -178,65 +332,67 @@ bool ompl::tools::LightningDB::save(const std::string &fileName)
 
     // Open a binary output stream
     std::ofstream outStream(fileName.c_str(), std::ios::binary);
-
-    // Convert the NN tree to a vector
-    std::vector<ompl::base::PlannerDataPtr> plannerDatas;
-    nn_->list(plannerDatas);
+    if (!outStream)
+    {
+        OMPL_ERROR("Unable to open database file %s for writing", fileName.c_str());
+        return false;
+    }
 
     // Write the number of paths we will be saving
     double numPaths = plannerDatas.size();
     outStream << numPaths;
 
     // Start saving each planner data object
-    for (std::size_t i = 0; i < numPaths; ++i)
+    for (const auto &plannerData : plannerDatas)
     {
-        ompl::base::PlannerData &pd = *plannerDatas[i].get();
-
         // Save a single planner data
-        plannerDataStorage_.store(pd, outStream);
+        plannerDataStorage_.store(*plannerData, outStream);
     }
 
     // Close file
     outStream.close();
+    if (!outStream)
+    {
+        OMPL_ERROR("Unable to write database file %s", fileName.c_str());
+        return false;
+    }
 
     // Benchmark
-    double loadTime = time::seconds(time::now() - start);
-    OMPL_INFORM("Saved database to file in %f sec with %d paths", loadTime, plannerDatas.size());
-
-    numUnsavedPaths_ = 0;
+    double saveTime = time::seconds(time::now() - start);
+    OMPL_INFORM("Saved database to file in %f sec with %d paths", saveTime, plannerDatas.size());
 
     return true;
 }
 
-void ompl::tools::LightningDB::getAllPlannerDatas(std::vector<ompl::base::PlannerDataPtr> &plannerDatas) const
+bool ompl::tools::LightningDB::getAllPlannerDatas(std::vector<ompl::base::PlannerDataPtr> &plannerDatas) const
 {
     OMPL_DEBUG("LightningDB: getAllPlannerDatas");
 
+    bool result = loadPendingShards();
+    std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+
     // Convert the NN tree to a vector
     nn_->list(plannerDatas);
 
     OMPL_DEBUG("Number of paths found: %d", plannerDatas.size());
+    return result;
 }
 
 std::vector<ompl::base::PlannerDataPtr> ompl::tools::LightningDB::findNearestStartGoal(int nearestK,
                                                                                        const base::State *start,
                                                                                        const base::State *goal)
 {
-    // Fill in our pre-made PlannerData instance with the new start and goal states to be searched for
-    if (nnSearchKey_->numVertices() == 2)
-    {
-        nnSearchKey_->getVertex(0) = ompl::base::PlannerDataVertex(start);
-        nnSearchKey_->getVertex(1) = ompl::base::PlannerDataVertex(goal);
-    }
-    else
-    {
-        nnSearchKey_->addVertex(ompl::base::PlannerDataVertex(start));
-        nnSearchKey_->addVertex(ompl::base::PlannerDataVertex(goal));
-    }
-    assert(nnSearchKey_->numVertices() == 2);
+    // Fill in a PlannerData instance with the new start and goal states to be searched for. The instance is local
+    // so that queries from multiple threads do not interfere.
+    auto nnSearchKey(std::make_shared<ompl::base::PlannerData>(si_));
+    nnSearchKey->addVertex(ompl::base::PlannerDataVertex(start));
+    nnSearchKey->addVertex(ompl::base::PlannerDataVertex(goal));
+
+    loadPendingShards();
+    std::shared_lock<std::shared_timed_mutex> lock(mutex_);
 
     std::vector<ompl::base::PlannerDataPtr> nearest;
-    nn_->nearestK(nnSearchKey_, nearestK, nearest);
+    nn_->nearestK(nnSearchKey, nearestK, nearest);
 
     return nearest;
 }
@@ -256,7 +412,26 @@ double ompl::tools::LightningDB::distanceFunction(const ompl::base::PlannerDataP
 
 std::size_t ompl::tools::LightningDB::getExperiencesCount() const
 {
-    return nn_->size();
+    std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+
+    // Shards that are not loaded yet know how many paths they hold
+    std::size_t count = nn_->size();
+    for (const auto &shard : shards_)
+        if (!shard.loaded)
+            count += shard.numPaths;
+    return count;
+}
+
+int ompl::tools::LightningDB::getNumUnsavedPaths() const
+{
+    std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+    return unsavedPaths_.size();
+}
+
+std::size_t ompl::tools::LightningDB::getShardsCount() const
+{
+    std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+    return shards_.size();
 }
 
 std::size_t ompl::tools::LightningDB::getStatesCount() const
@@ -264,6 +439,9 @@ std::size_t ompl::tools::LightningDB::getStatesCount() const
     // Loop through every PlannerData and sum the number of states
     std::size_t statesCount = 0;
 
+    loadPendingShards();
+    std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+
     // Convert the NN tree to a vector
     std::vector<ompl::base::PlannerDataPtr> plannerDatas;
     nn_->list(plannerDatas);
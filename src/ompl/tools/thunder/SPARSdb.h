@@ -53,6 +53,10 @@
 #include <boost/graph/connected_components.hpp>
 #include <boost/property_map/property_map.hpp>
 #include <boost/pending/disjoint_sets.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #include <thread>
 #include <iostream>
 #include <fstream>
@@ -454,6 +458,18 @@ namespace ompl
 
             bool addStateToRoadmap(const base::PlannerTerminationCondition &ptc, base::State *newState);
 
+            /** \brief Queue a copy of \e solutionPath for insertion into the roadmap and return immediately. Queued
+                paths are added by a background thread, one state at a time, so that getSimilarPaths() can run in
+                between and always sees the roadmap as it was after a completed state insertion. clear() discards the
+                paths that have not been added yet. */
+            void addPathToRoadmapAsync(const ompl::geometric::PathGeometric &solutionPath);
+
+            /** \brief Block until all paths queued with addPathToRoadmapAsync() have been added to the roadmap */
+            void waitForPendingPaths();
+
+            /** \brief Get the number of paths queued with addPathToRoadmapAsync() that have not been added yet */
+            std::size_t getNumPendingPaths() const;
+
             /** \brief Function that can solve the motion planning
                 problem. This function can be called multiple times on
                 the same problem, without calling clear() in
@@ -501,7 +517,8 @@ namespace ompl
 
             void setup() override;
 
-            /** \brief Retrieve the computed roadmap. */
+            /** \brief Retrieve the computed roadmap. The graph is not protected against paths inserted by
+                addPathToRoadmapAsync(); call waitForPendingPaths() before reading it. */
             const Graph &getRoadmap() const
             {
                 return g_;
@@ -510,28 +527,19 @@ namespace ompl
             /** \brief Get the number of vertices in the sparse roadmap. */
             unsigned int getNumVertices() const
             {
+                std::lock_guard<std::mutex> lock(graphMutex_);
                 return boost::num_vertices(g_);
             }
 
             /** \brief Get the number of edges in the sparse roadmap. */
             unsigned int getNumEdges() const
             {
+                std::lock_guard<std::mutex> lock(graphMutex_);
                 return boost::num_edges(g_);
             }
 
             /** \brief Get the number of disjoint sets in the sparse roadmap. */
-            unsigned int getNumConnectedComponents() const
-            {
-                // Make sure graph is populated
-                if (getNumVertices() == 0u)
-                    return 0;
-
-                std::vector<int> components(boost::num_vertices(g_));
-
-                // it always overcounts by 1, i think because it is missing vertex 0 which is the new state insertion
-                // component
-                return boost::connected_components(g_, &components[0]) - 1;
-            }
+            unsigned int getNumConnectedComponents() const;
 
             /** \brief Get the number of times a path was inserted into the database and it failed to have connectivity
              */
@@ -586,6 +594,12 @@ namespace ompl
             /** \brief Free all the memory allocated by the planner */
             void freeMemory();
 
+            /** \brief Body of the background thread that adds queued paths to the roadmap */
+            void insertionThread();
+
+            /** \brief Stop the background insertion thread, discarding paths that have not been added yet */
+            void stopInsertionThread();
+
             /** \brief Check that the query vertex is initialized (used for internal nearest neighbor searches) */
             void checkQueryStateInitialization();
 
@@ -688,6 +702,10 @@ namespace ompl
              */
             bool constructSolution(Vertex start, Vertex goal, std::vector<Vertex> &vertexPath) const;
 
+            /** \brief Get the state of vertex \e v while holding graphMutex_. The state stays valid after the lock is
+                released, until the roadmap is cleared. */
+            base::State *getVertexState(Vertex v) const;
+
             /** \brief Check if two milestones (\e m1 and \e m2) are part of the same connected component. This is not a
              * const function since we use incremental connected components from boost */
             bool sameComponent(Vertex m1, Vertex m2);
@@ -730,8 +748,9 @@ namespace ompl
             /** \brief The number of consecutive failures to add to the graph before termination */
             unsigned int maxFailures_{5000u};
 
-            /** \brief Track how many solutions fail to have connectivity at end */
-            unsigned int numPathInsertionFailures_{0u};
+            /** \brief Track how many solutions fail to have connectivity at end. Atomic, since paths are inserted by
+                a background thread. */
+            std::atomic<unsigned int> numPathInsertionFailures_{0u};
 
             /** \brief Number of sample points to use when trying to detect interfaces. */
             unsigned int nearSamplePoints_;
@@ -764,7 +783,7 @@ namespace ompl
             bool addedSolution_{false};
 
             /** \brief A counter for the number of consecutive failed iterations of the algorithm */
-            unsigned int consecutiveFailures_{0u};
+            std::atomic<unsigned int> consecutiveFailures_{0u};
 
             /** \brief A counter for the number of iterations of the algorithm */
             long unsigned int iterations_{0ul};
@@ -781,6 +800,27 @@ namespace ompl
 
             /** \brief Option to enable debugging output */
             bool verbose_{false};
+
+            /** \brief Serializes modifications of and queries on the roadmap */
+            mutable std::mutex graphMutex_;
+
+            /** \brief Paths waiting to be added to the roadmap by the insertion thread */
+            std::deque<PathGeometric> pendingPaths_;
+
+            /** \brief Number of paths taken from pendingPaths_ that the insertion thread is still adding */
+            std::size_t numPathsInInsertion_{0u};
+
+            /** \brief Protects pendingPaths_ and numPathsInInsertion_ */
+            mutable std::mutex pendingPathsMutex_;
+
+            /** \brief Signals changes to pendingPaths_ and numPathsInInsertion_ */
+            std::condition_variable pendingPathsCondition_;
+
+            /** \brief Thread adding queued paths to the roadmap */
+            std::thread insertionThread_;
+
+            /** \brief Flag asking the insertion thread to terminate */
+            std::atomic<bool> stopInsertion_{false};
         };
     }
 }
@@ -88,9 +88,15 @@ namespace ompl
             /**
              * \brief Add a new solution path to our database. Des not actually save to file so
              *        experience will be lost if save() is not called
-             * \param new path - must be non-const because will be interpolated
-             * \param returned insertion time to add to db
-             * \return true on success
+             * \note The path is copied and added to the roadmap by a background thread of SPARSdb, so
+             *       it may not be part of the roadmap yet when this function returns. save() waits for
+             *       all queued paths; clearing the SPARSdb planner discards the ones not yet added.
+             *       Whether a queued path was connected in the roadmap is only known once it has been
+             *       inserted; failures are counted by SPARSdb::getNumPathInsertionFailed().
+             * \param new path
+             * \param returned time taken to queue the path
+             * \return true if the path was queued, false if it was rejected right away. This does not
+             *         mean the path was added to the roadmap.
              */
             bool addPath(ompl::geometric::PathGeometric &solutionPath, double &insertionTime);
 
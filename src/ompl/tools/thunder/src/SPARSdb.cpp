@@ -128,6 +128,7 @@ ompl::geometric::SPARSdb::SPARSdb(const base::SpaceInformationPtr &si)
 
 ompl::geometric::SPARSdb::~SPARSdb()
 {
+    stopInsertionThread();
     freeMemory();
 }
 
@@ -163,6 +164,7 @@ void ompl::geometric::SPARSdb::clearQuery()
 
 void ompl::geometric::SPARSdb::clear()
 {
+    stopInsertionThread();
     Planner::clear();
     clearQuery();
     resetFailures();
@@ -197,27 +199,36 @@ bool ompl::geometric::SPARSdb::getSimilarPaths(int /*nearestK*/, const base::Sta
 {
     // TODO: nearestK unused
 
-    // Get neighbors near start and goal. Note: potentially they are not *visible* - will test for this later
-
-    // Start
-    OMPL_INFORM("Looking for a node near the problem start");
-    if (!findGraphNeighbors(start, startVertexCandidateNeighbors_))
+    // Queries see the roadmap as it is between two state insertions. The lock is only held while the graph is
+    // read or updated, not during collision checks, so that paths can be inserted in the meantime.
     {
-        OMPL_INFORM("No graph neighbors found for start within radius %f", sparseDelta_);
-        return false;
-    }
-    if (verbose_)
-        OMPL_INFORM("Found %d nodes near start", startVertexCandidateNeighbors_.size());
+        std::lock_guard<std::mutex> lock(graphMutex_);
 
-    // Goal
-    OMPL_INFORM("Looking for a node near the problem goal");
-    if (!findGraphNeighbors(goal, goalVertexCandidateNeighbors_))
-    {
-        OMPL_INFORM("No graph neighbors found for goal within radius %f", sparseDelta_);
-        return false;
+        // The query may come before the insertion thread added the first state
+        checkQueryStateInitialization();
+
+        // Get neighbors near start and goal. Note: potentially they are not *visible* - will test for this later
+
+        // Start
+        OMPL_INFORM("Looking for a node near the problem start");
+        if (!findGraphNeighbors(start, startVertexCandidateNeighbors_))
+        {
+            OMPL_INFORM("No graph neighbors found for start within radius %f", sparseDelta_);
+            return false;
+        }
+        if (verbose_)
+            OMPL_INFORM("Found %d nodes near start", startVertexCandidateNeighbors_.size());
+
+        // Goal
+        OMPL_INFORM("Looking for a node near the problem goal");
+        if (!findGraphNeighbors(goal, goalVertexCandidateNeighbors_))
+        {
+            OMPL_INFORM("No graph neighbors found for goal within radius %f", sparseDelta_);
+            return false;
+        }
+        if (verbose_)
+            OMPL_INFORM("Found %d nodes near goal", goalVertexCandidateNeighbors_.size());
     }
-    if (verbose_)
-        OMPL_INFORM("Found %d nodes near goal", goalVertexCandidateNeighbors_.size());
 
     // Get paths between start and goal
     bool result =
@@ -260,7 +271,7 @@ bool ompl::geometric::SPARSdb::getPaths(const std::vector<Vertex> &candidateStar
     foreach (Vertex start, candidateStarts)
     {
         // Check if this start is visible from the actual start
-        if (!si_->checkMotion(actualStart, stateProperty_[start]))
+        if (!si_->checkMotion(actualStart, getVertexState(start)))
         {
             if (verbose_)
                 OMPL_WARN("FOUND CANDIDATE START THAT IS NOT VISIBLE ");
@@ -270,7 +281,7 @@ bool ompl::geometric::SPARSdb::getPaths(const std::vector<Vertex> &candidateStar
         foreach (Vertex goal, candidateGoals)
         {
             if (verbose_)
-                OMPL_INFORM("  foreach_goal: Checking motion from  %d to %d", actualGoal, stateProperty_[goal]);
+                OMPL_INFORM("  foreach_goal: Checking motion from  %d to %d", actualGoal, getVertexState(goal));
 
             // Check if our planner is out of time
             if (ptc == true)
@@ -280,7 +291,7 @@ bool ompl::geometric::SPARSdb::getPaths(const std::vector<Vertex> &candidateStar
             }
 
             // Check if this goal is visible from the actual goal
-            if (!si_->checkMotion(actualGoal, stateProperty_[goal]))
+            if (!si_->checkMotion(actualGoal, getVertexState(goal)))
             {
                 if (verbose_)
                     OMPL_INFORM("FOUND CANDIDATE GOAL THAT IS NOT VISIBLE! ");
@@ -330,7 +341,7 @@ bool ompl::geometric::SPARSdb::lazyCollisionSearch(const Vertex &start, const Ve
     }
 
     // TODO: remove this because start and goal are not either start nor goals
-    if (!g->isStartGoalPairValid(stateProperty_[goal], stateProperty_[start]))
+    if (!g->isStartGoalPairValid(getVertexState(goal), getVertexState(start)))
     {
         if (verbose_)
             OMPL_INFORM("    Start and goal pair are not valid combinations, skipping ");
@@ -362,7 +373,12 @@ bool ompl::geometric::SPARSdb::lazyCollisionSearch(const Vertex &start, const Ve
         }
 
         // Attempt to find a solution from start to goal
-        if (!constructSolution(start, goal, vertexPath))
+        bool constructed;
+        {
+            std::lock_guard<std::mutex> lock(graphMutex_);
+            constructed = constructSolution(start, goal, vertexPath);
+        }
+        if (!constructed)
         {
             // We will stop looking through this start-goal combination, but perhaps this partial solution is good
             if (verbose_)
@@ -374,6 +390,7 @@ bool ompl::geometric::SPARSdb::lazyCollisionSearch(const Vertex &start, const Ve
                 if (verbose_)
                     OMPL_INFORM("has partial solution ");
                 // Save this candidateSolution for later
+                std::lock_guard<std::mutex> lock(graphMutex_);
                 convertVertexPathToStatePath(vertexPath, actualStart, actualGoal, candidateSolution);
                 return false;
             }
@@ -403,6 +420,7 @@ bool ompl::geometric::SPARSdb::lazyCollisionSearch(const Vertex &start, const Ve
             }
 
             // the path is valid, we are done!
+            std::lock_guard<std::mutex> lock(graphMutex_);
             convertVertexPathToStatePath(vertexPath, actualStart, actualGoal, candidateSolution);
             return true;
         }
@@ -506,29 +524,39 @@ bool ompl::geometric::SPARSdb::lazyCollisionCheck(std::vector<Vertex> &vertexPat
             return false;
         }
 
-        Edge thisEdge = boost::edge(fromVertex, toVertex, g_).first;
-
-        // Has this edge already been checked before?
-        if (edgeCollisionStateProperty_[thisEdge] == NOT_CHECKED)
+        // Has this edge already been checked before? The states outlive the lock, but edge descriptors may be
+        // invalidated by insertions, so the edge is looked up again after the collision check
+        int edgeCollisionState;
+        const base::State *fromState, *toState;
+        {
+            std::lock_guard<std::mutex> lock(graphMutex_);
+            edgeCollisionState = edgeCollisionStateProperty_[boost::edge(fromVertex, toVertex, g_).first];
+            fromState = stateProperty_[fromVertex];
+            toState = stateProperty_[toVertex];
+        }
+        if (edgeCollisionState == NOT_CHECKED)
         {
             // Check path between states
-            if (!si_->checkMotion(stateProperty_[fromVertex], stateProperty_[toVertex]))
+            if (!si_->checkMotion(fromState, toState))
             {
                 // Path between (from, to) states not valid, disable the edge
                 OMPL_INFORM("  DISABLING EDGE from vertex %f to vertex %f", fromVertex, toVertex);
 
                 // Disable edge
-                edgeCollisionStateProperty_[thisEdge] = IN_COLLISION;
+                edgeCollisionState = IN_COLLISION;
             }
             else
             {
                 // Mark edge as free so we no longer need to check for collision
-                edgeCollisionStateProperty_[thisEdge] = FREE;
+                edgeCollisionState = FREE;
             }
+
+            std::lock_guard<std::mutex> lock(graphMutex_);
+            edgeCollisionStateProperty_[boost::edge(fromVertex, toVertex, g_).first] = edgeCollisionState;
         }
 
         // Check final result
-        if (edgeCollisionStateProperty_[thisEdge] == IN_COLLISION)
+        if (edgeCollisionState == IN_COLLISION)
         {
             // Remember that this path is no longer valid, but keep checking remainder of path edges
             hasInvalidEdges = true;
@@ -546,6 +574,12 @@ bool ompl::geometric::SPARSdb::lazyCollisionCheck(std::vector<Vertex> &vertexPat
     return !hasInvalidEdges;
 }
 
+ompl::base::State *ompl::geometric::SPARSdb::getVertexState(Vertex v) const
+{
+    std::lock_guard<std::mutex> lock(graphMutex_);
+    return stateProperty_[v];
+}
+
 bool ompl::geometric::SPARSdb::sameComponent(Vertex m1, Vertex m2)
 {
     return boost::same_component(m1, m2, disjointSets_);
@@ -567,8 +601,10 @@ void ompl::geometric::SPARSdb::printDebug(std::ostream &out) const
     out << "    Stretch Factor: " << getStretchFactor() << std::endl;
     out << "    Maximum Extent: " << si_->getMaximumExtent() << std::endl;
     out << "  Status: " << std::endl;
-    out << "    Vertices Count: " << getNumVertices() << std::endl;
-    out << "    Edges Count:    " << getNumEdges() << std::endl;
+
+    std::lock_guard<std::mutex> lock(graphMutex_);
+    out << "    Vertices Count: " << boost::num_vertices(g_) << std::endl;
+    out << "    Edges Count:    " << boost::num_edges(g_) << std::endl;
     out << "    Iterations: " << getIterations() << std::endl;
     out << "    Consecutive Failures: " << consecutiveFailures_ << std::endl;
     out << "    Number of guards: " << nn_->size() << std::endl << std::endl;
@@ -642,7 +678,10 @@ bool ompl::geometric::SPARSdb::addPathToRoadmap(const base::PlannerTerminationCo
                                                 ompl::geometric::PathGeometric &solutionPath)
 {
     // Check that the query vertex is initialized (used for internal nearest neighbor searches)
-    checkQueryStateInitialization();
+    {
+        std::lock_guard<std::mutex> lock(graphMutex_);
+        checkQueryStateInitialization();
+    }
 
     // Error check
     if (solutionPath.getStateCount() < 2)
@@ -850,6 +889,8 @@ bool ompl::geometric::SPARSdb::checkStartGoalConnection(ompl::geometric::PathGeo
         return false;
     }
 
+    std::lock_guard<std::mutex> lock(graphMutex_);
+
     bool error = false;
     CandidateSolution candidateSolution;
     do
@@ -939,6 +980,10 @@ bool ompl::geometric::SPARSdb::checkStartGoalConnection(ompl::geometric::PathGeo
 bool ompl::geometric::SPARSdb::addStateToRoadmap(const base::PlannerTerminationCondition &ptc, base::State *newState)
 {
     bool stateAdded = false;
+
+    // The lock is only held for a single state, so that queries do not wait for entire paths to be added
+    std::lock_guard<std::mutex> lock(graphMutex_);
+
     // Check that the query vertex is initialized (used for internal nearest neighbor searches)
     checkQueryStateInitialization();
 
@@ -1047,6 +1092,89 @@ bool ompl::geometric::SPARSdb::addStateToRoadmap(const base::PlannerTerminationC
     return stateAdded;
 }
 
+void ompl::geometric::SPARSdb::addPathToRoadmapAsync(const ompl::geometric::PathGeometric &solutionPath)
+{
+    std::lock_guard<std::mutex> lock(pendingPathsMutex_);
+    pendingPaths_.push_back(solutionPath);
+    if (!insertionThread_.joinable())
+        insertionThread_ = std::thread(&SPARSdb::insertionThread, this);
+    pendingPathsCondition_.notify_all();
+}
+
+void ompl::geometric::SPARSdb::waitForPendingPaths()
+{
+    std::unique_lock<std::mutex> lock(pendingPathsMutex_);
+    pendingPathsCondition_.wait(lock, [this]
+                                {
+                                    return pendingPaths_.empty() && numPathsInInsertion_ == 0;
+                                });
+}
+
+std::size_t ompl::geometric::SPARSdb::getNumPendingPaths() const
+{
+    std::lock_guard<std::mutex> lock(pendingPathsMutex_);
+    return pendingPaths_.size() + numPathsInInsertion_;
+}
+
+void ompl::geometric::SPARSdb::insertionThread()
+{
+    base::PlannerTerminationCondition ptc([this]
+                                          {
+                                              return stopInsertion_.load();
+                                          });
+
+    std::unique_lock<std::mutex> lock(pendingPathsMutex_);
+    while (true)
+    {
+        pendingPathsCondition_.wait(lock, [this]
+                                    {
+                                        return stopInsertion_ || !pendingPaths_.empty();
+                                    });
+        if (stopInsertion_)
+            break;
+
+        // Take all paths queued so far as one batch
+        std::deque<PathGeometric> batch;
+        batch.swap(pendingPaths_);
+        numPathsInInsertion_ = batch.size();
+        lock.unlock();
+
+        for (auto &path : batch)
+        {
+            if (ptc)
+                break;
+            if (!addPathToRoadmap(ptc, path))
+                OMPL_DEBUG("%s: Queued path was not fully connected in the roadmap", getName().c_str());
+        }
+
+        lock.lock();
+        numPathsInInsertion_ = 0;
+        pendingPathsCondition_.notify_all();
+    }
+}
+
+void ompl::geometric::SPARSdb::stopInsertionThread()
+{
+    if (!insertionThread_.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(pendingPathsMutex_);
+        stopInsertion_ = true;
+        pendingPathsCondition_.notify_all();
+    }
+    insertionThread_.join();
+
+    std::lock_guard<std::mutex> lock(pendingPathsMutex_);
+    if (!pendingPaths_.empty())
+        OMPL_WARN("%s: Discarding %d paths that were not added to the roadmap", getName().c_str(),
+                  pendingPaths_.size());
+    pendingPaths_.clear();
+    numPathsInInsertion_ = 0;
+    stopInsertion_ = false;
+    pendingPathsCondition_.notify_all();
+}
+
 void ompl::geometric::SPARSdb::checkQueryStateInitialization()
 {
     if (boost::num_vertices(g_) < 1)
@@ -1626,8 +1754,8 @@ ompl::geometric::SPARSdb::Vertex ompl::geometric::SPARSdb::addGuard(base::State
 void ompl::geometric::SPARSdb::connectGuards(Vertex v, Vertex vp)
 {
     // OMPL_INFORM("connectGuards called ---------------------------------------------------------------- ");
-    assert(v <= getNumVertices());
-    assert(vp <= getNumVertices());
+    assert(v <= boost::num_vertices(g_));
+    assert(vp <= boost::num_vertices(g_));
 
     if (verbose_)
     {
@@ -1718,10 +1846,27 @@ bool ompl::geometric::SPARSdb::convertVertexPathToStatePath(std::vector<Vertex>
     return true;
 }
 
+unsigned int ompl::geometric::SPARSdb::getNumConnectedComponents() const
+{
+    std::lock_guard<std::mutex> lock(graphMutex_);
+
+    // Make sure graph is populated
+    if (boost::num_vertices(g_) == 0u)
+        return 0;
+
+    std::vector<int> components(boost::num_vertices(g_));
+
+    // it always overcounts by 1, i think because it is missing vertex 0 which is the new state insertion
+    // component
+    return boost::connected_components(g_, &components[0]) - 1;
+}
+
 void ompl::geometric::SPARSdb::getPlannerData(base::PlannerData &data) const
 {
     Planner::getPlannerData(data);
 
+    std::lock_guard<std::mutex> lock(graphMutex_);
+
     // Explicitly add start and goal states:
     for (unsigned long i : startM_)
         data.addStartVertex(base::PlannerDataVertex(stateProperty_[i], (int)START));
@@ -1769,6 +1914,8 @@ void ompl::geometric::SPARSdb::getPlannerData(base::PlannerData &data) const
 
 void ompl::geometric::SPARSdb::setPlannerData(const base::PlannerData &data)
 {
+    std::lock_guard<std::mutex> lock(graphMutex_);
+
     // Check that the query vertex is initialized (used for internal nearest neighbor searches)
     checkQueryStateInitialization();
 
@@ -143,23 +143,28 @@ bool ompl::tools::ThunderDB::addPath(ompl::geometric::PathGeometric &solutionPat
         return false;
     }
 
-    bool result;
-    double seconds = 120;  // 10; // a large number, should never need to use this
-    ompl::base::PlannerTerminationCondition ptc = ompl::base::timedPlannerTerminationCondition(seconds, 0.1);
+    // Reject paths that SPARSdb would not add, while the caller can still be told
+    if (solutionPath.getStateCount() < 2)
+    {
+        OMPL_ERROR("ThunderDB: Less than 2 states were passed to addPath");
+        insertionTime = 0;
+        return false;
+    }
 
     // Benchmark runtime
     time::point startTime = time::now();
     {
-        result = spars_->addPathToRoadmap(ptc, solutionPath);
+        // The roadmap is grown in the background; save() waits for the queued paths to be added
+        spars_->addPathToRoadmapAsync(solutionPath);
     }
     insertionTime = time::seconds(time::now() - startTime);
 
-    OMPL_INFORM("SPARSdb now has %d states", spars_->getNumVertices());
+    OMPL_INFORM("SPARSdb has %d paths waiting to be added to the roadmap", spars_->getNumPendingPaths());
 
     // Record this new addition
     numPathsInserted_++;
 
-    return result;
+    return true;
 }
 
 bool ompl::tools::ThunderDB::saveIfChanged(const std::string &fileName)
@@ -195,6 +200,9 @@ bool ompl::tools::ThunderDB::save(const std::string &fileName)
     // Save database from file, track saving time
     time::point start = time::now();
 
+    // Include the paths that are still being added to the roadmap
+    spars_->waitForPendingPaths();
+
     OMPL_INFORM("Saving database to file: %s", fileName.c_str());
 
     // Open a binary output stream
@@ -69,6 +69,11 @@ namespace ompl
         /** \brief Transform a point from a sphere to PHS. The return variable \e phs is expected to already exist.  */
         void transform(const double sphere[], double phs[]) const;
 
+        /** \brief Transform \e count points from a sphere to the PHS in one block operation. The points are stored
+         * consecutively (i.e., as the columns of a column-major dimension-by-count matrix) in \e spheres, and the
+         * return variable \e phs is expected to already exist with the same size. */
+        void transformBatch(const double spheres[], double phs[], unsigned int count) const;
+
         /** \brief Check if the given point lies \e in the PHS. */
         bool isInPhs(const double point[]) const;
 
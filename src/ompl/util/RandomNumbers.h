@@ -40,6 +40,7 @@
 #include <memory>
 #include <random>
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <algorithm>
 
@@ -76,6 +77,18 @@ namespace ompl
             return (upper_bound - lower_bound) * uniDist_(generator_) + lower_bound;
         }
 
+        /** \brief Fill \e out with \e n random reals between 0 and 1.
+
+            Bulk values are drawn from four interleaved xoshiro256+ generators seeded from the instance seed,
+            which is much cheaper per value than the per-call distributions and whose inner loop the compiler can
+            vectorize. The bulk stream is independent of the one used by the single-value functions, is deterministic
+            for a given local seed, and is reset by setLocalSeed(). */
+        void uniform01(double *out, std::size_t n);
+
+        /** \brief Fill \e out with \e n random reals within given bounds: [\e lower_bound, \e upper_bound). See
+            uniform01(double *, std::size_t) for details on the generator. */
+        void uniformReal(double *out, std::size_t n, double lower_bound, double upper_bound);
+
         /** \brief Generate a random integer within given bounds: [\e lower_bound, \e upper_bound] */
         int uniformInt(int lower_bound, int upper_bound)
         {
@@ -95,6 +108,11 @@ namespace ompl
             return normalDist_(generator_);
         }
 
+        /** \brief Fill \e out with \e n random reals using a normal distribution with mean 0 and variance 1. The
+            values are computed from the bulk uniform stream with the Box-Muller transform. See uniform01(double *,
+            std::size_t) for details on the generator. */
+        void gaussian01(double *out, std::size_t n);
+
         /** \brief Generate a random real using a normal distribution with given mean and variance */
         double gaussian(double mean, double stddev)
         {
@@ -191,6 +209,17 @@ namespace ompl
         std::mt19937 generator_;
         std::uniform_real_distribution<> uniDist_{0, 1};
         std::normal_distribution<> normalDist_{0, 1};
+        /** \brief The number of interleaved generators of the bulk stream */
+        static const std::size_t BULK_LANES = 4;
+
+        /** \brief Seed the bulk stream from localSeed_ */
+        void seedBulk();
+
+        /** \brief Fill \e out with \e n values in [0, 1) from the bulk stream; \e n must be a multiple of BULK_LANES */
+        void bulkUniform01(double *out, std::size_t n);
+
+        /** \brief The state of the bulk stream: the four words of each interleaved xoshiro256+ generator */
+        std::uint64_t bulkState_[4][BULK_LANES];
         // A structure holding boost::uniform_on_sphere distributions and the associated boost::variate_generators for
         // various dimension
         std::shared_ptr<SphericalData> sphericalDataPtr_;
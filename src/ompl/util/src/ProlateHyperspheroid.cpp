@@ -142,6 +142,20 @@ void ompl::ProlateHyperspheroid::transform(const double sphere[], double phs[])
     Eigen::Map<Eigen::VectorXd>(phs, dataPtr_->dim_) += dataPtr_->xCentre_;
 }
 
+void ompl::ProlateHyperspheroid::transformBatch(const double spheres[], double phs[], unsigned int count) const
+{
+    if (!dataPtr_->isTransformUpToDate_)
+    {
+        throw Exception("The transformation is not up to date in the PHS class. Has the transverse diameter been set?");
+    }
+
+    // Calculate the tranformation of all the points at once and offset each of them
+    Eigen::Map<Eigen::MatrixXd> phsMatrix(phs, dataPtr_->dim_, count);
+    phsMatrix.noalias() =
+        dataPtr_->transformationWorldFromEllipse_ * Eigen::Map<const Eigen::MatrixXd>(spheres, dataPtr_->dim_, count);
+    phsMatrix.colwise() += dataPtr_->xCentre_;
+}
+
 bool ompl::ProlateHyperspheroid::isInPhs(const double point[]) const
 {
     if (!dataPtr_->isTransformUpToDate_)
@@ -39,6 +39,7 @@
 #include "ompl/util/Console.h"
 #include <mutex>
 #include <memory>
+#include <cmath>
 #include <boost/math/constants/constants.hpp>
 #include <boost/scoped_ptr.hpp>
 #include <boost/random/uniform_on_sphere.hpp>
@@ -125,6 +126,15 @@ namespace
         std::call_once(g_once, &initRNGSeedGenerator);
         return *g_RNGSeedGenerator;
     }
+
+    /// splitmix64, used to expand the instance seed into the state of the bulk generators
+    std::uint64_t splitMix64(std::uint64_t &x)
+    {
+        std::uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
 }  // namespace
 /// @endcond
 
@@ -220,11 +230,13 @@ ompl::RNG::RNG()
   , generator_(localSeed_)
   , sphericalDataPtr_(std::make_shared<SphericalData>(&generator_))
 {
+    seedBulk();
 }
 
 ompl::RNG::RNG(std::uint_fast32_t localSeed)
   : localSeed_(localSeed), generator_(localSeed_), sphericalDataPtr_(std::make_shared<SphericalData>(&generator_))
 {
+    seedBulk();
 }
 
 void ompl::RNG::setLocalSeed(std::uint_fast32_t localSeed)
@@ -234,6 +246,7 @@ void ompl::RNG::setLocalSeed(std::uint_fast32_t localSeed)
 
     // Change the generator's seed
     generator_.seed(localSeed_);
+    seedBulk();
 
     // Reset the distributions used by the variate generators, as they can cache values
     uniDist_.reset();
@@ -241,6 +254,82 @@ void ompl::RNG::setLocalSeed(std::uint_fast32_t localSeed)
     sphericalDataPtr_->reset();
 }
 
+void ompl::RNG::seedBulk()
+{
+    std::uint64_t x = localSeed_;
+    for (auto &word : bulkState_)
+        for (auto &laneWord : word)
+            laneWord = splitMix64(x);
+}
+
+// xoshiro256+ (Blackman and Vigna, "Scrambled linear pseudorandom number generators", 2018), with the generators
+// stored word-major so that the update of all lanes is one vectorizable loop
+void ompl::RNG::bulkUniform01(double *out, std::size_t n)
+{
+    std::uint64_t(&s)[4][BULK_LANES] = bulkState_;
+    for (std::size_t i = 0; i < n; i += BULK_LANES)
+    {
+        for (std::size_t l = 0; l < BULK_LANES; ++l)
+        {
+            const std::uint64_t result = s[0][l] + s[3][l];
+            const std::uint64_t t = s[1][l] << 17;
+            s[2][l] ^= s[0][l];
+            s[3][l] ^= s[1][l];
+            s[1][l] ^= s[2][l];
+            s[0][l] ^= s[3][l];
+            s[2][l] ^= t;
+            s[3][l] = (s[3][l] << 45) | (s[3][l] >> 19);
+            // The upper 53 bits, which are the well distributed ones of xoshiro256+
+            out[i + l] = (result >> 11) * (1.0 / 9007199254740992.0);
+        }
+    }
+}
+
+void ompl::RNG::uniform01(double *out, std::size_t n)
+{
+    const std::size_t whole = n - n % BULK_LANES;
+    bulkUniform01(out, whole);
+
+    // The remainder uses the first values of one more step
+    if (whole != n)
+    {
+        double last[BULK_LANES];
+        bulkUniform01(last, BULK_LANES);
+        std::copy(last, last + (n - whole), out + whole);
+    }
+}
+
+void ompl::RNG::uniformReal(double *out, std::size_t n, double lower_bound, double upper_bound)
+{
+    assert(lower_bound <= upper_bound);
+    uniform01(out, n);
+    const double range = upper_bound - lower_bound;
+    for (std::size_t i = 0; i < n; ++i)
+        out[i] = range * out[i] + lower_bound;
+}
+
+void ompl::RNG::gaussian01(double *out, std::size_t n)
+{
+    // Box-Muller on consecutive pairs of uniform values; 1 - u is in (0, 1], so the logarithm is finite
+    const double twoPi = 2.0 * boost::math::constants::pi<double>();
+    const std::size_t numPairs = n / 2;
+    uniform01(out, 2 * numPairs);
+    for (std::size_t i = 0; i < numPairs; ++i)
+    {
+        const double r = std::sqrt(-2.0 * std::log(1.0 - out[2 * i]));
+        const double theta = twoPi * out[2 * i + 1];
+        out[2 * i] = r * std::cos(theta);
+        out[2 * i + 1] = r * std::sin(theta);
+    }
+
+    if (n % 2 != 0)
+    {
+        double last[2];
+        uniform01(last, 2);
+        out[n - 1] = std::sqrt(-2.0 * std::log(1.0 - last[0])) * std::cos(twoPi * last[1]);
+    }
+}
+
 double ompl::RNG::halfNormalReal(double r_min, double r_max, double focus)
 {
     assert(r_min <= r_max);
@@ -39,9 +39,15 @@
 
 #include <ompl/config.h>
 #include <ompl/base/samplers/deterministic/HaltonSequence.h>
+#include <ompl/base/samplers/deterministic/SobolSequence.h>
+#include <ompl/base/samplers/DeterministicStateSampler.h>
+#include <ompl/base/spaces/SE3StateSpace.h>
+#include <ompl/util/Exception.h>
 #include "../resources/haltonXD.h"
 
+#include <cmath>
 #include <iostream>
+#include <set>
 
 namespace ob = ompl::base;
 
@@ -144,3 +150,110 @@ BOOST_AUTO_TEST_CASE(Halton_10D)
         }
     }
 }
+
+BOOST_AUTO_TEST_CASE(Sobol_3D)
+{
+    // first samples of the Sobol sequence with the Joe-Kuo direction numbers
+    const double expected[8][3] = {{0., 0., 0.},         {.5, .5, .5},         {.75, .25, .25},
+                                   {.25, .75, .75},      {.375, .375, .625},   {.875, .875, .125},
+                                   {.625, .125, .875},   {.125, .625, .375}};
+    ob::SobolSequence ss3d(3);
+    for (const auto &e : expected)
+    {
+        std::vector<double> sample = ss3d.sample();
+        BOOST_REQUIRE_EQUAL(sample.size(), 3u);
+        for (unsigned int j = 0; j < 3; ++j)
+            BOOST_CHECK_EQUAL(sample[j], e[j]);
+    }
+
+    // the first 2^m samples have exactly one coordinate in each interval of length 2^-m, in every dimension
+    const unsigned int dim = ob::SobolSequence::maxDimensions();
+    const unsigned int count = 1024;
+    ob::SobolSequence ss(dim);
+    std::vector<double> values(count * dim);
+    ss.sampleBatch(values.data(), count);
+    for (unsigned int j = 0; j < dim; ++j)
+    {
+        std::set<unsigned int> cells;
+        for (unsigned int i = 0; i < count; ++i)
+            cells.insert((unsigned int)(values[i * dim + j] * count));
+        BOOST_CHECK_EQUAL(cells.size(), count);
+    }
+
+    BOOST_CHECK_THROW(ob::SobolSequence(dim + 1), ompl::Exception);
+}
+
+BOOST_AUTO_TEST_CASE(Sequence_SkipAndBatch)
+{
+    // a batch matches consecutive calls to sample(), and skipping ahead lands on the same samples
+    ob::HaltonSequence halton(4), haltonSkip(4);
+    ob::HaltonSequence scrambled(4), scrambledSkip(4);
+    scrambled.scramble(1);
+    scrambledSkip.scramble(1);
+    ob::SobolSequence sobol(4), sobolSkip(4);
+    std::vector<std::pair<ob::DeterministicSequence *, ob::DeterministicSequence *>> sequences = {
+        {&halton, &haltonSkip}, {&scrambled, &scrambledSkip}, {&sobol, &sobolSkip}};
+    for (auto &seq : sequences)
+    {
+        std::vector<double> values(100 * 4);
+        seq.first->sampleBatch(values.data(), 100);
+        seq.second->skip(60);
+        for (unsigned int i = 60; i < 100; ++i)
+        {
+            std::vector<double> sample = seq.second->sample();
+            for (unsigned int j = 0; j < 4; ++j)
+            {
+                BOOST_CHECK_EQUAL(sample[j], values[i * 4 + j]);
+                BOOST_CHECK(sample[j] >= 0. && sample[j] < 1.);
+            }
+        }
+    }
+
+    // scrambling changes the samples but keeps the one-dimensional stratification of the Halton sequence
+    ob::HaltonSequence plain(2);
+    ob::HaltonSequence other(2);
+    other.scramble(7);
+    std::set<unsigned int> cells;
+    bool differs = false;
+    for (unsigned int i = 0; i < 243; ++i)
+    {
+        std::vector<double> p = plain.sample(), s = other.sample();
+        differs = differs || p[1] != s[1];
+        cells.insert((unsigned int)(s[1] * 243));
+    }
+    BOOST_CHECK(differs);
+    // 3^5 samples of the base 3 dimension fall in distinct intervals of length 3^-5, up to rounding
+    BOOST_CHECK_GE(cells.size(), 242u);
+
+    // skipping past 2^32 samples does not wrap around: the base 2 radical inverse of 2^32 is 2^-33
+    ob::HaltonSequence far(1);
+    far.skip((std::uint64_t(1) << 32) - 1);
+    BOOST_CHECK_EQUAL(far.sample()[0], std::ldexp(1.0, -33));
+}
+
+BOOST_AUTO_TEST_CASE(Sobol_SE3Sampler)
+{
+    auto space(std::make_shared<ob::SE3StateSpace>());
+    ob::RealVectorBounds bounds(3);
+    bounds.setLow(-2);
+    bounds.setHigh(3);
+    space->setBounds(bounds);
+
+    ob::SE3DeterministicStateSampler sampler(space.get(), ob::DeterministicStateSampler::SOBOL);
+    ob::SE3DeterministicStateSampler batchSampler(space.get(), ob::DeterministicStateSampler::SOBOL);
+    std::vector<ob::State *> states(50);
+    for (auto &state : states)
+        state = space->allocState();
+    batchSampler.sampleUniformBatch(states.data(), states.size());
+
+    ob::State *state = space->allocState();
+    for (auto &s : states)
+    {
+        sampler.sampleUniform(state);
+        BOOST_CHECK(space->satisfiesBounds(s));
+        BOOST_CHECK_SMALL(space->distance(state, s), 1e-12);
+    }
+    space->freeState(state);
+    for (auto &s : states)
+        space->freeState(s);
+}
@@ -37,11 +37,17 @@
 #define BOOST_TEST_MODULE "PlannerData"
 #include <boost/test/unit_test.hpp>
 #include <boost/serialization/export.hpp>
+#include <boost/filesystem.hpp>
 #include <iostream>
 #include <vector>
 
 #include "ompl/base/PlannerData.h"
 #include "ompl/base/PlannerDataStorage.h"
+#include "ompl/base/CompactPlannerData.h"
+#include "ompl/base/CompactPlannerDataStorage.h"
+#include "ompl/base/objectives/PathLengthOptimizationObjective.h"
+#include <algorithm>
+#include <sstream>
 #include "ompl/base/spaces/RealVectorStateSpace.h"
 
 using namespace ompl;
@@ -563,3 +569,265 @@ BOOST_AUTO_TEST_CASE(Serialization)
     for (auto & state : states)
         space->freeState(state);
 }
+
+BOOST_AUTO_TEST_CASE(CompactPlannerData)
+{
+    auto space(std::make_shared<base::RealVectorStateSpace>(2));
+    auto si(std::make_shared<base::SpaceInformation>(space));
+    base::PlannerData data(si);
+    std::vector<base::State*> states;
+
+    for (unsigned int i = 0; i < 200; ++i)
+    {
+        states.push_back(space->allocState());
+        states[i]->as<base::RealVectorStateSpace::StateType>()->values[0] = (double)i;
+        states[i]->as<base::RealVectorStateSpace::StateType>()->values[1] = (double)(i % 7);
+        data.addVertex(base::PlannerDataVertex(states[i], i % 5));
+    }
+    data.markStartState(states[3]);
+    data.markGoalState(states[150]);
+
+    // Undirected edges, with weights that are exact in single precision
+    ompl::RNG rng;
+    for (unsigned int i = 0; i < 1000; ++i)
+    {
+        unsigned int v2, v1 = rng.uniformInt(0, states.size()-1);
+        do v2 = rng.uniformInt(0, states.size()-1); while (v2 == v1 || data.edgeExists(v1, v2));
+        base::Cost weight(0.25 * rng.uniformInt(1, 40));
+        BOOST_CHECK( data.addEdge(v1, v2, base::PlannerDataEdge(), weight) );
+        BOOST_CHECK( data.addEdge(v2, v1, base::PlannerDataEdge(), weight) );
+    }
+
+    base::CompactPlannerData compact(si);
+    compact.fromPlannerData(data);
+    BOOST_CHECK_EQUAL( compact.numVertices(), data.numVertices() );
+    BOOST_CHECK_EQUAL( compact.numEdges(), data.numEdges() );
+    BOOST_CHECK_EQUAL( compact.numStartVertices(), 1u );
+    BOOST_CHECK_EQUAL( compact.getStartIndex(0), 3u );
+    BOOST_CHECK_EQUAL( compact.getGoalIndex(0), 150u );
+    BOOST_CHECK_EQUAL( compact.vertexIndex(states[42]), 42u );
+    BOOST_CHECK_EQUAL( compact.vertexIndex(nullptr), base::CompactPlannerData::INVALID_INDEX );
+
+    std::vector<unsigned int> edges, compactEdges;
+    for (unsigned int i = 0; i < states.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL( compact.getTag(i), data.getVertex(i).getTag() );
+        data.getEdges(i, edges);
+        compact.getEdges(i, compactEdges);
+        BOOST_CHECK( edges == compactEdges );
+        for (unsigned int j : edges)
+        {
+            base::Cost w1, w2;
+            data.getEdgeWeight(i, j, &w1);
+            BOOST_CHECK( compact.getEdgeWeight(i, j, &w2) );
+            BOOST_CHECK_EQUAL( w1.value(), w2.value() );
+        }
+    }
+
+    // Same output as the full representation, except for the order of the edges
+    std::stringstream graphml, compactGraphml;
+    data.printGraphML(graphml);
+    compact.printGraphML(compactGraphml);
+    std::vector<std::string> lines, compactLines;
+    for (std::string line; std::getline(graphml, line);)
+        lines.push_back(line.substr(0, line.find(" id=\"e")) + line.substr(std::min(line.size(), line.find(" source="))));
+    for (std::string line; std::getline(compactGraphml, line);)
+        compactLines.push_back(line.substr(0, line.find(" id=\"e")) + line.substr(std::min(line.size(), line.find(" source="))));
+    std::sort(lines.begin(), lines.end());
+    std::sort(compactLines.begin(), compactLines.end());
+    BOOST_CHECK( lines == compactLines );
+
+    // Same minimum spanning tree weight
+    base::PathLengthOptimizationObjective opt(si);
+    base::PlannerData mst(si);
+    base::CompactPlannerData compactMst(si);
+    data.extractMinimumSpanningTree(3, opt, mst);
+    compact.extractMinimumSpanningTree(3, opt, compactMst);
+    BOOST_CHECK_EQUAL( mst.numEdges(), compactMst.numEdges() );
+    double total = 0.0, compactTotal = 0.0;
+    for (unsigned int i = 0; i < states.size(); ++i)
+    {
+        base::Cost w;
+        mst.getEdges(i, edges);
+        for (unsigned int j : edges)
+            if (mst.getEdgeWeight(i, j, &w))
+                total += w.value();
+        compactMst.getEdges(i, edges);
+        for (unsigned int j : edges)
+            if (compactMst.getEdgeWeight(i, j, &w))
+                compactTotal += w.value();
+    }
+    BOOST_CHECK_EQUAL( total, compactTotal );
+
+    // Edges added after the rows were arranged keep their order
+    unsigned int v1 = 199, v2 = 198;
+    while (compact.edgeExists(0, v1))
+        --v1;
+    while (v2 >= v1 || compact.edgeExists(0, v2))
+        --v2;
+    unsigned int first = compact.getEdges(0, compactEdges);
+    BOOST_CHECK( compact.addEdge(0, v1, base::Cost(2.0)) );
+    BOOST_CHECK( compact.addEdge(0, v2, base::Cost(3.0)) );
+    BOOST_CHECK( !compact.addEdge(0, 200) );
+    BOOST_CHECK_EQUAL( compact.getEdges(0, compactEdges), first + 2 );
+    BOOST_CHECK_EQUAL( compactEdges[first], v1 );
+    BOOST_CHECK_EQUAL( compactEdges[first + 1], v2 );
+    BOOST_CHECK( compact.setEdgeWeight(0, v2, base::Cost(1.5)) );
+    base::Cost w;
+    BOOST_CHECK( compact.getEdgeWeight(0, v2, &w) );
+    BOOST_CHECK_EQUAL( w.value(), 1.5 );
+
+    compact.computeEdgeWeights();
+    BOOST_CHECK( compact.getEdgeWeight(0, v1, &w) );
+    BOOST_OMPL_EXPECT_NEAR( w.value(), si->distance(states[0], states[v1]), 1e-4 );
+
+    // A vertex that is both a start and a goal keeps both flags in the full representation
+    compact.markGoalVertex(3);
+    base::PlannerData converted(si);
+    compact.toPlannerData(converted);
+    BOOST_CHECK( converted.isStartVertex(3) );
+    BOOST_CHECK( converted.isGoalVertex(3) );
+    BOOST_CHECK( converted.isGoalVertex(150) );
+    BOOST_CHECK_EQUAL( converted.numEdges(), compact.numEdges() );
+
+    // Converting into a PlannerData that already has vertices, one of them with a state of compact, connects the
+    // edges to the vertices the states end up at
+    base::State *other = space->allocState();
+    space->copyState(other, states[1]);
+    base::PlannerData prefilled(si);
+    prefilled.addVertex(base::PlannerDataVertex(other));
+    prefilled.addVertex(base::PlannerDataVertex(states[v1]));
+    compact.toPlannerData(prefilled);
+    BOOST_CHECK_EQUAL( prefilled.numVertices(), compact.numVertices() + 1 );
+    BOOST_CHECK_EQUAL( prefilled.numEdges(), compact.numEdges() );
+    BOOST_CHECK_EQUAL( prefilled.vertexIndex(base::PlannerDataVertex(states[v1])), 1u );
+    BOOST_CHECK( prefilled.edgeExists(prefilled.vertexIndex(base::PlannerDataVertex(states[0])), 1) );
+    BOOST_CHECK( prefilled.edgeExists(prefilled.vertexIndex(base::PlannerDataVertex(states[0])),
+                                      prefilled.vertexIndex(base::PlannerDataVertex(states[v2]))) );
+    BOOST_CHECK_EQUAL( prefilled.getEdges(0, edges), 0u );
+    space->freeState(other);
+
+    // Storage in the PlannerData format
+    base::PlannerDataStorage storage;
+    std::stringstream archive;
+    storage.store(compact, archive);
+    base::CompactPlannerData loaded(si);
+    storage.load(archive, loaded);
+    BOOST_CHECK_EQUAL( loaded.numVertices(), compact.numVertices() );
+    BOOST_CHECK_EQUAL( loaded.numEdges(), compact.numEdges() );
+    BOOST_CHECK( loaded.isStartVertex(3) );
+    BOOST_CHECK( loaded.isGoalVertex(150) );
+    for (unsigned int i = 0; i < states.size(); ++i)
+    {
+        BOOST_CHECK( loaded.getState(i) != states[i] );
+        BOOST_CHECK( space->equalStates(loaded.getState(i), states[i]) );
+    }
+
+    for (auto & state : states)
+        space->freeState(state);
+}
+
+BOOST_AUTO_TEST_CASE(CompactPlannerDataStorage)
+{
+    auto space(std::make_shared<base::RealVectorStateSpace>(3));
+    auto si(std::make_shared<base::SpaceInformation>(space));
+    base::CompactPlannerData compact(si);
+    std::vector<base::State*> states;
+    ompl::RNG rng;
+
+    const auto addVertices = [&](unsigned int count)
+    {
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            states.push_back(space->allocState());
+            for (unsigned int k = 0; k < 3; ++k)
+                states.back()->as<base::RealVectorStateSpace::StateType>()->values[k] = rng.uniformReal(-1.0, 1.0);
+            compact.addVertex(states.back(), states.size() % 5);
+        }
+    };
+    const auto addEdges = [&](unsigned int count, unsigned int from)
+    {
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            unsigned int v2, v1 = rng.uniformInt(from, states.size()-1);
+            do v2 = rng.uniformInt(0, states.size()-1); while (v2 == v1 || compact.edgeExists(v1, v2));
+            base::Cost weight(0.25 * rng.uniformInt(1, 40));
+            compact.addEdge(v1, v2, weight);
+            compact.addEdge(v2, v1, weight);
+        }
+    };
+    const auto checkLoaded = [&](const base::CompactPlannerData &loaded)
+    {
+        BOOST_REQUIRE_EQUAL( loaded.numVertices(), compact.numVertices() );
+        BOOST_CHECK_EQUAL( loaded.numEdges(), compact.numEdges() );
+        BOOST_CHECK( loaded.isStartVertex(3) );
+        BOOST_CHECK( loaded.isGoalVertex(150) );
+        std::vector<unsigned int> edges;
+        for (unsigned int i = 0; i < loaded.numVertices(); ++i)
+        {
+            BOOST_CHECK( space->equalStates(loaded.getState(i), states[i]) );
+            BOOST_CHECK_EQUAL( loaded.getTag(i), compact.getTag(i) );
+            compact.getEdges(i, edges);
+            for (unsigned int j : edges)
+            {
+                base::Cost w1, w2;
+                compact.getEdgeWeight(i, j, &w1);
+                BOOST_CHECK( loaded.getEdgeWeight(i, j, &w2) );
+                BOOST_CHECK_EQUAL( w1.value(), w2.value() );
+            }
+        }
+    };
+
+    addVertices(200);
+    addEdges(1000, 0);
+    compact.markStartVertex(3);
+    compact.markGoalVertex(150);
+    const std::string filename =
+        (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()).string();
+    base::CompactPlannerDataStorage storage;
+    BOOST_CHECK( storage.store(compact, filename.c_str()) );
+
+    // Appending the vertices added since the file was written, and the edges that touch them
+    addVertices(100);
+    addEdges(500, 200);
+    BOOST_CHECK( !storage.append(compact, 200, (filename + ".missing").c_str()) );
+    BOOST_CHECK( storage.append(compact, 200, filename.c_str()) );
+    base::CompactPlannerData loaded(si);
+    BOOST_CHECK( storage.load(filename.c_str(), loaded) );
+    checkLoaded(loaded);
+
+    // An incomplete last segment is ignored
+    const auto size = boost::filesystem::file_size(filename);
+    addVertices(10);
+    addEdges(20, 300);
+    BOOST_CHECK( storage.append(compact, 300, filename.c_str()) );
+    boost::filesystem::resize_file(filename, boost::filesystem::file_size(filename) - 4);
+    std::size_t completeBytes;
+    BOOST_CHECK( storage.load(filename.c_str(), loaded, completeBytes) );
+    BOOST_CHECK_EQUAL( loaded.numVertices(), 300u );
+    BOOST_CHECK_EQUAL( completeBytes, size );
+
+    // After cutting it off, segments can be appended again
+    boost::filesystem::resize_file(filename, completeBytes);
+    BOOST_CHECK( storage.append(compact, 300, filename.c_str()) );
+    BOOST_CHECK( storage.load(filename.c_str(), loaded, completeBytes) );
+    BOOST_CHECK_EQUAL( loaded.numVertices(), 310u );
+    BOOST_CHECK_EQUAL( completeBytes, boost::filesystem::file_size(filename) );
+    boost::filesystem::resize_file(filename, size);
+
+    // Files written for another state space are rejected
+    auto other(std::make_shared<base::SpaceInformation>(std::make_shared<base::RealVectorStateSpace>(2)));
+    base::CompactPlannerData wrong(other);
+    BOOST_CHECK( !storage.load(filename.c_str(), wrong) );
+    BOOST_CHECK_EQUAL( wrong.numVertices(), 0u );
+
+    // Streams
+    std::stringstream stream;
+    BOOST_CHECK( storage.store(compact, stream) );
+    BOOST_CHECK( storage.load(stream, loaded) );
+    checkLoaded(loaded);
+
+    boost::filesystem::remove(filename);
+    for (auto & state : states)
+        space->freeState(state);
+}
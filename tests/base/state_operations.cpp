@@ -36,12 +36,17 @@
 
 #define BOOST_TEST_MODULE "State"
 #include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <mutex>
 #include <thread>
+#include <vector>
 #include <iostream>
 
 #include "ompl/base/ScopedState.h"
 #include "ompl/base/spaces/SE3StateSpace.h"
 #include "ompl/base/SpaceInformation.h"
+#include "ompl/base/goals/GoalLazySamples.h"
+#include "ompl/geometric/PathGeometric.h"
 #include "ompl/util/Time.h"
 
 using namespace ompl;
@@ -321,3 +326,158 @@ BOOST_AUTO_TEST_CASE(PartialCopy)
         BOOST_CHECK(copyStateData(q, dummy.get(), r3, state[r3].get()) == base::NO_DATA_COPIED);
     }
 }
+
+BOOST_AUTO_TEST_CASE(PathSerialization)
+{
+    auto m(std::make_shared<base::SE3StateSpace>());
+    base::RealVectorBounds b(3);
+    b.setLow(0);
+    b.setHigh(1);
+    m->setBounds(b);
+    auto si(std::make_shared<base::SpaceInformation>(m));
+    si->setup();
+
+    geometric::PathGeometric path(si);
+    base::ScopedState<> state(m);
+    for (int i = 0 ; i < 20 ; ++i)
+    {
+        state.random();
+        path.append(state.get());
+    }
+
+    std::vector<unsigned char> buffer;
+    path.serialize(buffer);
+    BOOST_CHECK_EQUAL(buffer.size(), path.getStateCount() * m->getSerializationLength());
+
+    // deserialize into a path that has to grow and one that has to shrink
+    geometric::PathGeometric smaller(si, state.get());
+    smaller.deserialize(buffer);
+    geometric::PathGeometric larger(path);
+    larger.append(path);
+    larger.deserialize(buffer);
+    BOOST_CHECK_EQUAL(smaller.getStateCount(), path.getStateCount());
+    BOOST_CHECK_EQUAL(larger.getStateCount(), path.getStateCount());
+    for (std::size_t i = 0 ; i < path.getStateCount() ; ++i)
+    {
+        BOOST_CHECK(m->equalStates(smaller.getState(i), path.getState(i)));
+        BOOST_CHECK(m->equalStates(larger.getState(i), path.getState(i)));
+    }
+
+    std::vector<double> reals, stateReals;
+    path.copyToReals(reals);
+    BOOST_CHECK_EQUAL(reals.size(), path.getStateCount() * 7);
+    m->copyToReals(stateReals, path.getState(3));
+    BOOST_CHECK(std::equal(stateReals.begin(), stateReals.end(), reals.begin() + 3 * 7));
+
+    // assignment reuses the states of the destination
+    base::State *first = smaller.getState(0);
+    smaller = geometric::PathGeometric(si, state.get());
+    BOOST_CHECK_EQUAL(smaller.getStateCount(), 1u);
+    BOOST_CHECK(smaller.getState(0) == first);
+    BOOST_CHECK(m->equalStates(smaller.getState(0), state.get()));
+}
+
+BOOST_AUTO_TEST_CASE(GoalStatesNearest)
+{
+    auto m(std::make_shared<base::SE3StateSpace>());
+    base::RealVectorBounds b(3);
+    b.setLow(0);
+    b.setHigh(1);
+    m->setBounds(b);
+    auto si(std::make_shared<base::SpaceInformation>(m));
+    si->setup();
+
+    base::GoalStates goal(si);
+    base::ScopedState<> query(m);
+    query.random();
+    BOOST_CHECK_EQUAL(goal.distanceGoal(query.get()), std::numeric_limits<double>::infinity());
+
+    std::vector<base::ScopedState<>> states(1000, base::ScopedState<>(m));
+    for (auto &state : states)
+    {
+        state.random();
+        goal.addState(state);
+    }
+    for (int i = 0 ; i < 100 ; ++i)
+    {
+        query.random();
+        double dist = std::numeric_limits<double>::infinity();
+        for (const auto &state : states)
+            dist = std::min(dist, si->distance(query.get(), state.get()));
+        BOOST_CHECK_EQUAL(goal.distanceGoal(query.get()), dist);
+    }
+    BOOST_CHECK_EQUAL(goal.distanceGoal(states[500].get()), 0.0);
+    goal.clear();
+    BOOST_CHECK(!goal.hasStates());
+    BOOST_CHECK_EQUAL(goal.distanceGoal(states[500].get()), std::numeric_limits<double>::infinity());
+
+    // states closer than the minimum distance to a previous one are not added
+    base::GoalLazySamples lazy(si, [](const base::GoalLazySamples *, base::State *) { return false; }, false);
+    for (const auto &state : states)
+        BOOST_CHECK(lazy.addStateIfDifferent(state.get(), 1e-3));
+    for (const auto &state : states)
+        BOOST_CHECK(!lazy.addStateIfDifferent(state.get(), 1e-3));
+    BOOST_CHECK_EQUAL(lazy.getStateCount(), states.size());
+    BOOST_CHECK_EQUAL(lazy.distanceGoal(states[10].get()), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(GoalLazySamplesThreads)
+{
+    auto m(std::make_shared<base::SE3StateSpace>());
+    base::RealVectorBounds b(3);
+    b.setLow(0);
+    b.setHigh(1);
+    m->setBounds(b);
+    auto si(std::make_shared<base::SpaceInformation>(m));
+    si->setup();
+
+    // the threads sample among a few distinct states, so most samples are duplicates
+    std::vector<base::ScopedState<>> states(20, base::ScopedState<>(m));
+    for (auto &state : states)
+        state.random();
+    std::atomic<unsigned int> calls(0);
+    base::GoalLazySamples goal(si, [&](const base::GoalLazySamples *, base::State *st)
+        {
+            unsigned int i = calls++;
+            if (i >= 2000)
+                return false;
+            m->copyState(st, states[i % states.size()].get());
+            return true;
+        }, false);
+
+    std::atomic<unsigned int> callbacks(0);
+    std::atomic<bool> inCallback(false);
+    std::atomic<bool> overlapped(false);
+    std::mutex seenLock;
+    std::vector<const base::State *> seen;
+    goal.setNewStateCallback([&](const base::State *st)
+        {
+            if (inCallback.exchange(true))
+                overlapped = true;
+            ++callbacks;
+            {
+                std::lock_guard<std::mutex> slock(seenLock);
+                seen.push_back(st);
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            inCallback = false;
+        });
+
+    goal.setThreadCount(4);
+    BOOST_CHECK_EQUAL(goal.getThreadCount(), 4u);
+    goal.startSampling();
+    while (goal.isSampling())
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    goal.stopSampling();
+
+    BOOST_CHECK_EQUAL(goal.samplingAttemptsCount(), 2000u);
+    BOOST_CHECK_EQUAL(goal.getStateCount(), states.size());
+    BOOST_CHECK_EQUAL(callbacks, states.size());
+    BOOST_CHECK(!overlapped);
+    // the callback sees the states in the order they were added
+    BOOST_REQUIRE_EQUAL(seen.size(), goal.getStateCount());
+    for (std::size_t i = 0; i < seen.size(); ++i)
+        BOOST_CHECK(seen[i] == goal.getState(i));
+    for (const auto &state : states)
+        BOOST_CHECK_EQUAL(goal.distanceGoal(state.get()), 0.0);
+}
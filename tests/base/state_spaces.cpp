@@ -54,8 +54,13 @@
 #include "ompl/base/spaces/TorusStateSpace.h"
 #include "ompl/base/spaces/SphereStateSpace.h"
 #include "ompl/base/spaces/MobiusStateSpace.h"
+#include "ompl/base/ProblemDefinition.h"
+#include "ompl/base/goals/GoalStates.h"
+#include "ompl/base/objectives/PathLengthOptimizationObjective.h"
+#include "ompl/base/samplers/informed/PathLengthDirectInfSampler.h"
 
 #include <boost/math/constants/constants.hpp>
+#include <boost/filesystem.hpp>
 
 #include "StateSpaceTest.h"
 
@@ -97,6 +102,99 @@ BOOST_AUTO_TEST_CASE(ReedsShepp_Simple)
     d->sanityChecks();
 }
 
+template <typename SpaceType>
+void testBatchDistance(const std::shared_ptr<SpaceType> &d)
+{
+    base::RealVectorBounds bounds2(2);
+    bounds2.setLow(-3);
+    bounds2.setHigh(3);
+    d->setBounds(bounds2);
+    d->setup();
+
+    base::StateSamplerPtr sampler = d->allocStateSampler();
+    base::State *from = d->allocState();
+    std::vector<const base::State *> states;
+    for (unsigned int i = 0; i < 100; ++i)
+    {
+        base::State *s = d->allocState();
+        sampler->sampleUniform(s);
+        states.push_back(s);
+    }
+    sampler->sampleUniform(from);
+
+    std::vector<double> distances;
+    d->batchDistance(from, states, distances);
+    BOOST_CHECK_EQUAL(distances.size(), states.size());
+    for (std::size_t i = 0; i < states.size(); ++i)
+    {
+        const double dist = d->distance(from, states[i]);
+        BOOST_OMPL_EXPECT_NEAR(distances[i], dist, 1e-9);
+        BOOST_CHECK(d->distanceLowerBound(from, states[i]) <= dist + 1e-9);
+    }
+
+    // States beyond the bound are either computed exactly or pruned
+    d->batchDistance(from, states, distances, 2.);
+    for (std::size_t i = 0; i < states.size(); ++i)
+    {
+        const double dist = d->distance(from, states[i]);
+        if (dist <= 2.)
+            BOOST_OMPL_EXPECT_NEAR(distances[i], dist, 1e-9);
+        else
+            BOOST_CHECK(distances[i] > 2.);
+    }
+
+    for (auto s : states)
+        d->freeState(const_cast<base::State *>(s));
+    d->freeState(from);
+}
+
+BOOST_AUTO_TEST_CASE(Dubins_BatchDistance)
+{
+    testBatchDistance(std::make_shared<base::DubinsStateSpace>());
+    testBatchDistance(std::make_shared<base::DubinsStateSpace>(1., true));
+}
+
+BOOST_AUTO_TEST_CASE(ReedsShepp_BatchDistance)
+{
+    testBatchDistance(std::make_shared<base::ReedsSheppStateSpace>());
+}
+
+BOOST_AUTO_TEST_CASE(ReedsShepp_DistanceTable)
+{
+    auto d(std::make_shared<base::ReedsSheppStateSpace>());
+
+    // Keep relative poses mostly within the table
+    base::RealVectorBounds bounds2(2);
+    bounds2.setLow(-1.4);
+    bounds2.setHigh(1.4);
+    d->setBounds(bounds2);
+    d->setup();
+
+    const boost::filesystem::path table =
+        boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("ompl_rs_%%%%%%%%.table");
+    BOOST_REQUIRE(base::ReedsSheppStateSpace::generateDistanceTable(table.string(), 4., 40, 36));
+    BOOST_REQUIRE(d->loadDistanceTable(table.string()));
+    BOOST_CHECK(d->hasDistanceTable());
+    BOOST_CHECK(!d->isMetricSpace());
+
+    base::ScopedState<base::ReedsSheppStateSpace> s1(d), s2(d);
+    for (unsigned int i = 0; i < 1000; ++i)
+    {
+        s1.random();
+        s2.random();
+        const double approx = d->distance(s1.get(), s2.get());
+        const double exact = d->reedsShepp(s1.get(), s2.get()).length();
+        // the default tolerance of loadDistanceTable()
+        BOOST_CHECK_SMALL(approx - exact, 0.01);
+    }
+
+    d->clearDistanceTable();
+    BOOST_CHECK(!d->hasDistanceTable());
+    BOOST_CHECK(d->isMetricSpace());
+    BOOST_CHECK(!d->loadDistanceTable((table.parent_path() / "does_not_exist.table").string()));
+    boost::filesystem::remove(table);
+}
+
 BOOST_AUTO_TEST_CASE(Discrete_Simple)
 {
     auto d(std::make_shared<base::DiscreteStateSpace>(0, 2));
@@ -198,6 +296,128 @@ BOOST_AUTO_TEST_CASE(SO2_Sampler)
     }
 }
 
+BOOST_AUTO_TEST_CASE(Sampler_Batch)
+{
+    auto se3(std::make_shared<base::SE3StateSpace>());
+    base::RealVectorBounds bounds(3);
+    bounds.setLow(-1);
+    bounds.setHigh(2);
+    se3->setBounds(bounds);
+    auto space = se3 + std::make_shared<base::SO2StateSpace>();
+    space->setup();
+
+    // The compound sampler hands the components of the batch to the RealVector, SO(3) and SO(2) samplers
+    base::StateSamplerPtr sampler = space->allocStateSampler();
+    BOOST_CHECK(sampler->getBatchSampling());
+    std::vector<base::State *> states(101);
+    for (auto &state : states)
+        state = space->allocState();
+    sampler->sampleUniformBatch(states.data(), states.size());
+    double meanX = 0.0;
+    for (auto &state : states)
+    {
+        BOOST_CHECK(space->satisfiesBounds(state));
+        const auto *pose = state->as<base::CompoundState>()->as<base::SE3StateSpace::StateType>(0);
+        const auto &q = pose->rotation();
+        BOOST_OMPL_EXPECT_NEAR(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w, 1.0, 1e-9);
+        meanX += pose->getX() / states.size();
+    }
+    BOOST_OMPL_EXPECT_NEAR(meanX, 0.5, 0.5);
+
+    // Only valid states are returned by the valid state sampler, and they are stored first
+    base::SpaceInformation si(space);
+    si.setStateValidityChecker([](const base::State *state)
+                               {
+                                   return state->as<base::CompoundState>()
+                                              ->as<base::SE3StateSpace::StateType>(0)
+                                              ->getX() > 0.5;
+                               });
+    si.setup();
+    base::ValidStateSamplerPtr validSampler = si.allocValidStateSampler();
+    std::size_t found = validSampler->sampleBatch(states.data(), states.size());
+    BOOST_CHECK_EQUAL(found, states.size());
+    for (std::size_t i = 0; i < found; ++i)
+        BOOST_CHECK(si.isValid(states[i]));
+
+    // A derived sampler that overrides sampleUniform() is used for batches too
+    class FixedSampler : public base::CompoundStateSampler
+    {
+    public:
+        FixedSampler(const base::StateSpace *space) : base::CompoundStateSampler(space)
+        {
+        }
+
+        void sampleUniform(base::State *state) override
+        {
+            base::CompoundStateSampler::sampleUniform(state);
+            state->as<base::CompoundState>()->as<base::SE3StateSpace::StateType>(0)->setX(0.25);
+        }
+    };
+    FixedSampler fixed(space.get());
+    BOOST_CHECK(!fixed.getBatchSampling());
+    fixed.addSampler(se3->allocStateSampler(), 1.0);
+    fixed.addSampler(space->as<base::CompoundStateSpace>()->getSubspace(1)->allocStateSampler(), 1.0);
+    fixed.sampleUniformBatch(states.data(), states.size());
+    for (auto &state : states)
+        BOOST_CHECK_EQUAL(state->as<base::CompoundState>()->as<base::SE3StateSpace::StateType>(0)->getX(), 0.25);
+
+    for (auto &state : states)
+        space->freeState(state);
+}
+
+BOOST_AUTO_TEST_CASE(InformedSampler_Batch)
+{
+    auto space(std::make_shared<base::RealVectorStateSpace>(2));
+    space->setBounds(0.0, 10.0);
+    auto si(std::make_shared<base::SpaceInformation>(space));
+    si->setup();
+
+    // Two starts and one goal give two PHSs, which are small enough to be sampled directly
+    auto pdef(std::make_shared<base::ProblemDefinition>(si));
+    base::ScopedState<base::RealVectorStateSpace> start1(space), start2(space), goalState(space);
+    start1[0] = 1.0;
+    start1[1] = 1.0;
+    start2[0] = 1.0;
+    start2[1] = 9.0;
+    goalState[0] = 9.0;
+    goalState[1] = 5.0;
+    pdef->addStartState(start1);
+    pdef->addStartState(start2);
+    auto goal(std::make_shared<base::GoalStates>(si));
+    goal->addState(goalState);
+    pdef->setGoal(goal);
+    pdef->setOptimizationObjective(std::make_shared<base::PathLengthOptimizationObjective>(si));
+
+    base::PathLengthDirectInfSampler sampler(pdef, 100u);
+    const base::Cost maxCost(9.5);
+    std::vector<base::State *> states(200);
+    for (auto &state : states)
+        state = space->allocState();
+    unsigned int found = sampler.sampleUniformBatch(states, states.size(), maxCost);
+    BOOST_CHECK_GT(found, states.size() / 2);
+
+    // Every sample is in the informed set, and both PHSs show up in each quarter of the batch
+    std::vector<unsigned int> inFirst(4, 0u), inSecond(4, 0u);
+    for (unsigned int i = 0; i < found; ++i)
+    {
+        BOOST_CHECK(space->satisfiesBounds(states[i]));
+        BOOST_CHECK_LE(sampler.heuristicSolnCost(states[i]).value(), maxCost.value() + 1e-9);
+        double toGoal = space->distance(states[i], goalState.get());
+        if (space->distance(start1.get(), states[i]) + toGoal <= maxCost.value() + 1e-9)
+            ++inFirst[4 * i / found];
+        if (space->distance(start2.get(), states[i]) + toGoal <= maxCost.value() + 1e-9)
+            ++inSecond[4 * i / found];
+    }
+    for (unsigned int q = 0; q < 4; ++q)
+    {
+        BOOST_CHECK_GT(inFirst[q], 0u);
+        BOOST_CHECK_GT(inSecond[q], 0u);
+    }
+
+    for (auto &state : states)
+        space->freeState(state);
+}
+
 BOOST_AUTO_TEST_CASE(SO3_Simple)
 {
     auto m(std::make_shared<base::SO3StateSpace>());
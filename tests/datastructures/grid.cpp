@@ -40,6 +40,9 @@
 #include "ompl/datastructures/Grid.h"
 #include "ompl/datastructures/GridN.h"
 
+#include <map>
+#include <random>
+
 using namespace ompl;
 
 BOOST_AUTO_TEST_CASE(Grid_Simple)
@@ -197,3 +200,66 @@ BOOST_AUTO_TEST_CASE(GridN_Simple)
     BOOST_CHECK_EQUAL((unsigned int)2, g.components().size());
     BOOST_CHECK_EQUAL(g.components()[0].size() + g.components()[1].size(), g.size());
 }
+
+BOOST_AUTO_TEST_CASE(Grid_ManyCells)
+{
+    // Compare the grid against an ordered map of coordinates while adding and removing many cells
+    const unsigned int dim = 3;
+    Grid<int> g(dim);
+    std::map<std::vector<int>, Grid<int>::Cell *> reference;
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int> component(-6, 6);
+    Grid<int>::Coord coord(dim);
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        std::vector<int> c(dim);
+        for (unsigned int j = 0; j < dim; ++j)
+            coord[j] = c[j] = component(rng);
+        Grid<int>::Cell *cell = g.getCell(coord);
+        auto it = reference.find(c);
+        BOOST_REQUIRE_EQUAL(cell, it == reference.end() ? nullptr : it->second);
+        if (cell == nullptr)
+        {
+            cell = g.createCell(coord);
+            cell->data = i;
+            g.add(cell);
+            reference[c] = cell;
+        }
+        else if (i % 3 == 0)
+        {
+            g.remove(cell);
+            g.destroyCell(cell);
+            reference.erase(it);
+        }
+    }
+    BOOST_CHECK_EQUAL(g.size(), reference.size());
+
+    unsigned int count = 0;
+    for (const auto &it : g)
+    {
+        ++count;
+        BOOST_CHECK(*it.first == it.second->coord);
+    }
+    BOOST_CHECK_EQUAL(count, reference.size());
+
+    for (const auto &r : reference)
+    {
+        Grid<int>::CellArray nbh;
+        g.neighbors(r.second, nbh);
+        unsigned int expected = 0;
+        for (unsigned int j = 0; j < dim; ++j)
+            for (int delta : {-1, 1})
+            {
+                std::vector<int> c = r.first;
+                c[j] += delta;
+                auto it = reference.find(c);
+                if (it != reference.end())
+                {
+                    ++expected;
+                    BOOST_CHECK(std::find(nbh.begin(), nbh.end(), it->second) != nbh.end());
+                }
+            }
+        BOOST_CHECK_EQUAL(nbh.size(), expected);
+    }
+}
@@ -37,6 +37,8 @@
 #define BOOST_TEST_MODULE "Heap"
 #include <boost/test/unit_test.hpp>
 #include "ompl/datastructures/BinaryHeap.h"
+#include "ompl/datastructures/RadixHeap.h"
+#include <algorithm>
 
 using namespace ompl;
 
@@ -86,3 +88,80 @@ BOOST_AUTO_TEST_CASE(Simple)
     h.insert(-1);
     BOOST_CHECK(h.top()->data == -1);
 }
+
+BOOST_AUTO_TEST_CASE(FourAry)
+{
+    BinaryHeap<int, std::less<int>, 4> h;
+    std::vector<BinaryHeap<int, std::less<int>, 4>::Element *> elements;
+    for (int i = 0; i < 100; ++i)
+        elements.push_back(h.insert((i * 37) % 101));
+    BOOST_CHECK_EQUAL(h.size(), 100u);
+    BOOST_CHECK_EQUAL(h.top()->data, 0);
+
+    elements[50]->data = -7;
+    h.update(elements[50]);
+    BOOST_CHECK_EQUAL(h.top()->data, -7);
+    h.remove(elements[50]);
+    BOOST_CHECK_EQUAL(h.top()->data, 0);
+
+    int previous = h.top()->data;
+    while (!h.empty())
+    {
+        BOOST_CHECK(previous <= h.top()->data);
+        previous = h.top()->data;
+        h.pop();
+    }
+
+    std::vector<int> s = {4, -1, 8, 3, 3, 0, 12};
+    h.sort(s);
+    BOOST_CHECK(std::is_sorted(s.begin(), s.end()));
+}
+
+namespace
+{
+    struct KeyOfPair
+    {
+        double operator()(const std::pair<double, int> &p) const
+        {
+            return p.first;
+        }
+    };
+}
+
+BOOST_AUTO_TEST_CASE(Radix)
+{
+    using Heap = RadixHeap<std::pair<double, int>, KeyOfPair>;
+    Heap h;
+    BOOST_CHECK(h.empty());
+    BOOST_CHECK(h.top() == nullptr);
+
+    h.insert(std::make_pair(4.5, 0));
+    Heap::Element *e1 = h.insert(std::make_pair(7.25, 1));
+    Heap::Element *e2 = h.insert(std::make_pair(1.0, 2));
+    h.insert(std::make_pair(1000.0, 3));
+    BOOST_CHECK_EQUAL(h.size(), 4u);
+    BOOST_CHECK_EQUAL(h.top()->data.second, 2);
+
+    e1->data.first = 0.5;
+    h.update(e1);
+    BOOST_CHECK_EQUAL(h.top()->data.second, 1);
+    h.remove(e2);
+    BOOST_CHECK_EQUAL(h.size(), 3u);
+
+    // Keys popped from a monotone heap never decrease, and later insertions
+    // may use any key at least as large as the last one popped
+    std::vector<int> order;
+    double last = 0.0;
+    while (!h.empty())
+    {
+        Heap::Element *top = h.top();
+        BOOST_CHECK(top->data.first >= last);
+        last = top->data.first;
+        order.push_back(top->data.second);
+        h.pop();
+        if (order.size() == 1)
+            h.insert(std::make_pair(last + 2.0, 4));
+    }
+    BOOST_CHECK((order == std::vector<int>{1, 4, 0, 3}));
+    BOOST_CHECK(h.top() == nullptr);
+}
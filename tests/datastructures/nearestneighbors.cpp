@@ -44,6 +44,7 @@
 #include "ompl/datastructures/NearestNeighborsSqrtApprox.h"
 #include "ompl/datastructures/NearestNeighborsGNAT.h"
 #include "ompl/datastructures/NearestNeighborsGNATNoThreadSafety.h"
+#include "ompl/datastructures/NearestNeighborsGraph.h"
 #if OMPL_HAVE_FLANN
 #include "ompl/datastructures/NearestNeighborsFLANN.h"
 #endif
@@ -316,3 +317,49 @@ NN_TEST_CASES(GNATNoThreadSafetys, false)
 NN_TEST_CASES(FLANNLinear, false)
 NN_TEST_CASES(FLANNHierarchicalClustering, true)
 #endif
+
+BOOST_AUTO_TEST_CASE(NeighborsGraph)
+{
+    base::SE3StateSpace &space = nnConfig.space1;
+    base::StateSamplerPtr sampler(space.allocStateSampler());
+    std::vector<base::State*> states(n), nghbr;
+    NearestNeighborsGNAT<base::State*> proximity;
+    proximity.setDistanceFunction([&space](const base::State *a, const base::State *b)
+        {
+            return space.distance(a, b);
+        });
+    for (auto &state : states)
+    {
+        state = space.allocState();
+        sampler->sampleUniform(state);
+    }
+    proximity.add(states);
+
+    // the rows computed by several threads match the serial queries, without the query point
+    NearestNeighborsGraph<base::State*> graph;
+    for (unsigned int threads : {1u, 4u})
+    {
+        graph.build(proximity, states, k + 1, 0., threads);
+        BOOST_REQUIRE_EQUAL(graph.size(), states.size());
+        for (std::size_t i = 0; i < states.size(); ++i)
+        {
+            proximity.nearestK(states[i], k + 1, nghbr);
+            nghbr.erase(std::remove(nghbr.begin(), nghbr.end(), states[i]), nghbr.end());
+            NearestNeighborsGraph<base::State*>::Row row = graph.row(i);
+            BOOST_REQUIRE_EQUAL(row.size(), nghbr.size());
+            BOOST_CHECK(std::equal(row.begin(), row.end(), nghbr.begin()));
+        }
+
+        graph.build(proximity, states, 0, .5, threads);
+        for (std::size_t i = 0; i < states.size(); ++i)
+        {
+            NearestNeighborsGraph<base::State*>::Row row = graph.row(i);
+            BOOST_CHECK(std::find(row.begin(), row.end(), states[i]) == row.end());
+            for (auto s : row)
+                BOOST_CHECK_LE(space.distance(states[i], s), .5);
+        }
+    }
+
+    for (auto &state : states)
+        space.freeState(state);
+}
@@ -40,6 +40,7 @@
 #include "ompl/util/RandomNumbers.h"
 
 #include <cmath>
+#include <set>
 #include <vector>
 
 // define a convenience macro
@@ -131,6 +132,57 @@ BOOST_AUTO_TEST_CASE(Simple)
     p.clear();
 }
 
+BOOST_AUTO_TEST_CASE(BatchUpdateAndCopy)
+{
+    using Element = ompl::PDF<int>::Element;
+    ompl::PDF<int> p;
+    std::vector<Element *> elems;
+    for (int i = 0; i < 13; ++i)
+        elems.push_back(p.add(i, 1.0));
+
+    // give all the weight to the elements 3 and 11, in equal parts
+    std::vector<double> weights(elems.size(), 0.0);
+    weights[3] = weights[11] = 2.0;
+    p.update(elems, weights);
+    BOOST_CHECK_EQUAL(3, p.sample(0.25));
+    BOOST_CHECK_EQUAL(11, p.sample(0.75));
+    BOOST_CHECK_EQUAL(0.0, p.getWeight(elems[12]));
+
+    // a copy keeps the data and weights but has its own elements
+    ompl::PDF<int> q(p);
+    BOOST_CHECK_EQUAL(13u, q.size());
+    p.remove(elems[3]);
+    BOOST_CHECK_EQUAL(11, p.sample(0.25));
+    BOOST_CHECK_EQUAL(3, q.sample(0.25));
+    BOOST_CHECK_EQUAL(11, q.sample(0.75));
+}
+
+BOOST_AUTO_TEST_CASE(SampleAfterRemove)
+{
+    using Element = ompl::PDF<int>::Element;
+    // weights that are not exactly representable leave rounding residue in the sums if they are not recomputed
+    for (int trial = 0; trial < 50; ++trial)
+    {
+        ompl::PDF<int> p;
+        std::vector<Element *> elems;
+        for (int i = 0; i < 30; ++i)
+            elems.push_back(p.add(i, 0.1 * ((i * 7 + trial) % 11) + 0.3));
+        std::set<int> remaining;
+        for (int i = 0; i < 30; ++i)
+            remaining.insert(i);
+        for (int i = 0; i < 23; ++i)
+        {
+            const int victim = (i * 13 + trial) % 30;
+            if (remaining.erase(victim) == 0u)
+                continue;
+            p.remove(elems[victim]);
+        }
+        BOOST_REQUIRE_EQUAL(remaining.size(), p.size());
+        for (double r : {1.0, std::nextafter(1.0, 0.0), 1.0 - 1e-12, 0.999999, 0.0})
+            BOOST_CHECK(remaining.count(p.sample(r)) == 1u);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(Statistical)
 {
     const std::size_t NUM_SAMPLES = 5000000;
@@ -43,6 +43,7 @@ OMPL_PUSH_DISABLE_CLANG_WARNING(-Wunused-function)
 OMPL_PUSH_DISABLE_GCC_WARNING(-Wunused-function)
 #include "2DcirclesSetup.h"
 OMPL_POP_CLANG
+#include <fstream>
 #include <iostream>
 
 #include "ompl/base/spaces/RealVectorStateProjections.h"
@@ -69,6 +70,7 @@ OMPL_POP_CLANG
 #include "ompl/geometric/planners/prm/SPARS.h"
 #include "ompl/geometric/planners/prm/SPARStwo.h"
 #include "ompl/base/objectives/PathLengthOptimizationObjective.h"
+#include "ompl/base/CompactPlannerDataStorage.h"
 
 #include "../../base/PlannerTest.h"
 
@@ -538,6 +540,20 @@ protected:
 
 };
 
+class LazyPRMstarIncrementalTest : public TestPlanner
+{
+protected:
+
+    base::PlannerPtr newPlanner(const base::SpaceInformationPtr &si) override
+    {
+        auto prm(std::make_shared<geometric::LazyPRMstar>(si));
+        prm->setIncrementalSearch(true);
+        prm->setCheckCostliestEdgesFirst(true);
+        return prm;
+    }
+
+};
+
 class SPARSTest : public TestPlanner
 {
 protected:
@@ -549,6 +565,18 @@ protected:
     }
 };
 
+class SPARSParallelTest : public TestPlanner
+{
+protected:
+
+    base::PlannerPtr newPlanner(const base::SpaceInformationPtr &si) override
+    {
+        auto spars(std::make_shared<geometric::SPARS>(si));
+        spars->setNumThreads(4);
+        return spars;
+    }
+};
+
 class SPARStwoTest : public TestPlanner
 {
 protected:
@@ -560,6 +588,18 @@ protected:
     }
 };
 
+class SPARStwoParallelTest : public TestPlanner
+{
+protected:
+
+    base::PlannerPtr newPlanner(const base::SpaceInformationPtr &si) override
+    {
+        auto sparstwo(std::make_shared<geometric::SPARStwo>(si));
+        sparstwo->setNumThreads(4);
+        return sparstwo;
+    }
+};
+
 class PlanTest
 {
 public:
@@ -761,7 +801,140 @@ OMPL_PLANNER_TEST(PRM, 95.0, 0.04)
 OMPL_PLANNER_TEST(PRMstar, 95.0, 0.04)
 //OMPL_PLANNER_TEST(LazyPRM, 98.0, 0.04)
 OMPL_PLANNER_TEST(LazyPRMstar, 95.0, 0.04)
+OMPL_PLANNER_TEST(LazyPRMstarIncremental, 95.0, 0.04)
 OMPL_PLANNER_TEST(SPARS, 95.0, 0.04)
+OMPL_PLANNER_TEST(SPARSParallel, 95.0, 0.04)
 OMPL_PLANNER_TEST(SPARStwo, 95.0, 0.04)
+OMPL_PLANNER_TEST(SPARStwoParallel, 95.0, 0.04)
+
+BOOST_AUTO_TEST_CASE(geometric_PRMBatch)
+{
+    base::SpaceInformationPtr si = geometric::spaceInformation2DCircles(circles_);
+    auto prm(std::make_shared<geometric::PRMstar>(si));
+    prm->setProblemDefinition(std::make_shared<base::ProblemDefinition>(si));
+    prm->setup();
+    prm->growRoadmap(base::PlannerTerminationCondition([&prm] { return prm->milestoneCount() >= 2000; }));
+    const unsigned long int milestones = prm->milestoneCount();
+
+    std::vector<base::ScopedState<>> states;
+    states.reserve(2 * circles_.getQueryCount());
+    std::vector<std::pair<const base::State *, const base::State *>> queries;
+    for (std::size_t i = 0 ; i < circles_.getQueryCount() ; ++i)
+    {
+        const Circles2D::Query &q = circles_.getQuery(i);
+        states.emplace_back(si);
+        states.back()[0] = q.startX_;
+        states.back()[1] = q.startY_;
+        states.emplace_back(si);
+        states.back()[0] = q.goalX_;
+        states.back()[1] = q.goalY_;
+        queries.emplace_back(states[2 * i].get(), states[2 * i + 1].get());
+    }
+
+    // answering the queries concurrently gives the same paths as answering them one after the other
+    std::vector<base::PathPtr> batch, serial;
+    unsigned int solved = prm->solveBatch(queries, batch, 4);
+    BOOST_CHECK(solved >= 0.95 * queries.size());
+    BOOST_CHECK_EQUAL(prm->solveBatch(queries, serial, 1), solved);
+    BOOST_CHECK_EQUAL(prm->milestoneCount(), milestones);
+
+    for (std::size_t i = 0 ; i < queries.size() ; ++i)
+    {
+        BOOST_REQUIRE_EQUAL(batch[i] == nullptr, serial[i] == nullptr);
+        if (!batch[i])
+            continue;
+        auto &path = static_cast<geometric::PathGeometric &>(*batch[i]);
+        BOOST_CHECK(path.check());
+        BOOST_CHECK(si->equalStates(path.getState(0), queries[i].first));
+        BOOST_CHECK(si->equalStates(path.getState(path.getStateCount() - 1), queries[i].second));
+        BOOST_CHECK_CLOSE(path.length(), serial[i]->length(), 1e-6);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(geometric_PRMRoadmapCache)
+{
+    base::SpaceInformationPtr si = geometric::spaceInformation2DCircles(circles_);
+    const std::string filename =
+        (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()).string();
+    base::ScopedState<> start(si), goal(si);
+    unsigned long int milestones, edges;
+
+    {
+        geometric::SimpleSetup ss(si);
+        auto prm(std::make_shared<geometric::PRM>(si));
+        ss.setPlanner(prm);
+        ss.setRoadmapCache(filename);
+        for (std::size_t i = 0 ; i < 2 ; ++i)
+        {
+            const Circles2D::Query &q = circles_.getQuery(i);
+            start[0] = q.startX_;
+            start[1] = q.startY_;
+            goal[0] = q.goalX_;
+            goal[1] = q.goalY_;
+            ss.setStartAndGoalStates(start, goal);
+            BOOST_CHECK(ss.solve(SOLUTION_TIME) == base::PlannerStatus::EXACT_SOLUTION);
+        }
+        ss.waitForRoadmapCache();
+        milestones = prm->milestoneCount();
+        edges = prm->edgeCount();
+    }
+
+    // a new setup continues from the stored roadmap, and only appends to it
+    geometric::SimpleSetup ss(si);
+    auto prm(std::make_shared<geometric::PRM>(si));
+    ss.setPlanner(prm);
+    ss.setRoadmapCache(filename);
+    ss.setStartAndGoalStates(start, goal);
+    ss.setup();
+    BOOST_CHECK_EQUAL(prm->milestoneCount(), milestones);
+    BOOST_CHECK_EQUAL(prm->edgeCount(), edges);
+    const auto size = boost::filesystem::file_size(filename);
+    BOOST_CHECK(ss.solve(SOLUTION_TIME) == base::PlannerStatus::EXACT_SOLUTION);
+    ss.waitForRoadmapCache();
+    BOOST_CHECK(boost::filesystem::file_size(filename) >= size);
+
+    base::CompactPlannerData data(si);
+    BOOST_CHECK(base::CompactPlannerDataStorage().load(filename.c_str(), data));
+    BOOST_CHECK_EQUAL(data.numVertices(), prm->milestoneCount());
+    BOOST_CHECK_EQUAL(data.numEdges(), 2 * prm->edgeCount());
+
+    // clearing the planner directly does not disturb the writer
+    BOOST_CHECK(ss.solve(SOLUTION_TIME) == base::PlannerStatus::EXACT_SOLUTION);
+    milestones = prm->milestoneCount();
+    prm->clear();
+    ss.waitForRoadmapCache();
+    BOOST_CHECK(base::CompactPlannerDataStorage().load(filename.c_str(), data));
+    BOOST_CHECK_EQUAL(data.numVertices(), milestones);
+
+    // an incomplete segment left by an interrupted write is cut off before appending
+    {
+        std::ofstream torn(filename.c_str(), std::ios::binary | std::ios::app);
+        torn << "torn";
+    }
+    {
+        geometric::SimpleSetup repaired(si);
+        auto repairedPrm(std::make_shared<geometric::PRM>(si));
+        repaired.setPlanner(repairedPrm);
+        repaired.setRoadmapCache(filename);
+        repaired.setStartAndGoalStates(start, goal);
+        repaired.setup();
+        BOOST_CHECK_EQUAL(repairedPrm->milestoneCount(), milestones);
+        BOOST_CHECK(repaired.solve(SOLUTION_TIME) == base::PlannerStatus::EXACT_SOLUTION);
+        repaired.waitForRoadmapCache();
+        BOOST_CHECK(base::CompactPlannerDataStorage().load(filename.c_str(), data));
+        BOOST_CHECK_EQUAL(data.numVertices(), repairedPrm->milestoneCount());
+        BOOST_CHECK_EQUAL(data.numEdges(), 2 * repairedPrm->edgeCount());
+    }
+    boost::filesystem::remove(filename);
+
+    // planners that cannot load a roadmap do not write one
+    geometric::SimpleSetup rrtSetup(si);
+    rrtSetup.setPlanner(std::make_shared<geometric::RRT>(si));
+    rrtSetup.setRoadmapCache(filename);
+    rrtSetup.setStartAndGoalStates(start, goal);
+    BOOST_CHECK(rrtSetup.solve(SOLUTION_TIME) == base::PlannerStatus::EXACT_SOLUTION);
+    rrtSetup.waitForRoadmapCache();
+    BOOST_CHECK(!boost::filesystem::exists(filename));
+}
 
 BOOST_AUTO_TEST_SUITE_END()
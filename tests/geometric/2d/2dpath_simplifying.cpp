@@ -137,6 +137,28 @@ public:
         }
     }
 
+    void run_parallel_simplifier()
+    {
+        base::OptimizationObjectivePtr obj(new base::PathLengthOptimizationObjective(si_));
+        geometric::PathSimplifier simplifier(si_, ompl::base::GoalPtr(), obj);
+        simplifier.setNumThreads(4);
+        for (int path_idx = 0; path_idx < 2; path_idx++)
+        {
+            base::Cost original_cost = paths_[path_idx]->cost(obj);
+
+            geometric::PathGeometric path(*paths_[path_idx]);
+            simplifier.reduceVerticesParallel(path, 100, 100);
+            BOOST_CHECK(path.check());
+            BOOST_CHECK(!obj->isCostBetterThan(original_cost, path.cost(obj)));
+
+            geometric::PathGeometric multiStartPath(*paths_[path_idx]);
+            BOOST_CHECK(simplifier.simplifyMultiStart(multiStartPath, 4, base::timedPlannerTerminationCondition(0.5)));
+            BOOST_CHECK(multiStartPath.check());
+            printf("Parallel cost: %f, multi-start cost: %f, original cost: %f\n", path.cost(obj).value(),
+                   multiStartPath.cost(obj).value(), original_cost.value());
+        }
+    }
+
 protected:
     bool verbose_;
     Circles2D circles_;
@@ -156,6 +178,16 @@ BOOST_AUTO_TEST_CASE(geometric_PathLengthSimplifier)
         printf("Done with path length simplifier\n");
 }
 
+BOOST_AUTO_TEST_CASE(geometric_PathLengthParallelSimplifier)
+{
+    if (VERBOSE)
+        printf("\n\n\n**************************************************\n"
+               "Testing parallel path length simplifier\n");
+    run_parallel_simplifier();
+    if (VERBOSE)
+        printf("Done with parallel path length simplifier\n");
+}
+
 BOOST_AUTO_TEST_CASE(geomtric_PathLengthHybridization)
 {
     if (VERBOSE)
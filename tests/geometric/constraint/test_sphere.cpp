@@ -42,6 +42,7 @@
 #include <ompl/base/Constraint.h>
 #include <ompl/base/ConstrainedSpaceInformation.h>
 #include <ompl/base/spaces/constraint/ConstrainedStateSpace.h>
+#include <ompl/base/spaces/constraint/AtlasChart.h>
 #include <ompl/base/spaces/constraint/AtlasStateSpace.h>
 #include <ompl/base/spaces/constraint/TangentBundleStateSpace.h>
 #include <ompl/base/spaces/constraint/ProjectedStateSpace.h>
@@ -452,3 +453,134 @@ OMPL_PLANNER_TEST(PRM, AT, 95.0, 1.0)
 OMPL_PLANNER_TEST(PRM, TB, 95.0, 1.0)
 
 BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_CASE(constraint_ProjectBatch)
+{
+    auto constraint = std::make_shared<Sphere>();
+
+    Eigen::MatrixXd xs = Eigen::MatrixXd::Random(3, 50);
+    xs.col(0) << 0.5, 0.5, 0.5;
+
+    std::vector<bool> projected;
+    BOOST_CHECK_EQUAL(constraint->projectBatch(xs, &projected), 50u);
+    BOOST_CHECK_EQUAL(projected.size(), 50u);
+    for (Eigen::Index i = 0; i < xs.cols(); ++i)
+    {
+        BOOST_CHECK(projected[i]);
+        BOOST_CHECK(constraint->isSatisfied(xs.col(i)));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(constraint_GeodesicCache)
+{
+    auto space = std::make_shared<ob::RealVectorStateSpace>(3);
+    ob::RealVectorBounds bounds(3);
+    bounds.setLow(-2);
+    bounds.setHigh(2);
+    space->setBounds(bounds);
+
+    auto css = std::make_shared<ob::ProjectedStateSpace>(space, std::make_shared<Sphere>());
+    auto csi = std::make_shared<ob::ConstrainedSpaceInformation>(css);
+    csi->setStateValidityChecker(isValid);
+    csi->setup();
+    BOOST_CHECK_EQUAL(css->getGeodesicCacheSize(), 0u);
+
+    ob::StateSamplerPtr sampler = css->allocStateSampler();
+    ob::State *s1 = css->allocState();
+    ob::State *s2 = css->allocState();
+    ob::State *cached = css->allocState();
+    ob::State *uncached = css->allocState();
+
+    for (unsigned int i = 0; i < 50; ++i)
+    {
+        sampler->sampleUniform(s1);
+        sampler->sampleUniformNear(s2, s1, 0.5);
+        if (!csi->isValid(s1))
+            continue;
+
+        css->setGeodesicCacheSize(0);
+        const bool valid = csi->checkMotion(s1, s2);
+        css->interpolate(s1, s2, 0.5, uncached);
+
+        css->setGeodesicCacheSize(16);
+        for (unsigned int j = 0; j < 2; ++j)
+        {
+            BOOST_CHECK_EQUAL(csi->checkMotion(s1, s2), valid);
+            css->interpolate(s1, s2, 0.5, cached);
+            BOOST_CHECK(css->equalStates(cached, uncached));
+        }
+    }
+
+    // Cached results are not reused once the validity checker is replaced
+    css->setGeodesicCacheSize(16);
+    do
+    {
+        sampler->sampleUniform(s1);
+        sampler->sampleUniformNear(s2, s1, 0.5);
+    } while (!csi->isValid(s1) || !csi->checkMotion(s1, s2) || css->distance(s1, s2) < 0.1);
+    csi->setStateValidityChecker([](const ob::State *) { return false; });
+    BOOST_CHECK(!csi->checkMotion(s1, s2));
+    csi->setStateValidityChecker(isValid);
+    BOOST_CHECK(csi->checkMotion(s1, s2));
+
+    css->freeState(s1);
+    css->freeState(s2);
+    css->freeState(cached);
+    css->freeState(uncached);
+}
+
+BOOST_AUTO_TEST_CASE(constraint_AtlasPolytope)
+{
+    auto space = std::make_shared<ob::RealVectorStateSpace>(3);
+    ob::RealVectorBounds bounds(3);
+    bounds.setLow(-2);
+    bounds.setHigh(2);
+    space->setBounds(bounds);
+
+    auto atlas = std::make_shared<ob::AtlasStateSpace>(space, std::make_shared<Sphere>());
+    auto csi = std::make_shared<ob::ConstrainedSpaceInformation>(atlas);
+    csi->setup();
+
+    // A chart at the north pole, surrounded by neighbors that bound its polytope. The halfspaces are generated
+    // explicitly, so that only the ones to these neighbors are part of it.
+    atlas->setSeparated(false);
+    auto *state = atlas->allocState()->as<ob::AtlasStateSpace::StateType>();
+    *state << 0, 0, 1;
+    ob::AtlasChart *center = atlas->newChart(state);
+    std::vector<ob::AtlasChart *> neighbors;
+    for (unsigned int i = 0; i < 6; ++i)
+    {
+        const double angle = 0.3, heading = i * boost::math::constants::pi<double>() / 3;
+        *state << std::sin(angle) * std::cos(heading), std::sin(angle) * std::sin(heading), std::cos(angle);
+        neighbors.push_back(atlas->newChart(state));
+        ob::AtlasChart::generateHalfspace(center, neighbors.back());
+    }
+    BOOST_REQUIRE_EQUAL(center->getNeighborCount(), 6u);
+
+    // Each neighbor bounds the polytope by the perpendicular bisector between the chart center and the neighbor's
+    // center (scaled by 5%), projected onto the chart; check the halfspaces one at a time against checking all of
+    // them at once
+    std::vector<Eigen::VectorXd> normals;
+    for (ob::AtlasChart *neighbor : neighbors)
+    {
+        Eigen::VectorXd n(2);
+        center->psiInverse(*neighbor->getOrigin(), n);
+        normals.push_back(1.05 * n);
+    }
+
+    ompl::RNG rng;
+    unsigned int inside = 0, outside = 0;
+    Eigen::VectorXd u(2);
+    for (unsigned int i = 0; i < 1000; ++i)
+    {
+        u << rng.uniformReal(-0.4, 0.4), rng.uniformReal(-0.4, 0.4);
+        bool in = u.norm() <= atlas->getRho_s();
+        for (const Eigen::VectorXd &n : normals)
+            in = in && n.dot(u) <= n.squaredNorm() / 2;
+        BOOST_CHECK_EQUAL(in, center->inPolytope(u));
+        ++(in ? inside : outside);
+    }
+    BOOST_CHECK(inside > 0u && outside > 0u);
+
+    atlas->freeState(state);
+}
@@ -0,0 +1,371 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2026, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+
+#define BOOST_TEST_MODULE "Lightning"
+#include <boost/test/unit_test.hpp>
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <vector>
+
+#include "ompl/base/ScopedState.h"
+#include "ompl/base/spaces/RealVectorStateSpace.h"
+#include "ompl/tools/lightning/DynamicTimeWarp.h"
+#include "ompl/tools/lightning/LightningDB.h"
+#include "ompl/util/RandomNumbers.h"
+
+using namespace ompl;
+
+namespace
+{
+    base::StateSpacePtr makeSpace()
+    {
+        auto space(std::make_shared<base::RealVectorStateSpace>(2));
+        space->setBounds(0., 1.);
+        space->setup();
+        return space;
+    }
+
+    /* A straight path from (x0, y0) to (x1, y1) */
+    geometric::PathGeometric makePath(const base::SpaceInformationPtr &si, double x0, double y0, double x1, double y1)
+    {
+        base::ScopedState<base::RealVectorStateSpace> start(si), goal(si);
+        start[0] = x0;
+        start[1] = y0;
+        goal[0] = x1;
+        goal[1] = y1;
+        geometric::PathGeometric path(si, start.get(), goal.get());
+        path.interpolate(11);
+        return path;
+    }
+
+    /* Exposes the number of paths that were read from disk */
+    class LightningDBTest : public tools::LightningDB
+    {
+    public:
+        using LightningDB::LightningDB;
+
+        std::size_t getLoadedCount() const
+        {
+            return nn_->size();
+        }
+    };
+
+    /* A database file in the temporary directory, removed with all its shards at the end of the test */
+    struct DatabaseFile
+    {
+        DatabaseFile()
+          : name((boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()).string())
+        {
+        }
+
+        ~DatabaseFile()
+        {
+            boost::filesystem::remove(name);
+            for (std::size_t index = 1; boost::filesystem::exists(shard(index)); ++index)
+                boost::filesystem::remove(shard(index));
+        }
+
+        std::string shard(std::size_t index) const
+        {
+            return name + ".shard" + std::to_string(index);
+        }
+
+        std::string name;
+    };
+}
+
+BOOST_AUTO_TEST_CASE(DatabaseRoundTrip)
+{
+    base::StateSpacePtr space = makeSpace();
+    auto si(std::make_shared<base::SpaceInformation>(space));
+    DatabaseFile file;
+    double insertionTime;
+
+    // Store a path and read it back; the paths are only read from disk when needed
+    {
+        tools::LightningDB db(space);
+        geometric::PathGeometric path = makePath(si, 0.1, 0.1, 0.9, 0.9);
+        db.addPath(path, insertionTime);
+        BOOST_CHECK_EQUAL(db.getNumUnsavedPaths(), 1);
+        BOOST_CHECK(db.save(file.name));
+        BOOST_CHECK_EQUAL(db.getNumUnsavedPaths(), 0);
+        BOOST_CHECK_EQUAL(db.getShardsCount(), 1u);
+    }
+    {
+        LightningDBTest db(space);
+        BOOST_CHECK(db.load(file.name));
+        BOOST_CHECK_EQUAL(db.getExperiencesCount(), 1u);
+        BOOST_CHECK_EQUAL(db.getLoadedCount(), 0u);
+        BOOST_CHECK_EQUAL(db.getStatesCount(), 11u);
+        BOOST_CHECK_EQUAL(db.getLoadedCount(), 1u);
+    }
+
+    // Appending writes the new paths to a new shard and leaves the first one untouched
+    const auto size = boost::filesystem::file_size(file.name);
+    {
+        tools::LightningDB db(space);
+        BOOST_CHECK(db.load(file.name));
+        geometric::PathGeometric path = makePath(si, 0.9, 0.1, 0.1, 0.9);
+        db.addPath(path, insertionTime);
+        BOOST_CHECK(db.saveIfChanged(file.name));
+        BOOST_CHECK_EQUAL(db.getShardsCount(), 2u);
+        BOOST_CHECK_EQUAL(db.getExperiencesCount(), 2u);
+    }
+    BOOST_CHECK_EQUAL(boost::filesystem::file_size(file.name), size);
+    BOOST_CHECK(boost::filesystem::exists(file.shard(1)));
+
+    {
+        LightningDBTest db(space);
+        BOOST_CHECK(db.load(file.name));
+        BOOST_CHECK_EQUAL(db.getShardsCount(), 2u);
+        BOOST_CHECK_EQUAL(db.getExperiencesCount(), 2u);
+        BOOST_CHECK_EQUAL(db.getLoadedCount(), 0u);
+
+        // The query loads both shards and finds the appended path
+        base::ScopedState<base::RealVectorStateSpace> start(si), goal(si);
+        start[0] = 0.85;
+        start[1] = 0.15;
+        goal[0] = 0.15;
+        goal[1] = 0.85;
+        std::vector<base::PlannerDataPtr> nearest = db.findNearestStartGoal(1, start.get(), goal.get());
+        BOOST_CHECK_EQUAL(db.getLoadedCount(), 2u);
+        BOOST_REQUIRE_EQUAL(nearest.size(), 1u);
+        const auto *first = nearest[0]->getVertex(0).getState()->as<base::RealVectorStateSpace::StateType>();
+        BOOST_CHECK_CLOSE(first->values[0], 0.9, 1e-6);
+        BOOST_CHECK_CLOSE(first->values[1], 0.1, 1e-6);
+
+        // Saving merges the shards into a single file again
+        BOOST_CHECK(db.save(file.name));
+        BOOST_CHECK_EQUAL(db.getShardsCount(), 1u);
+        BOOST_CHECK(!boost::filesystem::exists(file.shard(1)));
+    }
+    {
+        tools::LightningDB db(space);
+        BOOST_CHECK(db.load(file.name));
+        BOOST_CHECK_EQUAL(db.getExperiencesCount(), 2u);
+        BOOST_CHECK_EQUAL(db.getStatesCount(), 22u);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(DatabaseLoad)
+{
+    base::StateSpacePtr space = makeSpace();
+    auto si(std::make_shared<base::SpaceInformation>(space));
+    DatabaseFile file, other;
+    double insertionTime;
+
+    {
+        tools::LightningDB db(space);
+        geometric::PathGeometric path = makePath(si, 0.1, 0.1, 0.9, 0.9);
+        db.addPath(path, insertionTime);
+        BOOST_CHECK(db.save(file.name));
+    }
+    {
+        tools::LightningDB db(space);
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+            geometric::PathGeometric path = makePath(si, 0.1, 0.2 * i, 0.9, 0.2 * i);
+            db.addPath(path, insertionTime);
+        }
+        BOOST_CHECK(db.save(other.name));
+    }
+
+    tools::LightningDB db(space);
+    BOOST_CHECK(db.load(file.name));
+    BOOST_CHECK_EQUAL(db.getExperiencesCount(), 1u);
+
+    // Loading another database replaces the loaded paths, but keeps the ones that were not saved yet
+    geometric::PathGeometric path = makePath(si, 0.5, 0.1, 0.5, 0.9);
+    db.addPath(path, insertionTime);
+    BOOST_CHECK(db.load(other.name));
+    BOOST_CHECK_EQUAL(db.getShardsCount(), 1u);
+    BOOST_CHECK_EQUAL(db.getExperiencesCount(), 4u);
+    BOOST_CHECK_EQUAL(db.getNumUnsavedPaths(), 1);
+
+    // A failed load leaves the database unchanged
+    BOOST_CHECK(!db.load(file.name + ".missing"));
+    {
+        std::ofstream corrupt(other.shard(1).c_str());
+        corrupt << "corrupt";
+    }
+    BOOST_CHECK(!db.load(other.name));
+    BOOST_CHECK_EQUAL(db.getShardsCount(), 1u);
+    BOOST_CHECK_EQUAL(db.getExperiencesCount(), 4u);
+    BOOST_CHECK_EQUAL(db.getNumUnsavedPaths(), 1);
+    BOOST_CHECK_EQUAL(db.getStatesCount(), 44u);
+
+    // The unsaved path is appended to the database it was loaded with
+    boost::filesystem::remove(other.shard(1));
+    BOOST_CHECK(db.saveIfChanged(other.name));
+    BOOST_CHECK_EQUAL(db.getShardsCount(), 2u);
+    BOOST_CHECK_EQUAL(db.getNumUnsavedPaths(), 0);
+
+    // Unreadable paths are reported when they are first used, and keep the database from being overwritten
+    {
+        std::ofstream corrupt(other.shard(2).c_str());
+        corrupt << "2 corrupt";
+    }
+    std::uintmax_t size = boost::filesystem::file_size(other.name);
+    BOOST_CHECK(db.load(other.name));
+    BOOST_CHECK_EQUAL(db.getShardsCount(), 3u);
+    std::vector<base::PlannerDataPtr> plannerDatas;
+    BOOST_CHECK(!db.getAllPlannerDatas(plannerDatas));
+    BOOST_CHECK_EQUAL(plannerDatas.size(), 4u);
+    BOOST_CHECK(!db.save(other.name));
+    BOOST_CHECK_EQUAL(boost::filesystem::file_size(other.name), size);
+    BOOST_CHECK(boost::filesystem::exists(other.shard(2)));
+
+    // A successful save replaces the file and removes the shards
+    BOOST_CHECK(db.load(file.name));
+    BOOST_CHECK(db.save(other.name));
+    BOOST_CHECK(!boost::filesystem::exists(other.name + ".tmp"));
+    BOOST_CHECK(!boost::filesystem::exists(other.shard(1)));
+    BOOST_CHECK(db.load(other.name));
+    BOOST_CHECK_EQUAL(db.getExperiencesCount(), 1u);
+}
+
+namespace
+{
+    /* A path through \e count random states */
+    geometric::PathGeometric makeRandomPath(const base::SpaceInformationPtr &si, unsigned int count)
+    {
+        geometric::PathGeometric path(si);
+        base::ScopedState<> state(si);
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            state.random();
+            path.append(state.get());
+        }
+        return path;
+    }
+
+    /* DTW distance computed over the full table, restricted to cells within \e band of the diagonal if it is not 0 */
+    double referenceDTW(const base::SpaceInformationPtr &si, const geometric::PathGeometric &path1,
+                        const geometric::PathGeometric &path2, std::size_t band = 0)
+    {
+        const double inf = std::numeric_limits<double>::infinity();
+        std::size_t n = path1.getStateCount(), m = path2.getStateCount();
+        std::size_t width = band == 0 ? std::max(n, m) : std::max(band, n > m ? n - m : m - n);
+        std::vector<std::vector<double>> table(n + 1, std::vector<double>(m + 1, inf));
+        table[0][0] = 0.;
+        for (std::size_t i = 1; i <= n; ++i)
+            for (std::size_t j = 1; j <= m; ++j)
+                if ((i > j ? i - j : j - i) <= width)
+                    table[i][j] = si->distance(path1.getState(i - 1), path2.getState(j - 1)) +
+                                  std::min({table[i - 1][j], table[i][j - 1], table[i - 1][j - 1]});
+        return table[n][m];
+    }
+}
+
+BOOST_AUTO_TEST_CASE(DTWDistance)
+{
+    auto si(std::make_shared<base::SpaceInformation>(makeSpace()));
+    tools::DynamicTimeWarp dtw(si);
+    RNG rng;
+
+    for (unsigned int k = 0; k < 50; ++k)
+    {
+        geometric::PathGeometric path1 = makeRandomPath(si, rng.uniformInt(1, 30));
+        geometric::PathGeometric path2 = makeRandomPath(si, rng.uniformInt(1, 30));
+        const double full = referenceDTW(si, path1, path2);
+
+        dtw.setBandWidth(0);
+        BOOST_CHECK_CLOSE(dtw.calcDTWDistance(path1, path2), full, 1e-9);
+        BOOST_CHECK(dtw.calcDTWLowerBound(path1, path2) <= full + 1e-12);
+
+        // Early abandoning gives the exact distance whenever it is within the bound
+        BOOST_CHECK_CLOSE(dtw.calcDTWDistance(path1, path2, full * 1.01), full, 1e-9);
+        BOOST_CHECK(dtw.calcDTWDistance(path1, path2, full * 0.99) > full * 0.99);
+
+        // The band restricts the warping path, so the distance can only grow; a band as wide as the longer path
+        // gives the full distance
+        dtw.setBandWidth(3);
+        const double banded = dtw.calcDTWDistance(path1, path2);
+        BOOST_CHECK_CLOSE(banded, referenceDTW(si, path1, path2, 3), 1e-9);
+        BOOST_CHECK(banded >= full - 1e-12);
+        dtw.setBandWidth(std::max(path1.getStateCount(), path2.getStateCount()));
+        BOOST_CHECK_CLOSE(dtw.calcDTWDistance(path1, path2), full, 1e-9);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(DTWNearestPath)
+{
+    auto si(std::make_shared<base::SpaceInformation>(makeSpace()));
+    tools::DynamicTimeWarp dtw(si);
+    RNG rng;
+
+    double distance;
+    BOOST_CHECK_EQUAL(dtw.findNearestPath(makeRandomPath(si, 5), {}, distance), 0u);
+
+    for (unsigned int k = 0; k < 20; ++k)
+    {
+        geometric::PathGeometric path = makeRandomPath(si, rng.uniformInt(2, 20));
+        std::vector<geometric::PathGeometric> candidates;
+        for (unsigned int i = 0; i < 15; ++i)
+            candidates.push_back(makeRandomPath(si, rng.uniformInt(2, 20)));
+
+        std::size_t best = candidates.size(), bestScoring = candidates.size();
+        double bestDistance = std::numeric_limits<double>::infinity();
+        double bestScore = std::numeric_limits<double>::infinity();
+        for (std::size_t i = 0; i < candidates.size(); ++i)
+        {
+            double d = referenceDTW(si, path, candidates[i]);
+            if (d < bestDistance)
+            {
+                bestDistance = d;
+                best = i;
+            }
+            // the score of getPathsScore(), without interpolation
+            double score = d / std::max(path.getStateCount(), candidates[i].getStateCount());
+            if (score < bestScore)
+            {
+                bestScore = score;
+                bestScoring = i;
+            }
+        }
+
+        for (unsigned int numThreads : {1u, 3u})
+        {
+            BOOST_CHECK_EQUAL(dtw.findNearestPath(path, candidates, distance, numThreads), best);
+            BOOST_CHECK_CLOSE(distance, bestDistance, 1e-9);
+            double score;
+            BOOST_CHECK_EQUAL(dtw.findBestScoringPath(path, candidates, score, numThreads), bestScoring);
+            BOOST_CHECK_CLOSE(score, bestScore, 1e-9);
+        }
+    }
+}
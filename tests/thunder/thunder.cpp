@@ -0,0 +1,179 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2026, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+
+#define BOOST_TEST_MODULE "Thunder"
+#include <boost/test/unit_test.hpp>
+#include <boost/filesystem.hpp>
+
+#include "ompl/base/ScopedState.h"
+#include "ompl/base/spaces/RealVectorStateSpace.h"
+#include "ompl/tools/thunder/SPARSdb.h"
+#include "ompl/tools/thunder/ThunderDB.h"
+
+using namespace ompl;
+
+namespace
+{
+    base::SpaceInformationPtr makeSpaceInformation()
+    {
+        auto space(std::make_shared<base::RealVectorStateSpace>(2));
+        space->setBounds(0., 1.);
+        auto si(std::make_shared<base::SpaceInformation>(space));
+        si->setup();
+        return si;
+    }
+
+    tools::SPARSdbPtr makeSPARSdb(const base::SpaceInformationPtr &si)
+    {
+        auto spars(std::make_shared<geometric::SPARSdb>(si));
+        spars->setProblemDefinition(std::make_shared<base::ProblemDefinition>(si));
+        spars->setup();
+        return spars;
+    }
+
+    /* A straight path from (x0, y0) to (x1, y1) */
+    geometric::PathGeometric makePath(const base::SpaceInformationPtr &si, double x0, double y0, double x1, double y1)
+    {
+        base::ScopedState<base::RealVectorStateSpace> start(si), goal(si);
+        start[0] = x0;
+        start[1] = y0;
+        goal[0] = x1;
+        goal[1] = y1;
+        return geometric::PathGeometric(si, start.get(), goal.get());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(AddPathAsync)
+{
+    base::SpaceInformationPtr si = makeSpaceInformation();
+    const std::string fileName =
+        (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()).string();
+    double insertionTime;
+
+    unsigned int numVertices;
+    {
+        tools::ThunderDB db(si->getStateSpace());
+        tools::SPARSdbPtr spars = makeSPARSdb(si);
+        db.setSPARSdb(spars);
+
+        // Paths are added in the background; saving waits until they are part of the roadmap
+        geometric::PathGeometric path = makePath(si, 0.1, 0.1, 0.9, 0.9);
+        BOOST_CHECK(db.addPath(path, insertionTime));
+        path = makePath(si, 0.9, 0.1, 0.1, 0.9);
+        BOOST_CHECK(db.addPath(path, insertionTime));
+        BOOST_CHECK(db.save(fileName));
+        BOOST_CHECK_EQUAL(spars->getNumPendingPaths(), 0u);
+        numVertices = spars->getNumVertices();
+        BOOST_CHECK(numVertices > 1u);
+        BOOST_CHECK(spars->getNumEdges() > 0u);
+    }
+    {
+        tools::ThunderDB db(si->getStateSpace());
+        tools::SPARSdbPtr spars = makeSPARSdb(si);
+        db.setSPARSdb(spars);
+        BOOST_CHECK(db.load(fileName));
+        BOOST_CHECK_EQUAL(spars->getNumVertices(), numVertices);
+    }
+    boost::filesystem::remove(fileName);
+}
+
+BOOST_AUTO_TEST_CASE(ClearWithPendingPaths)
+{
+    base::SpaceInformationPtr si = makeSpaceInformation();
+    tools::ThunderDB db(si->getStateSpace());
+    tools::SPARSdbPtr spars = makeSPARSdb(si);
+    db.setSPARSdb(spars);
+    double insertionTime;
+
+    // Clearing the roadmap discards the paths that were not added yet, and leaves it empty
+    for (unsigned int i = 0; i < 10; ++i)
+    {
+        geometric::PathGeometric path = makePath(si, 0.1, 0.05 + 0.1 * i, 0.9, 0.95 - 0.1 * i);
+        BOOST_CHECK(db.addPath(path, insertionTime));
+    }
+    spars->clear();
+    BOOST_CHECK_EQUAL(spars->getNumPendingPaths(), 0u);
+    BOOST_CHECK_EQUAL(spars->getNumVertices(), 0u);
+
+    // Paths queued after the roadmap was cleared are added again
+    spars->setup();
+    geometric::PathGeometric path = makePath(si, 0.1, 0.1, 0.9, 0.9);
+    BOOST_CHECK(db.addPath(path, insertionTime));
+    spars->waitForPendingPaths();
+    BOOST_CHECK_EQUAL(spars->getNumPendingPaths(), 0u);
+    BOOST_CHECK(spars->getNumVertices() > 1u);
+}
+
+BOOST_AUTO_TEST_CASE(QueryDuringInsertion)
+{
+    base::SpaceInformationPtr si = makeSpaceInformation();
+    tools::ThunderDB db(si->getStateSpace());
+    tools::SPARSdbPtr spars = makeSPARSdb(si);
+    db.setSPARSdb(spars);
+    double insertionTime;
+
+    // A path that is too short is rejected right away
+    geometric::PathGeometric single(si);
+    single.append(makePath(si, 0.1, 0.1, 0.9, 0.9).getState(0));
+    BOOST_CHECK(!db.addPath(single, insertionTime));
+
+    base::ScopedState<base::RealVectorStateSpace> start(si), goal(si);
+    start[0] = 0.1;
+    start[1] = 0.05;
+    goal[0] = 0.9;
+    goal[1] = 0.95;
+    spars->getProblemDefinition()->setStartAndGoalStates(start, goal);
+
+    for (unsigned int i = 0; i < 10; ++i)
+    {
+        geometric::PathGeometric path = makePath(si, 0.1, 0.05 + 0.1 * i, 0.9, 0.95 - 0.1 * i);
+        BOOST_CHECK(db.addPath(path, insertionTime));
+    }
+
+    // The roadmap can be inspected and queried while the paths are inserted
+    while (spars->getNumPendingPaths() > 0u)
+    {
+        BOOST_CHECK(spars->getNumEdges() < spars->getNumVertices() * spars->getNumVertices() + 1u);
+        spars->getNumConnectedComponents();
+        geometric::SPARSdb::CandidateSolution candidate;
+        db.findNearestStartGoal(1, start.get(), goal.get(), candidate,
+                                base::timedPlannerTerminationCondition(0.1));
+    }
+
+    geometric::SPARSdb::CandidateSolution candidate;
+    BOOST_CHECK(db.findNearestStartGoal(1, start.get(), goal.get(), candidate,
+                                        base::timedPlannerTerminationCondition(1.0)));
+    BOOST_CHECK(candidate.path_ != nullptr);
+}
@@ -214,6 +214,40 @@ BOOST_AUTO_TEST_CASE(NormalReals)
     BOOST_OMPL_EXPECT_NEAR(avgNormalReals(10.0, 1.0), 10.0, errNormal(1.0));
 }
 
+BOOST_AUTO_TEST_CASE(BulkReals)
+{
+    std::vector<double> values(static_cast<std::size_t>(NUM_REAL_SAMPLES) + 1);
+
+    // Odd counts and bounds are respected, and the average is as expected
+    RNG r(42u);
+    r.uniformReal(values.data(), values.size(), -2.0, 4.0);
+    double sum = 0.0;
+    for (double v : values)
+    {
+        BOOST_CHECK(v >= -2.0 && v < 4.0);
+        sum += v;
+    }
+    BOOST_OMPL_EXPECT_NEAR(sum / values.size(), 1.0, errUniformReal(-2, 4));
+
+    r.gaussian01(values.data(), values.size());
+    sum = 0.0;
+    for (double v : values)
+        sum += v;
+    BOOST_OMPL_EXPECT_NEAR(sum / values.size(), 0.0, errNormal(1.0));
+
+    // The bulk stream only depends on the local seed
+    std::vector<double> first(101), second(101);
+    RNG a(7u), b(7u);
+    a.uniform01(first.data(), first.size());
+    b.uniform01(second.data(), second.size());
+    BOOST_CHECK(first == second);
+    a.uniform01(first.data(), first.size());
+    BOOST_CHECK(first != second);
+    a.setLocalSeed(7u);
+    a.uniform01(first.data(), first.size());
+    BOOST_CHECK(first == second);
+}
+
 BOOST_AUTO_TEST_CASE(SampleUnitSphere)
 {
     // Variables
@@ -409,3 +443,56 @@ BOOST_AUTO_TEST_CASE(SampleInPhs)
         }
     }
 }
+
+BOOST_AUTO_TEST_CASE(TransformPhsBatch)
+{
+    // Variables
+    // The random number generator
+    RNG rng;
+    // The number of samples to transform at once
+    unsigned int numSamples = 100u;
+
+    // Iterate over a sequence of dimensions
+    for (unsigned int dim = 1u; dim <= 10u; ++dim)
+    {
+        // Variables
+        // The foci
+        std::vector<double> v1(dim);
+        std::vector<double> v2(dim);
+        // The unit-ball samples and their batch transformations, stored consecutively
+        std::vector<double> spheres(dim * numSamples);
+        std::vector<double> batch(dim * numSamples);
+
+        // Pick random foci
+        for (unsigned int i = 0u; i < dim; ++i)
+        {
+            v1.at(i) = rng.uniformReal(-25.0, 25.0);
+            v2.at(i) = rng.uniformReal(-25.0, 25.0);
+        }
+
+        // Create the PHS object
+        auto phsPtr = std::make_shared<ompl::ProlateHyperspheroid>(dim, &v1[0], &v2[0]);
+        phsPtr->setTransverseDiameter(1.5 * phsPtr->getMinTransverseDiameter());
+
+        // Sample the unit ball and transform all the samples at once
+        for (unsigned int j = 0u; j < numSamples; ++j)
+        {
+            std::vector<double> ball(dim);
+            rng.uniformInBall(1.0, ball);
+            std::copy(ball.begin(), ball.end(), spheres.begin() + j * dim);
+        }
+        phsPtr->transformBatch(&spheres[0], &batch[0], numSamples);
+
+        // Check each against the single-point transformation
+        for (unsigned int j = 0u; j < numSamples; ++j)
+        {
+            std::vector<double> single(dim);
+            phsPtr->transform(&spheres[j * dim], &single[0]);
+            for (unsigned int i = 0u; i < dim; ++i)
+            {
+                BOOST_CHECK_SMALL(single[i] - batch[j * dim + i], 1e-9);
+            }
+            BOOST_CHECK(phsPtr->isInPhs(&batch[j * dim]));
+        }
+    }
+}